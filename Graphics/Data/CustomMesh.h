@@ -23,6 +23,15 @@ namespace leap::graphics
 
 			m_PrevSize = vertexSize;
 		}
+		/// <summary>
+		/// Makes sure the mesh can hold the given amount of extra vertices & indices without reallocating
+		/// </summary>
+		template<typename T>
+		void Reserve(size_t nrOfVertices, size_t nrOfIndices)
+		{
+			m_Vertices.reserve(m_Vertices.size() + nrOfVertices * sizeof(T));
+			m_Indices.reserve(m_Indices.size() + nrOfIndices);
+		}
 		void AddIndex(unsigned int index)
 		{
 			m_Indices.emplace_back(index);
@@ -16,6 +16,7 @@
 #include <d3d11.h>
 #include <d3dcompiler.h>
 #include <d3dx11effect.h>
+#include <objbase.h>
 
 #include "DirectXShaderReader.h"
 #include "DirectXTexture.h"
@@ -136,16 +137,19 @@ leap::graphics::IMaterial* leap::graphics::DirectXEngine::CloneMaterial(const st
 
 leap::graphics::ITexture* leap::graphics::DirectXEngine::CreateTexture(const std::string& path)
 {
-	if (auto it{ m_pTextures.find(path) }; it != end(m_pTextures))
 	{
-		return it->second.get();
+		const std::lock_guard lock{ m_TexturesMutex };
+		if (auto it{ m_pTextures.find(path) }; it != end(m_pTextures))
+		{
+			return it->second.get();
+		}
 	}
 
+	// The texture is decoded outside the lock, a texture that got preloaded in the meantime is kept instead
 	auto pTexture{ std::make_unique<DirectXTexture>(m_pDevice, m_pDeviceContext, path) };
-	auto pTextureRaw{ pTexture.get() };
 
-	m_pTextures[path] = std::move(pTexture);
-	return pTextureRaw;
+	const std::lock_guard lock{ m_TexturesMutex };
+	return m_pTextures.emplace(path, std::move(pTexture)).first->second.get();
 }
 
 leap::graphics::ITexture* leap::graphics::DirectXEngine::CreateTexture(int width, int height)
@@ -158,8 +162,32 @@ leap::graphics::ITexture* leap::graphics::DirectXEngine::CreateTexture(int width
 	return pTextureRaw;
 }
 
+void leap::graphics::DirectXEngine::PreloadMesh(const std::string& filePath)
+{
+	// Creating buffers only needs the device, which is thread safe
+	DirectXMeshLoader::GetInstance().PreloadMesh(filePath, m_pDevice);
+}
+
+void leap::graphics::DirectXEngine::PreloadTexture(const std::string& path)
+{
+	{
+		const std::lock_guard lock{ m_TexturesMutex };
+		if (m_pTextures.contains(path)) return;
+	}
+
+	// WIC needs COM to be initialized on the loading thread
+	const HRESULT comResult{ CoInitializeEx(nullptr, COINIT_MULTITHREADED) };
+	auto pTexture{ std::make_unique<DirectXTexture>(m_pDevice, m_pDeviceContext, path) };
+	if (SUCCEEDED(comResult)) CoUninitialize();
+
+	const std::lock_guard lock{ m_TexturesMutex };
+	m_pTextures.emplace(path, std::move(pTexture));
+}
+
 void leap::graphics::DirectXEngine::DrawLines(const std::vector<std::pair<glm::vec3, glm::vec3>>& lines)
 {
+	m_DebugDrawings.Reserve<glm::vec3>(lines.size() * 2, lines.size() * 2);
+
 	unsigned int index{ static_cast<unsigned int>(m_DebugDrawings.GetIndexBuffer().size()) };
 	for (const auto& line : lines)
 	{
@@ -326,9 +354,12 @@ void leap::graphics::DirectXEngine::ReloadDirectXEngine()
 	m_ShadowRenderer.Create(m_pDevice, m_pDeviceContext, m_ShadowRenderer.GetShadowMapSize());
 
 	// Reload existing textures, materials & meshes using new video settings
-	for (const auto& texturePair : m_pTextures)
 	{
-		texturePair.second->Reload(m_pDevice, m_pDeviceContext, texturePair.first);
+		const std::lock_guard lock{ m_TexturesMutex };
+		for (const auto& texturePair : m_pTextures)
+		{
+			texturePair.second->Reload(m_pDevice, m_pDeviceContext, texturePair.first);
+		}
 	}
 	for (const auto& pTexture : m_pUniqueTextures)
 	{
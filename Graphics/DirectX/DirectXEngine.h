@@ -22,6 +22,7 @@ struct ID3D11RenderTargetView;
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "../Data/CustomMesh.h"
@@ -73,6 +74,10 @@ namespace leap::graphics
 		virtual ITexture* CreateTexture(const std::string& path) override;
 		virtual ITexture* CreateTexture(int width, int height) override;
 
+		// Asset preloading
+		virtual void PreloadMesh(const std::string& filePath) override;
+		virtual void PreloadTexture(const std::string& path) override;
+
 		// Debug rendering
 		virtual void DrawLines(const std::vector<std::pair<glm::vec3, glm::vec3>>& triangles) override;
 		virtual void DrawLine(const glm::vec3& start, const glm::vec3& end) override;
@@ -95,6 +100,8 @@ namespace leap::graphics
 
 		std::vector<std::unique_ptr<DirectXMeshRenderer>> m_pRenderers{};
 		std::unordered_map<std::string, std::unique_ptr<DirectXMaterial>> m_pMaterials{};
+		// Textures can be preloaded from a loading thread
+		std::mutex m_TexturesMutex{};
 		std::unordered_map<std::string, std::unique_ptr<DirectXTexture>> m_pTextures{};
 		std::vector<std::unique_ptr<DirectXTexture>> m_pUniqueTextures{};
 
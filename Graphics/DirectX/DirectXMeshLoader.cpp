@@ -7,16 +7,40 @@
 
 const leap::graphics::DirectXMeshLoader::DirectXMeshDefinition& leap::graphics::DirectXMeshLoader::LoadMesh(const std::string& dataPath, ID3D11Device* pDevice)
 {
-	if (auto it{ m_Meshes.find(dataPath) }; it != end(m_Meshes))
 	{
-		return it->second;
+		const std::lock_guard lock{ m_MeshesMutex };
+		if (auto it{ m_Meshes.find(dataPath) }; it != end(m_Meshes))
+		{
+			return it->second;
+		}
 	}
 
-	DirectXMeshDefinition mesh{ CreateMesh(dataPath, pDevice) };
+	return AddMesh(dataPath, CreateMesh(dataPath, pDevice));
+}
+
+void leap::graphics::DirectXMeshLoader::PreloadMesh(const std::string& dataPath, ID3D11Device* pDevice)
+{
+	{
+		const std::lock_guard lock{ m_MeshesMutex };
+		if (m_Meshes.contains(dataPath)) return;
+	}
+
+	AddMesh(dataPath, CreateMesh(dataPath, pDevice));
+}
 
-	m_Meshes[dataPath] = mesh;
+const leap::graphics::DirectXMeshLoader::DirectXMeshDefinition& leap::graphics::DirectXMeshLoader::AddMesh(const std::string& dataPath, const DirectXMeshDefinition& mesh)
+{
+	const std::lock_guard lock{ m_MeshesMutex };
+
+	// The mesh is parsed outside the lock, if another thread loaded the same mesh in the meantime that one is kept
+	const auto [it, isInserted]{ m_Meshes.emplace(dataPath, mesh) };
+	if (!isInserted)
+	{
+		if (mesh.vertexBuffer) mesh.vertexBuffer->Release();
+		if (mesh.indexBuffer) mesh.indexBuffer->Release();
+	}
 
-	return m_Meshes[dataPath];
+	return it->second;
 }
 
 const leap::graphics::DirectXMeshLoader::DirectXMeshDefinition& leap::graphics::DirectXMeshLoader::LoadMesh(const CustomMesh& mesh, ID3D11Device* pDevice)
@@ -38,6 +62,7 @@ void leap::graphics::DirectXMeshLoader::RemoveCustomMesh(ID3D11Buffer* pVertexBu
 
 void leap::graphics::DirectXMeshLoader::Reload(ID3D11Device* pDevice)
 {
+	const std::lock_guard lock{ m_MeshesMutex };
 	for (auto& mesh : m_Meshes)
 	{
 		if (mesh.second.vertexBuffer) mesh.second.vertexBuffer->Release();
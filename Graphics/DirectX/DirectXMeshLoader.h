@@ -4,6 +4,7 @@
 
 #include "../Data/Vertex.h"
 
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -29,6 +30,11 @@ namespace leap::graphics
 		const DirectXMeshDefinition& LoadMesh(const std::string& dataPath, ID3D11Device* pDevice);
 		const DirectXMeshDefinition& LoadMesh(const CustomMesh& mesh, ID3D11Device* pDevice);
 
+		/// <summary>
+		/// Loads a mesh from file without returning it, this can be called from a loading thread
+		/// </summary>
+		void PreloadMesh(const std::string& dataPath, ID3D11Device* pDevice);
+
 		void RemoveCustomMesh(ID3D11Buffer* pVertexBuffer);
 
 		void Reload(ID3D11Device* pDevice);
@@ -40,7 +46,10 @@ namespace leap::graphics
 		DirectXMeshDefinition CreateMesh(const std::string& dataPath, ID3D11Device* pDevice) const;
 		DirectXMeshDefinition CreateMesh(const std::vector<Vertex> vertices, const std::vector<unsigned int> indices, ID3D11Device* pDevice) const;
 		DirectXMeshDefinition CreateMesh(const std::vector<unsigned char>& vertexData, unsigned int vertexSize, const std::vector<unsigned int>& indices, ID3D11Device* pDevice) const;
+		const DirectXMeshDefinition& AddMesh(const std::string& dataPath, const DirectXMeshDefinition& mesh);
 
+		// The meshes from file can be preloaded from a loading thread
+		std::mutex m_MeshesMutex{};
 		std::unordered_map<std::string, DirectXMeshDefinition> m_Meshes{};
 		std::vector<DirectXMeshDefinition> m_CustomMeshes{};
 
@@ -56,6 +56,11 @@ namespace leap::graphics
 		virtual ITexture* CreateTexture(const std::string& path) = 0;
 		virtual ITexture* CreateTexture(int width, int height) = 0;
 
+		// Asset preloading, these can be called from a loading thread
+		// The asset is decoded and uploaded, so loading it again with the same path doesn't block
+		virtual void PreloadMesh(const std::string& filePath) = 0;
+		virtual void PreloadTexture(const std::string& path) = 0;
+
 		// Debug rendering
 		virtual void DrawLines(const std::vector<std::pair<glm::vec3, glm::vec3>>& lines) = 0;
 		virtual void DrawLine(const glm::vec3& start, const glm::vec3& end) = 0;
@@ -95,6 +100,10 @@ namespace leap::graphics
 		virtual ITexture* CreateTexture(const std::string&) override { return nullptr; }
 		virtual ITexture* CreateTexture(int, int) override { return nullptr; }
 
+		// Asset preloading
+		virtual void PreloadMesh(const std::string&) override {}
+		virtual void PreloadTexture(const std::string&) override {}
+
 		// Debug rendering
 		virtual void DrawLines(const std::vector<std::pair<glm::vec3, glm::vec3>>&) override {}
 		virtual void DrawLine(const glm::vec3&, const glm::vec3&) override {}
@@ -0,0 +1,195 @@
+#include "../Memory/MemoryTracker.h"
+
+#include <Benchmark.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+// Compares the size-class Mallocator behind operator new with the list-based allocator it replaced and with plain malloc
+// Every benchmark runs the same 1M mixed-size alloc/free pairs on a working set of live allocations,
+//		so the list-based allocator pays for its linear search the same way it did in a populated scene
+
+namespace
+{
+	constexpr uint32_t g_NrOfOperations{ 1'000'000 };
+	constexpr uint32_t g_NrOfLiveAllocations{ 4096 };
+	constexpr int g_NrOfRuns{ 3 };
+
+	struct Operation final
+	{
+		uint32_t slotIdx;
+		int32_t nrOfBytes;
+	};
+
+	// Mostly small objects, some medium buffers and a few allocations that take the large allocation path
+	std::vector<Operation> CreateOperations()
+	{
+		std::mt19937 random{ 1337 };
+		std::uniform_int_distribution<uint32_t> slotDistribution{ 0, g_NrOfLiveAllocations - 1 };
+		std::uniform_int_distribution<int32_t> kindDistribution{ 0, 99 };
+		std::uniform_int_distribution<int32_t> smallDistribution{ 1, 256 };
+		std::uniform_int_distribution<int32_t> mediumDistribution{ 257, 4096 };
+		std::uniform_int_distribution<int32_t> largeDistribution{ 4097, 16384 };
+
+		std::vector<Operation> operations(g_NrOfOperations);
+		for (Operation& operation : operations)
+		{
+			const int32_t kind{ kindDistribution(random) };
+
+			operation.slotIdx = slotDistribution(random);
+			if (kind < 80) operation.nrOfBytes = smallDistribution(random);
+			else if (kind < 98) operation.nrOfBytes = mediumDistribution(random);
+			else operation.nrOfBytes = largeDistribution(random);
+		}
+
+		return operations;
+	}
+
+	// The allocator Mallocator replaced: every allocation gets a separately allocated list node and freeing walks the list
+	class ListAllocator final
+	{
+	public:
+		ListAllocator() = default;
+		~ListAllocator()
+		{
+			while (m_pFirst)
+			{
+				Node* pNode{ m_pFirst };
+				m_pFirst = pNode->pNext;
+
+				free(pNode->pBlock);
+				free(pNode);
+			}
+		}
+
+		ListAllocator(const ListAllocator& other) = delete;
+		ListAllocator(ListAllocator&& other) = delete;
+		ListAllocator& operator=(const ListAllocator& other) = delete;
+		ListAllocator& operator=(ListAllocator&& other) = delete;
+
+		void* Allocate(int32_t nrOfBytes)
+		{
+			Block* pBlock{ static_cast<Block*>(malloc(sizeof(Block) + nrOfBytes)) };
+			pBlock->tag = 0xBEEF;
+			pBlock->size = nrOfBytes;
+
+			Node* pNode{ static_cast<Node*>(malloc(sizeof(Node))) };
+			pNode->pBlock = pBlock;
+			pNode->pNext = nullptr;
+
+			if (m_pLast) m_pLast->pNext = pNode;
+			else m_pFirst = pNode;
+			m_pLast = pNode;
+
+			return pBlock + 1;
+		}
+
+		void Deallocate(void* pMemory)
+		{
+			Block* pBlock{ static_cast<Block*>(pMemory) - 1 };
+			if (pBlock->tag != 0xBEEF) return;
+
+			Node* pPrevious{};
+			for (Node* pNode{ m_pFirst }; pNode; pPrevious = pNode, pNode = pNode->pNext)
+			{
+				if (pNode->pBlock != pBlock) continue;
+
+				if (pPrevious) pPrevious->pNext = pNode->pNext;
+				else m_pFirst = pNode->pNext;
+				if (m_pLast == pNode) m_pLast = pPrevious;
+
+				free(pBlock);
+				free(pNode);
+				return;
+			}
+		}
+
+	private:
+		struct Block final
+		{
+			uint16_t tag;
+			int32_t size;
+			void* pPadding;
+		};
+
+		struct Node final
+		{
+			Block* pBlock;
+			Node* pNext;
+		};
+
+		Node* m_pFirst{};
+		Node* m_pLast{};
+	};
+
+	template <class AllocateFunction, class DeallocateFunction>
+	void RunOperations(const std::vector<Operation>& operations, const AllocateFunction& allocate, const DeallocateFunction& deallocate)
+	{
+		std::vector<void*> pLiveAllocations(g_NrOfLiveAllocations);
+
+		for (const Operation& operation : operations)
+		{
+			void*& pAllocation{ pLiveAllocations[operation.slotIdx] };
+			if (pAllocation) deallocate(pAllocation);
+
+			pAllocation = allocate(operation.nrOfBytes);
+
+			// Touch the memory like the constructor of an object would
+			*static_cast<volatile char*>(pAllocation) = 1;
+		}
+
+		for (void* pAllocation : pLiveAllocations)
+		{
+			if (pAllocation) deallocate(pAllocation);
+		}
+	}
+}
+
+int main()
+{
+	const std::vector<Operation> operations{ CreateOperations() };
+
+	// The replaced operator new of the engine tracks every allocation, without it this benchmark would measure the default allocator
+	const uint64_t trackedMemory{ leap::MemoryTracker::GetTotalAllocatedMemory() };
+	void* pProbe{ ::operator new(64) };
+	const bool isMallocatorUsed{ leap::MemoryTracker::GetTotalAllocatedMemory() > trackedMemory };
+	::operator delete(pProbe);
+
+	if (!isMallocatorUsed)
+	{
+		std::printf("operator new is not routed through the Mallocator, link the LeapEngine library\n");
+		return 1;
+	}
+
+	std::printf("%u mixed-size alloc/free pairs, %u live allocations\n", g_NrOfOperations, g_NrOfLiveAllocations);
+	leap::Benchmark::PrintHeader("Allocators");
+
+	const double mallocatorMs{ leap::Benchmark::Measure("Mallocator (operator new)", g_NrOfRuns, [&operations]()
+		{
+			RunOperations(operations, [](int32_t nrOfBytes) { return ::operator new(static_cast<size_t>(nrOfBytes)); }, [](void* pMemory) { ::operator delete(pMemory); });
+		}) };
+
+	const double mallocMs{ leap::Benchmark::Measure("malloc", g_NrOfRuns, [&operations]()
+		{
+			RunOperations(operations, [](int32_t nrOfBytes) { return malloc(static_cast<size_t>(nrOfBytes)); }, [](void* pMemory) { free(pMemory); });
+		}) };
+
+	// The linear search takes seconds per 100k pairs, so a tenth of the pairs runs once and the time is scaled up
+	// Its cost per pair only depends on the amount of live allocations, so this doesn't flatter the result
+	const std::vector<Operation> listOperations{ operations.begin(), operations.begin() + g_NrOfOperations / 10 };
+	const double listMs{ 10.0 * leap::Benchmark::Measure("List-based allocator (100k pairs)", 1, [&listOperations]()
+		{
+			ListAllocator allocator{};
+			RunOperations(listOperations, [&allocator](int32_t nrOfBytes) { return allocator.Allocate(nrOfBytes); }, [&allocator](void* pMemory) { allocator.Deallocate(pMemory); });
+		}) };
+
+	leap::Benchmark::PrintHeader("Mallocator speedup");
+	leap::Benchmark::PrintSpeedup("over malloc", mallocMs, mallocatorMs);
+	leap::Benchmark::PrintSpeedup("over the list-based allocator", listMs, mallocatorMs);
+
+	return 0;
+}
\ No newline at end of file
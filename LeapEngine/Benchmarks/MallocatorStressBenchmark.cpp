@@ -0,0 +1,235 @@
+#include "../Memory/MemoryTracker.h"
+
+#include <Benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <latch>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+// Stresses the Mallocator behind operator new from several threads at once
+// Every allocation is stamped with a pattern that is checked before it is freed, so a block that is handed out twice or
+//		overwritten by the allocator shows up as corruption
+// The first part measures how the throughput scales with the amount of threads when every thread frees its own allocations,
+//		the second part hands every allocation to another thread to free it
+
+namespace
+{
+	constexpr uint32_t g_NrOfOperationsPerThread{ 500'000 };
+	constexpr uint32_t g_NrOfLiveAllocations{ 1024 };
+	constexpr uint32_t g_HandOverBatchSize{ 256 };
+	constexpr uint32_t g_MaxNrOfThreads{ 16 };
+
+	std::atomic<uint64_t> g_NrOfCorruptions{};
+
+	uint64_t GetPattern(uint32_t threadIdx, uint32_t operationIdx)
+	{
+		return (static_cast<uint64_t>(threadIdx) << 32 | operationIdx) * 0x9E3779B97F4A7C15ull;
+	}
+
+	size_t GetSize(uint32_t operationIdx)
+	{
+		// Cheap deterministic mix of small and medium sizes, every size is big enough to hold the pattern twice
+		return 16 + (operationIdx * 2654435761u >> 20) % 1024;
+	}
+
+	// The pattern is written to the start and the end of the allocation
+	void* Allocate(uint64_t pattern, size_t nrOfBytes)
+	{
+		char* pMemory{ static_cast<char*>(::operator new(nrOfBytes)) };
+		std::memcpy(pMemory, &pattern, sizeof(pattern));
+		std::memcpy(pMemory + nrOfBytes - sizeof(pattern), &pattern, sizeof(pattern));
+		return pMemory;
+	}
+
+	void Deallocate(void* pMemory, uint64_t pattern, size_t nrOfBytes)
+	{
+		const char* pBytes{ static_cast<const char*>(pMemory) };
+
+		uint64_t first{}, last{};
+		std::memcpy(&first, pBytes, sizeof(first));
+		std::memcpy(&last, pBytes + nrOfBytes - sizeof(last), sizeof(last));
+		if (first != pattern || last != pattern) g_NrOfCorruptions.fetch_add(1, std::memory_order_relaxed);
+
+		::operator delete(pMemory);
+	}
+
+	struct Allocation final
+	{
+		void* pMemory;
+		uint64_t pattern;
+		size_t nrOfBytes;
+	};
+
+	// Every thread allocates and frees its own blocks
+	void RunLocal(uint32_t threadIdx)
+	{
+		std::vector<Allocation> allocations(g_NrOfLiveAllocations);
+
+		for (uint32_t operationIdx{}; operationIdx < g_NrOfOperationsPerThread; ++operationIdx)
+		{
+			Allocation& allocation{ allocations[operationIdx % g_NrOfLiveAllocations] };
+			if (allocation.pMemory) Deallocate(allocation.pMemory, allocation.pattern, allocation.nrOfBytes);
+
+			allocation.pattern = GetPattern(threadIdx, operationIdx);
+			allocation.nrOfBytes = GetSize(operationIdx);
+			allocation.pMemory = Allocate(allocation.pattern, allocation.nrOfBytes);
+		}
+
+		for (const Allocation& allocation : allocations)
+		{
+			if (allocation.pMemory) Deallocate(allocation.pMemory, allocation.pattern, allocation.nrOfBytes);
+		}
+	}
+
+	// Batches of allocations are handed to the next thread through its mailbox
+	struct Mailbox final
+	{
+		std::mutex mutex{};
+		std::vector<std::vector<Allocation>> batches{};
+	};
+
+	void RunHandOver(uint32_t threadIdx, std::vector<Mailbox>& mailboxes, std::atomic<uint32_t>& nrOfActiveThreads)
+	{
+		const uint32_t nrOfThreads{ static_cast<uint32_t>(mailboxes.size()) };
+		Mailbox& nextMailbox{ mailboxes[(threadIdx + 1) % nrOfThreads] };
+		Mailbox& ownMailbox{ mailboxes[threadIdx] };
+
+		std::vector<std::vector<Allocation>> receivedBatches{};
+		const auto freeReceivedBatches{ [&]()
+		{
+			{
+				const std::scoped_lock lock{ ownMailbox.mutex };
+				receivedBatches.swap(ownMailbox.batches);
+			}
+
+			for (const std::vector<Allocation>& batch : receivedBatches)
+			{
+				for (const Allocation& allocation : batch) Deallocate(allocation.pMemory, allocation.pattern, allocation.nrOfBytes);
+			}
+			receivedBatches.clear();
+		} };
+
+		for (uint32_t operationIdx{}; operationIdx < g_NrOfOperationsPerThread; operationIdx += g_HandOverBatchSize)
+		{
+			std::vector<Allocation> batch(g_HandOverBatchSize);
+			for (uint32_t allocationIdx{}; allocationIdx < g_HandOverBatchSize; ++allocationIdx)
+			{
+				Allocation& allocation{ batch[allocationIdx] };
+				allocation.pattern = GetPattern(threadIdx, operationIdx + allocationIdx);
+				allocation.nrOfBytes = GetSize(operationIdx + allocationIdx);
+				allocation.pMemory = Allocate(allocation.pattern, allocation.nrOfBytes);
+			}
+
+			{
+				const std::scoped_lock lock{ nextMailbox.mutex };
+				nextMailbox.batches.emplace_back(std::move(batch));
+			}
+
+			freeReceivedBatches();
+		}
+
+		// Keep freeing until every thread stopped handing over batches
+		nrOfActiveThreads.fetch_sub(1, std::memory_order_acq_rel);
+		while (nrOfActiveThreads.load(std::memory_order_acquire) > 0)
+		{
+			freeReceivedBatches();
+			std::this_thread::yield();
+		}
+		freeReceivedBatches();
+	}
+
+	// Allocates after the thread cache of its thread is released, which happens when thread_local objects are destroyed
+	struct ShutdownAllocator final
+	{
+		~ShutdownAllocator()
+		{
+			for (uint32_t operationIdx{}; operationIdx < g_NrOfLiveAllocations; ++operationIdx)
+			{
+				const uint64_t pattern{ GetPattern(UINT32_MAX, operationIdx) };
+				const size_t nrOfBytes{ GetSize(operationIdx) };
+				Deallocate(Allocate(pattern, nrOfBytes), pattern, nrOfBytes);
+			}
+		}
+	};
+
+	template <class Function>
+	double RunThreads(uint32_t nrOfThreads, const Function& function)
+	{
+		std::latch startLatch{ static_cast<std::ptrdiff_t>(nrOfThreads) + 1 };
+
+		std::vector<std::thread> threads{};
+		threads.reserve(nrOfThreads);
+		for (uint32_t threadIdx{}; threadIdx < nrOfThreads; ++threadIdx)
+		{
+			threads.emplace_back([&startLatch, &function, threadIdx]()
+				{
+					startLatch.arrive_and_wait();
+					function(threadIdx);
+				});
+		}
+
+		startLatch.arrive_and_wait();
+		const auto start{ std::chrono::steady_clock::now() };
+		for (std::thread& thread : threads) thread.join();
+		const auto end{ std::chrono::steady_clock::now() };
+
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+}
+
+int main()
+{
+	const uint32_t nrOfHardwareThreads{ std::max(1u, std::min(std::thread::hardware_concurrency(), g_MaxNrOfThreads)) };
+	const uint64_t trackedMemory{ leap::MemoryTracker::GetTotalAllocatedMemory() };
+
+	std::printf("%u alloc/free pairs per thread\n", g_NrOfOperationsPerThread);
+
+	leap::Benchmark::PrintHeader("Every thread frees its own allocations (million pairs per second, scaling)");
+	double singleThreadThroughput{};
+	for (uint32_t nrOfThreads{ 1 }; nrOfThreads <= nrOfHardwareThreads; nrOfThreads *= 2)
+	{
+		const double durationMs{ RunThreads(nrOfThreads, [](uint32_t threadIdx) { RunLocal(threadIdx); }) };
+		const double throughput{ nrOfThreads * static_cast<double>(g_NrOfOperationsPerThread) / durationMs / 1000.0 };
+		if (nrOfThreads == 1) singleThreadThroughput = throughput;
+
+		std::printf("    %2u threads %10.3f ms %10.2f M/s %8.2fx (%3.0f%% of linear)\n",
+			nrOfThreads, durationMs, throughput, throughput / singleThreadThroughput, 100.0 * throughput / singleThreadThroughput / nrOfThreads);
+	}
+
+	leap::Benchmark::PrintHeader("Every allocation is freed by another thread");
+	for (uint32_t nrOfThreads{ 2 }; nrOfThreads <= std::max(2u, nrOfHardwareThreads); nrOfThreads *= 2)
+	{
+		std::vector<Mailbox> mailboxes(nrOfThreads);
+		std::atomic<uint32_t> nrOfActiveThreads{ nrOfThreads };
+
+		const double durationMs{ RunThreads(nrOfThreads, [&mailboxes, &nrOfActiveThreads](uint32_t threadIdx) { RunHandOver(threadIdx, mailboxes, nrOfActiveThreads); }) };
+		const double throughput{ nrOfThreads * static_cast<double>(g_NrOfOperationsPerThread) / durationMs / 1000.0 };
+
+		std::printf("    %2u threads %10.3f ms %10.2f M/s\n", nrOfThreads, durationMs, throughput);
+	}
+
+	leap::Benchmark::PrintHeader("Threads that allocate while they shut down");
+	RunThreads(nrOfHardwareThreads, [](uint32_t threadIdx)
+		{
+			// The first allocation registers the thread cache, the ShutdownAllocator is destroyed after it is released
+			static thread_local ShutdownAllocator shutdownAllocator{};
+			RunLocal(threadIdx);
+		});
+	std::printf("    %2u threads done\n", nrOfHardwareThreads);
+
+	const uint64_t nrOfCorruptions{ g_NrOfCorruptions.load() };
+	const uint64_t leakedMemory{ leap::MemoryTracker::GetTotalAllocatedMemory() - trackedMemory };
+
+	leap::Benchmark::PrintHeader("Result");
+	std::printf("    %llu corrupted allocations, %llu bytes still tracked\n", static_cast<unsigned long long>(nrOfCorruptions), static_cast<unsigned long long>(leakedMemory));
+
+	return nrOfCorruptions == 0 && leakedMemory == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "../ServiceLocator/ServiceLocator.h"
+#include "../Jobs/JobSystem.h"
+#include "../Physics/PhysicsTaskScheduler.h"
+
+#include <PhysX/PhysXEngine.h>
+#include <Interfaces/IPhysics.h>
+#include <Interfaces/IPhysicsObject.h>
+#include <Interfaces/IShape.h>
+#include <Data/RaycastHit.h>
+#include <Data/SceneQuery.h>
+
+#include <Benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <geometric.hpp>
+
+// Casts 10k rays per frame into a scene with 50k static colliders
+// The rays are cast one by one with IPhysics::Raycast, as one SceneQueryBatch on the calling thread
+//		and as one SceneQueryBatch spread over the workers of the job system
+// Every method has to report the same closest collider for every ray, otherwise the benchmark fails
+
+namespace
+{
+	constexpr uint32_t g_NrOfStaticColliders{ 50'000 };
+	constexpr uint32_t g_NrOfRaysPerFrame{ 10'000 };
+	constexpr int g_NrOfFrames{ 60 };
+	constexpr float g_Spacing{ 4.0f };
+
+	// The static colliders are boxes of different heights laid out on a grid
+	class StaticScene final
+	{
+	public:
+		explicit StaticScene(leap::physics::IPhysics& physics)
+			: m_Owners(g_NrOfStaticColliders)
+			, m_GridSize{ static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(g_NrOfStaticColliders)))) }
+		{
+			m_pShapes.reserve(g_NrOfStaticColliders);
+
+			for (uint32_t i{}; i < g_NrOfStaticColliders; ++i)
+			{
+				void* pOwner{ &m_Owners[i] };
+				const float height{ 1.0f + static_cast<float>(i * 2654435761u >> 28) };
+
+				std::unique_ptr<leap::physics::IShape> pShape{ physics.CreateShape(pOwner, leap::physics::EShape::Box) };
+				pShape->SetSize({ g_Spacing * 0.75f, height, g_Spacing * 0.75f });
+
+				leap::physics::IPhysicsObject* pObject{ physics.Get(pOwner) };
+				pObject->AddShape(pShape.get());
+				pObject->SetTransform({ (i % m_GridSize) * g_Spacing, height * 0.5f, (i / m_GridSize) * g_Spacing }, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f });
+
+				m_pShapes.emplace_back(std::move(pShape));
+			}
+		}
+
+		StaticScene(const StaticScene& other) = delete;
+		StaticScene(StaticScene&& other) = delete;
+		StaticScene& operator=(const StaticScene& other) = delete;
+		StaticScene& operator=(StaticScene&& other) = delete;
+
+		float GetExtent() const { return m_GridSize * g_Spacing; }
+
+	private:
+		std::vector<char> m_Owners;
+		std::vector<std::unique_ptr<leap::physics::IShape>> m_pShapes{};
+		uint32_t m_GridSize;
+	};
+
+	// Rays that start above the scene and point down at an angle, like line of sight and ground checks would
+	std::vector<leap::physics::RaycastQuery> CreateRaycasts(float extent)
+	{
+		std::mt19937 random{ 1337 };
+		std::uniform_real_distribution<float> positionDistribution{ 0.0f, extent };
+		std::uniform_real_distribution<float> tiltDistribution{ -0.5f, 0.5f };
+
+		std::vector<leap::physics::RaycastQuery> raycasts(g_NrOfRaysPerFrame);
+		for (leap::physics::RaycastQuery& raycast : raycasts)
+		{
+			raycast.start = { positionDistribution(random), 40.0f, positionDistribution(random) };
+			raycast.direction = glm::normalize(glm::vec3{ tiltDistribution(random), -1.0f, tiltDistribution(random) });
+			raycast.distance = 100.0f;
+		}
+
+		return raycasts;
+	}
+}
+
+int main()
+{
+	leap::ServiceLocator::RegisterJobSystem(0);
+	leap::ServiceLocator::RegisterPhysics<leap::physics::PhysXEngine>();
+
+	leap::physics::IPhysics& physics{ leap::ServiceLocator::GetPhysics() };
+	physics.SetSyncFunc([](void*, const glm::vec3&, const glm::quat&) {});
+	physics.CreateScene();
+
+	const StaticScene scene{ physics };
+
+	// The first step creates the actors of the colliders
+	physics.Update(1.0f / 50.0f);
+
+	leap::physics::SceneQueryBatch batch{};
+	batch.raycasts = CreateRaycasts(scene.GetExtent());
+
+	std::printf("%u rays per frame, %u static colliders, fastest of %d frames\n", g_NrOfRaysPerFrame, g_NrOfStaticColliders, g_NrOfFrames);
+	leap::Benchmark::PrintHeader("Raycasts per frame");
+
+	std::vector<void*> pSingleHits(g_NrOfRaysPerFrame);
+	const double singleMs{ leap::Benchmark::Measure("IPhysics::Raycast per ray", g_NrOfFrames, [&physics, &batch, &pSingleHits]()
+		{
+			for (uint32_t i{}; i < g_NrOfRaysPerFrame; ++i)
+			{
+				const leap::physics::RaycastQuery& raycast{ batch.raycasts[i] };
+
+				leap::physics::RaycastHit hit{};
+				pSingleHits[i] = physics.Raycast(raycast.start, raycast.direction, raycast.distance, hit) ? hit.pCollider : nullptr;
+			}
+		}) };
+
+	// Without a task scheduler the batch runs on the calling thread
+	physics.SetTaskScheduler(nullptr);
+	const double batchMs{ leap::Benchmark::Measure("SceneQueryBatch on the calling thread", g_NrOfFrames, [&physics, &batch]() { physics.ExecuteQueries(batch); }) };
+
+	physics.SetTaskScheduler(std::make_unique<leap::PhysicsTaskScheduler>());
+	const double parallelBatchMs{ leap::Benchmark::Measure("SceneQueryBatch on the job system", g_NrOfFrames, [&physics, &batch]() { physics.ExecuteQueries(batch); }) };
+
+	leap::Benchmark::PrintHeader("Batch speedup over IPhysics::Raycast per ray");
+	leap::Benchmark::PrintSpeedup("on the calling thread", singleMs, batchMs);
+	leap::Benchmark::PrintSpeedup("on the job system", singleMs, parallelBatchMs);
+
+	uint32_t nrOfHits{};
+	uint32_t nrOfMismatches{};
+	for (uint32_t i{}; i < g_NrOfRaysPerFrame; ++i)
+	{
+		const leap::physics::QueryResult& result{ batch.raycastResults[i] };
+		void* pBatchHit{ result.nrOfHits > 0 ? batch.hits[result.firstHit].pCollider : nullptr };
+
+		if (pBatchHit) ++nrOfHits;
+		if (pBatchHit != pSingleHits[i]) ++nrOfMismatches;
+	}
+
+	leap::Benchmark::PrintHeader("Result");
+	std::printf("    %u rays hit a collider, %u rays hit a different collider than IPhysics::Raycast\n", nrOfHits, nrOfMismatches);
+
+	// The workers of the job system are stopped before the physics engine is released
+	physics.SetTaskScheduler(nullptr);
+
+	return nrOfMismatches == 0 ? 0 : 1;
+}
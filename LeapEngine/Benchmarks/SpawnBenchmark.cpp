@@ -0,0 +1,216 @@
+#include "../Leap.h"
+#include "../Memory/ObjectPool.h"
+#include "../SceneGraph/SceneManager.h"
+#include "../SceneGraph/Scene.h"
+#include "../SceneGraph/GameObject.h"
+#include "../Components/Component.h"
+
+#include <Benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Spawns and despawns 50k objects at once
+// The first part compares the object pools with the make_unique they replaced on a polymorphic object,
+//		every object also allocates a small buffer like a name would, which scatters the make_unique objects across the heap
+// The second part spawns and despawns 50k gameobjects with a component through a headless scene, one frame each
+
+namespace
+{
+	constexpr uint32_t g_NrOfObjects{ 50'000 };
+	constexpr int g_NrOfCycles{ 10 };
+	constexpr int g_NrOfRuns{ 3 };
+
+	class Projectile
+	{
+	public:
+		Projectile() = default;
+		virtual ~Projectile() = default;
+
+		Projectile(const Projectile& other) = delete;
+		Projectile(Projectile&& other) = delete;
+		Projectile& operator=(const Projectile& other) = delete;
+		Projectile& operator=(Projectile&& other) = delete;
+
+		virtual void Update() { m_Position += m_Velocity; }
+		float GetPosition() const { return m_Position; }
+
+	private:
+		float m_Position{};
+		float m_Velocity{ 1.0f };
+		char m_Padding[48]{};
+	};
+
+	struct PooledObject final
+	{
+		leap::PooledPtr<Projectile> pProjectile;
+		std::unique_ptr<char[]> pName;
+	};
+
+	struct HeapObject final
+	{
+		std::unique_ptr<Projectile> pProjectile;
+		std::unique_ptr<char[]> pName;
+	};
+
+	// Spawns all objects, updates them a few times and despawns them again
+	template <class Object, class CreateFunction>
+	float RunCycles(std::vector<Object>& objects, const CreateFunction& create)
+	{
+		float checksum{};
+
+		for (int cycleIdx{}; cycleIdx < g_NrOfCycles; ++cycleIdx)
+		{
+			for (uint32_t objectIdx{}; objectIdx < g_NrOfObjects; ++objectIdx)
+			{
+				objects.emplace_back(Object{ create(), std::make_unique<char[]>(24 + objectIdx % 64) });
+			}
+
+			for (int updateIdx{}; updateIdx < 4; ++updateIdx)
+			{
+				for (const Object& object : objects) object.pProjectile->Update();
+			}
+			for (const Object& object : objects) checksum += object.pProjectile->GetPosition();
+
+			objects.clear();
+		}
+
+		return checksum;
+	}
+
+	// Alternates between a frame that spawns all gameobjects and a frame that destroys them again
+	class Spawner final : public leap::Component
+	{
+	public:
+		Spawner() = default;
+		~Spawner() = default;
+
+		Spawner(const Spawner& other) = delete;
+		Spawner(Spawner&& other) = delete;
+		Spawner& operator=(const Spawner& other) = delete;
+		Spawner& operator=(Spawner&& other) = delete;
+
+		static inline leap::Scene* s_pScene{};
+		static inline double s_SpawnFramesMs{};
+		static inline double s_DespawnFramesMs{};
+		static inline int s_NrOfSpawnFrames{};
+		static inline int s_NrOfDespawnFrames{};
+
+	protected:
+		virtual void Update() override
+		{
+			// The time since the previous update covers the full previous frame, including the cleanup at the end of it
+			const auto now{ std::chrono::steady_clock::now() };
+			const double previousFrameMs{ std::chrono::duration<double, std::milli>(now - m_PreviousUpdate).count() };
+			m_PreviousUpdate = now;
+
+			// The first cycle warms up the pools
+			if (m_FrameIdx > 2)
+			{
+				if (m_pObjects.empty())
+				{
+					s_DespawnFramesMs += previousFrameMs;
+					++s_NrOfDespawnFrames;
+				}
+				else
+				{
+					s_SpawnFramesMs += previousFrameMs;
+					++s_NrOfSpawnFrames;
+				}
+			}
+			++m_FrameIdx;
+
+			if (m_pObjects.empty())
+			{
+				m_pObjects.reserve(g_NrOfObjects);
+				for (uint32_t objectIdx{}; objectIdx < g_NrOfObjects; ++objectIdx)
+				{
+					leap::GameObject* pObject{ s_pScene->CreateGameObject("Spawned") };
+					pObject->AddComponent<Payload>();
+					m_pObjects.push_back(pObject);
+				}
+			}
+			else
+			{
+				for (leap::GameObject* pObject : m_pObjects) pObject->Destroy();
+				m_pObjects.clear();
+			}
+		}
+
+	private:
+		class Payload final : public leap::Component
+		{
+		public:
+			Payload() = default;
+			~Payload() = default;
+
+			Payload(const Payload& other) = delete;
+			Payload(Payload&& other) = delete;
+			Payload& operator=(const Payload& other) = delete;
+			Payload& operator=(Payload&& other) = delete;
+
+		protected:
+			virtual void Update() override { ++m_NrOfUpdates; }
+
+		private:
+			uint32_t m_NrOfUpdates{};
+		};
+
+		std::vector<leap::GameObject*> m_pObjects{};
+		std::chrono::steady_clock::time_point m_PreviousUpdate{ std::chrono::steady_clock::now() };
+		int m_FrameIdx{};
+	};
+}
+
+int main()
+{
+	std::printf("%u objects, %d spawn/update/despawn cycles\n", g_NrOfObjects, g_NrOfCycles);
+	leap::Benchmark::PrintHeader("Polymorphic objects");
+
+	float checksum{};
+
+	std::vector<HeapObject> heapObjects{};
+	heapObjects.reserve(g_NrOfObjects);
+	const double heapMs{ leap::Benchmark::Measure("make_unique", g_NrOfRuns, [&heapObjects, &checksum]()
+		{
+			checksum += RunCycles(heapObjects, []() { return std::make_unique<Projectile>(); });
+		}) };
+
+	std::vector<PooledObject> pooledObjects{};
+	pooledObjects.reserve(g_NrOfObjects);
+	const double poolMs{ leap::Benchmark::Measure("ObjectPools", g_NrOfRuns, [&pooledObjects, &checksum]()
+		{
+			checksum += RunCycles(pooledObjects, []() { return leap::ObjectPools::GetInstance().Create<Projectile>(); });
+		}) };
+
+	leap::Benchmark::PrintSpeedup("ObjectPools over make_unique", heapMs, poolMs);
+
+	leap::Benchmark::PrintHeader("Gameobjects in a headless scene (ms per frame)");
+	{
+		leap::LeapEngine engine{};
+
+		const auto afterInitialize{ []()
+			{
+				leap::SceneManager::GetInstance().AddScene("Spawn benchmark", [](leap::Scene& scene)
+					{
+						Spawner::s_pScene = &scene;
+						scene.CreateGameObject("Spawner")->AddComponent<Spawner>();
+					});
+			} };
+
+		// Run as fast as possible, the frames are timed by the spawner
+		engine.Run(afterInitialize, 1'000'000, 2 * (g_NrOfCycles + 2));
+	}
+
+	std::printf("    %-48s %10.3f ms\n", "Spawn frame", Spawner::s_SpawnFramesMs / std::max(Spawner::s_NrOfSpawnFrames, 1));
+	std::printf("    %-48s %10.3f ms\n", "Despawn frame", Spawner::s_DespawnFramesMs / std::max(Spawner::s_NrOfDespawnFrames, 1));
+
+	// Keeps the updates from being optimized away
+	std::printf("\nChecksum %f\n", static_cast<double>(checksum));
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+#include "../Leap.h"
+#include "../SceneGraph/SceneManager.h"
+#include "../SceneGraph/Scene.h"
+#include "../SceneGraph/GameObject.h"
+#include "../Components/Component.h"
+
+#include <Benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Measures the time a frame spends between LateUpdate and the next Update, which covers OnFrameEnd and OnFrameStart of the scene
+// An empty scene and a static scene of 100k gameobjects are measured in the same run, the lifecycle phases only handle queued changes,
+//		so both should take the same time
+// A single walk over the 100k gameobjects is printed as reference, the phases used to do seven of those every frame
+
+namespace
+{
+	constexpr uint32_t g_NrOfParents{ 1'000 };
+	constexpr uint32_t g_NrOfChildrenPerParent{ 99 };
+	constexpr uint32_t g_NrOfWarmupFrames{ 10 };
+	constexpr uint32_t g_NrOfMeasuredFrames{ 200 };
+
+	struct SceneResult final
+	{
+		double totalMs{};
+		uint32_t nrOfFrames{};
+	};
+
+	SceneResult g_EmptyScene{};
+	SceneResult g_StaticScene{};
+	double g_TreeWalkMs{};
+	uint32_t g_NrOfWalkedObjects{};
+
+	uint32_t WalkTree(const leap::GameObject* pObject)
+	{
+		uint32_t nrOfObjects{ 1 };
+		for (size_t childIdx{}; childIdx < pObject->GetChildCount(); ++childIdx)
+		{
+			nrOfObjects += WalkTree(pObject->GetChild(static_cast<int>(childIdx)));
+		}
+		return nrOfObjects;
+	}
+
+	// Times the gap between its LateUpdate and its next Update, and switches to the static scene once the empty scene is measured
+	class FrameProbe final : public leap::Component
+	{
+	public:
+		FrameProbe() = default;
+		~FrameProbe() = default;
+
+		FrameProbe(const FrameProbe& other) = delete;
+		FrameProbe(FrameProbe&& other) = delete;
+		FrameProbe& operator=(const FrameProbe& other) = delete;
+		FrameProbe& operator=(FrameProbe&& other) = delete;
+
+		void SetResult(SceneResult* pResult, bool isLastScene)
+		{
+			m_pResult = pResult;
+			m_IsLastScene = isLastScene;
+		}
+
+	protected:
+		virtual void Update() override
+		{
+			const auto now{ std::chrono::steady_clock::now() };
+
+			++m_FrameIdx;
+
+			// The reference walk runs once the static scene is settled, outside of the measured gap
+			if (m_IsLastScene && m_FrameIdx == g_NrOfWarmupFrames)
+			{
+				const auto start{ std::chrono::steady_clock::now() };
+				g_NrOfWalkedObjects = WalkTree(GetGameObject()->GetParent());
+				g_TreeWalkMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			}
+			if (m_FrameIdx > g_NrOfWarmupFrames && m_pResult->nrOfFrames < g_NrOfMeasuredFrames)
+			{
+				m_pResult->totalMs += std::chrono::duration<double, std::milli>(now - m_LastLateUpdate).count();
+				++m_pResult->nrOfFrames;
+			}
+
+			if (!m_IsLastScene && m_pResult->nrOfFrames == g_NrOfMeasuredFrames && !m_IsNextSceneRequested)
+			{
+				m_IsNextSceneRequested = true;
+				leap::SceneManager::GetInstance().LoadScene(1);
+			}
+		}
+
+		virtual void LateUpdate() override
+		{
+			m_LastLateUpdate = std::chrono::steady_clock::now();
+		}
+
+	private:
+		SceneResult* m_pResult{};
+		bool m_IsLastScene{};
+		bool m_IsNextSceneRequested{};
+		uint32_t m_FrameIdx{};
+		std::chrono::steady_clock::time_point m_LastLateUpdate{};
+	};
+}
+
+int main()
+{
+	std::printf("%u static gameobjects, %u measured frames per scene\n", g_NrOfParents * (g_NrOfChildrenPerParent + 1), g_NrOfMeasuredFrames);
+
+	{
+		leap::LeapEngine engine{};
+
+		const auto afterInitialize{ []()
+			{
+				leap::SceneManager& sceneManager{ leap::SceneManager::GetInstance() };
+				sceneManager.AddScene("Empty scene", [](leap::Scene& scene)
+					{
+						scene.CreateGameObject("Probe")->AddComponent<FrameProbe>()->SetResult(&g_EmptyScene, false);
+					});
+				sceneManager.AddScene("Static scene", [](leap::Scene& scene)
+					{
+						for (uint32_t parentIdx{}; parentIdx < g_NrOfParents; ++parentIdx)
+						{
+							leap::GameObject* pParent{ scene.CreateGameObject("Parent") };
+							for (uint32_t childIdx{}; childIdx < g_NrOfChildrenPerParent; ++childIdx) pParent->CreateChild("Child");
+						}
+						scene.CreateGameObject("Probe")->AddComponent<FrameProbe>()->SetResult(&g_StaticScene, true);
+					});
+			} };
+
+		// Run as fast as possible, the frames are timed by the probes
+		// Every scene needs its warm-up and measured frames, the extra frames cover the scene switch
+		constexpr uint32_t nrOfFrames{ 2 * (g_NrOfWarmupFrames + g_NrOfMeasuredFrames) + 10 };
+		engine.Run(afterInitialize, 1'000'000, nrOfFrames);
+	}
+
+	leap::Benchmark::PrintHeader("OnFrameEnd + OnFrameStart (ms per frame)");
+	const double emptyMs{ g_EmptyScene.nrOfFrames > 0 ? g_EmptyScene.totalMs / g_EmptyScene.nrOfFrames : 0.0 };
+	const double staticMs{ g_StaticScene.nrOfFrames > 0 ? g_StaticScene.totalMs / g_StaticScene.nrOfFrames : 0.0 };
+	std::printf("    %-48s %10.4f ms\n", "Empty scene", emptyMs);
+	std::printf("    %-48s %10.4f ms\n", "100k static gameobjects", staticMs);
+	std::printf("    %-48s %10.4f ms\n", "Difference", staticMs - emptyMs);
+
+	leap::Benchmark::PrintHeader("Reference");
+	std::printf("    %-48s %10.4f ms (%u gameobjects)\n", "One walk over the static scene", g_TreeWalkMs, g_NrOfWalkedObjects);
+
+	return g_EmptyScene.nrOfFrames == g_NrOfMeasuredFrames && g_StaticScene.nrOfFrames == g_NrOfMeasuredFrames ? 0 : 1;
+}
@@ -1,6 +1,18 @@
 #include "Component.h"
 
 #include "../SceneGraph/GameObject.h"
+#include "../SceneGraph/Scene.h"
+#include "../SceneGraph/Handle.h"
+
+leap::Component::Component()
+	: m_HandleIndex{ HandleTables::GetInstance().GetComponents().Add(this) }
+{
+}
+
+leap::Component::~Component()
+{
+	HandleTables::GetInstance().GetComponents().Remove(m_HandleIndex);
+}
 
 leap::Transform* leap::Component::GetTransform() const
 {
@@ -9,23 +21,32 @@ leap::Transform* leap::Component::GetTransform() const
 
 void leap::Component::Destroy()
 {
-	m_StateFlags |= static_cast<unsigned char>(StateFlags::IsMarkedAsDead);
+	if (IsMarkedAsDead()) return;
+	if (!Scene::CanChangeStructure()) return;
+
+	m_StateFlags |= static_cast<unsigned short>(StateFlags::IsMarkedAsDead);
+	m_pOwner->GetScene()->QueueDestroy(this);
 }
 
 bool leap::Component::IsMarkedAsDead() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsMarkedAsDead);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::IsMarkedAsDead);
 }
 
 void leap::Component::SetActive(bool isActive)
 {
+	if (!Scene::CanChangeStructure()) return;
+
 	// Set the next active state
 	// The new active state will be handled at the end of the frame
 	//		(e.g. call OnEnable/OnDisable)
 	if (isActive)
-		m_StateFlags |= static_cast<unsigned char>(StateFlags::IsActiveLocalNextFrame);
+		m_StateFlags |= static_cast<unsigned short>(StateFlags::IsActiveLocalNextFrame);
 	else
-		m_StateFlags &= ~static_cast<unsigned char>(StateFlags::IsActiveLocalNextFrame);
+		m_StateFlags &= ~static_cast<unsigned short>(StateFlags::IsActiveLocalNextFrame);
+
+	// Components that aren't added to a gameobject yet get their state applied when they are
+	if (m_pOwner) m_pOwner->GetScene()->QueueActiveStateChange(this);
 }
 
 bool leap::Component::IsActive() const
@@ -66,7 +87,7 @@ void leap::Component::TryCallStart()
 	if (!IsActiveWorld()) return;
 
 	// Active the started bit flag
-	m_StateFlags |= static_cast<unsigned char>(StateFlags::HasStarted);
+	m_StateFlags |= static_cast<unsigned short>(StateFlags::HasStarted);
 
 	Start();
 }
@@ -85,59 +106,59 @@ void leap::Component::TryCallEnableAndDisable()
 
 bool leap::Component::IsActiveLocalNextFrame() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsActiveLocalNextFrame);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::IsActiveLocalNextFrame);
 }
 
 bool leap::Component::IsActiveLocal() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsActiveLocal);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::IsActiveLocal);
 }
 
 void leap::Component::SetActiveLocal(bool isActive)
 {
 	if (isActive)
-		m_StateFlags |= static_cast<unsigned char>(StateFlags::IsActiveLocal);
+		m_StateFlags |= static_cast<unsigned short>(StateFlags::IsActiveLocal);
 	else
-		m_StateFlags &= ~static_cast<unsigned char>(StateFlags::IsActiveLocal);
+		m_StateFlags &= ~static_cast<unsigned short>(StateFlags::IsActiveLocal);
 }
 
 bool leap::Component::IsActiveWorld() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsActiveWorld);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::IsActiveWorld);
 }
 
 void leap::Component::SetActiveWorld(bool isActive)
 {
 	if (isActive)
-		m_StateFlags |= static_cast<unsigned char>(StateFlags::IsActiveWorld);
+		m_StateFlags |= static_cast<unsigned short>(StateFlags::IsActiveWorld);
 	else
-		m_StateFlags &= ~static_cast<unsigned char>(StateFlags::IsActiveWorld);
+		m_StateFlags &= ~static_cast<unsigned short>(StateFlags::IsActiveWorld);
 }
 
 bool leap::Component::WasActiveWorldPreviousFrame() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::WasActiveWorldPreviousFrame);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::WasActiveWorldPreviousFrame);
 }
 
 void leap::Component::SetPreviousActiveWorld(bool isActive)
 {
 	if (isActive)
-		m_StateFlags |= static_cast<unsigned char>(StateFlags::WasActiveWorldPreviousFrame);
+		m_StateFlags |= static_cast<unsigned short>(StateFlags::WasActiveWorldPreviousFrame);
 	else
-		m_StateFlags &= ~static_cast<unsigned char>(StateFlags::WasActiveWorldPreviousFrame);
+		m_StateFlags &= ~static_cast<unsigned short>(StateFlags::WasActiveWorldPreviousFrame);
 }
 
 bool leap::Component::HasStarted() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::HasStarted);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::HasStarted);
 }
 
 bool leap::Component::IsInitialized() const
 {
-	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsInitialized);
+	return m_StateFlags & static_cast<unsigned short>(StateFlags::IsInitialized);
 }
 
 void leap::Component::Initialize()
 {
-	m_StateFlags |= static_cast<unsigned char>(StateFlags::IsInitialized);
+	m_StateFlags |= static_cast<unsigned short>(StateFlags::IsInitialized);
 }
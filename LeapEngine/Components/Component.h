@@ -1,16 +1,43 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
 namespace leap
 {
 	class GameObject;
 	class Transform;
 	class Collider;
+	class ComponentStorage;
+	class ComponentRegistry;
+	class Scene;
+	class HandleTables;
+
+	/// <summary>
+	/// Declares what the Update of a component type accesses, so the scene knows if it can run on the worker threads of the job system
+	/// A component type declares this as a public member: static constexpr leap::UpdateAccess m_UpdateAccess{ leap::UpdateAccess::OwnGameObject };
+	/// A parallel Update can't make structural changes (create, destroy, add components, change the active state)
+	/// </summary>
+	enum class UpdateAccess : unsigned char
+	{
+		// Update can access anything and runs on the main thread
+		MainThread,
+		// Update only reads from the scene and only writes to the component itself
+		ReadOnly,
+		// Update only writes to its own gameobject, its transform and components
+		//		Gameobjects whose parent also changes its transform in a parallel Update are not supported
+		OwnGameObject
+	};
 
 	class Component
 	{
 	public:
-		Component() = default;
-		virtual ~Component() = default;
+		static constexpr UpdateAccess m_UpdateAccess{ UpdateAccess::MainThread };
+
+		Component();
+		virtual ~Component();
 
 		Component(const Component& other) = delete;
 		Component(Component&& other) = delete;
@@ -64,9 +91,31 @@ namespace leap
 
 	private:
 		friend GameObject;
+		friend Scene;
+		friend ComponentStorage;
+		friend ComponentRegistry;
+		friend HandleTables;
 
 		void SetOwner(GameObject* pOwner);
 
+		/// <summary>
+		/// The lifecycle methods that get ticked every frame
+		/// A component is only registered in the tick lists of the methods its type overrides
+		/// An Update that is declared parallel safe gets ticked in the ParallelUpdate list instead of the Update list
+		/// </summary>
+		enum class TickFlags : unsigned char
+		{
+			FixedUpdate		= 1 << 0,
+			Update			= 1 << 1,
+			LateUpdate		= 1 << 2,
+			OnGUI			= 1 << 3,
+			ParallelUpdate	= 1 << 4
+		};
+		static constexpr size_t m_NrOfTickPhases{ 5 };
+
+		template <class T>
+		static constexpr unsigned char GetTickFlags();
+
 		void ChangeActiveState();
 		void TryCallStart();
 		void TryCallEnableAndDisable();
@@ -86,7 +135,7 @@ namespace leap
 		bool IsInitialized() const;
 		void Initialize();
 
-		enum class StateFlags : char
+		enum class StateFlags : unsigned short
 		{
 			IsActiveLocalNextFrame		= 1 << 0,
 			IsActiveLocal				= 1 << 1,
@@ -94,11 +143,55 @@ namespace leap
 			IsActiveWorld				= 1 << 3,
 			IsInitialized				= 1 << 4,
 			HasStarted					= 1 << 5,
-			IsMarkedAsDead				= 1 << 6
+			IsMarkedAsDead				= 1 << 6,
+			IsQueuedForStateChange		= 1 << 7,
+			IsBeingProcessed			= 1 << 8
 		};
 
-		unsigned char m_StateFlags{ static_cast<unsigned char>(StateFlags::IsActiveLocalNextFrame) };
+		unsigned short m_StateFlags{ static_cast<unsigned short>(StateFlags::IsActiveLocalNextFrame) };
 
 		GameObject* m_pOwner{};
+
+		unsigned char m_TickFlags{};
+		uint32_t m_TypeID{};
+
+		static constexpr unsigned int m_InvalidStorageIndex{ 0xFFFFFFFF };
+		std::array<unsigned int, m_NrOfTickPhases> m_TickIndices{ m_InvalidStorageIndex, m_InvalidStorageIndex, m_InvalidStorageIndex, m_InvalidStorageIndex, m_InvalidStorageIndex };
+		unsigned int m_RegistryIndex{ m_InvalidStorageIndex };
+		// The slot of this component in the handle table
+		uint32_t m_HandleIndex{};
 	};
+
+	template <class T>
+	inline constexpr unsigned char Component::GetTickFlags()
+	{
+		using Method = void (Component::*)();
+
+		// A method that T overrides as protected or private can't be named from here,
+		//		a method that T inherits can and is still a pointer to a member of Component
+		unsigned char tickFlags{};
+
+		if constexpr (!requires { &T::FixedUpdate; }) tickFlags |= static_cast<unsigned char>(TickFlags::FixedUpdate);
+		else if constexpr (!std::is_same_v<decltype(&T::FixedUpdate), Method>) tickFlags |= static_cast<unsigned char>(TickFlags::FixedUpdate);
+
+		if constexpr (!requires { &T::Update; }) tickFlags |= static_cast<unsigned char>(TickFlags::Update);
+		else if constexpr (!std::is_same_v<decltype(&T::Update), Method>) tickFlags |= static_cast<unsigned char>(TickFlags::Update);
+
+		if constexpr (T::m_UpdateAccess != UpdateAccess::MainThread)
+		{
+			if (tickFlags & static_cast<unsigned char>(TickFlags::Update))
+			{
+				tickFlags &= ~static_cast<unsigned char>(TickFlags::Update);
+				tickFlags |= static_cast<unsigned char>(TickFlags::ParallelUpdate);
+			}
+		}
+
+		if constexpr (!requires { &T::LateUpdate; }) tickFlags |= static_cast<unsigned char>(TickFlags::LateUpdate);
+		else if constexpr (!std::is_same_v<decltype(&T::LateUpdate), Method>) tickFlags |= static_cast<unsigned char>(TickFlags::LateUpdate);
+
+		if constexpr (!requires { &T::OnGUI; }) tickFlags |= static_cast<unsigned char>(TickFlags::OnGUI);
+		else if constexpr (!std::is_same_v<decltype(&T::OnGUI), Method>) tickFlags |= static_cast<unsigned char>(TickFlags::OnGUI);
+
+		return tickFlags;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "ComponentType.h"
+
+#include "Debug.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	struct TypeRegistry final
+	{
+		struct TypeInfo final
+		{
+			unsigned int hash;
+			std::string_view name;
+		};
+
+		std::mutex mutex{};
+		std::vector<TypeInfo> types{};
+		std::unordered_map<unsigned int, uint32_t> hashToID{};
+	};
+
+	// Created on first use, components can be used during static initialization
+	TypeRegistry& GetRegistry()
+	{
+		static TypeRegistry registry{};
+		return registry;
+	}
+}
+
+uint32_t leap::ComponentType::GetNrOfTypes()
+{
+	TypeRegistry& registry{ GetRegistry() };
+	const std::lock_guard lock{ registry.mutex };
+
+	return static_cast<uint32_t>(registry.types.size());
+}
+
+std::string_view leap::ComponentType::GetName(uint32_t typeID)
+{
+	TypeRegistry& registry{ GetRegistry() };
+	const std::lock_guard lock{ registry.mutex };
+
+	return typeID < registry.types.size() ? registry.types[typeID].name : std::string_view{};
+}
+
+uint32_t leap::ComponentType::Register(unsigned int hash, std::string_view name)
+{
+	TypeRegistry& registry{ GetRegistry() };
+	const std::lock_guard lock{ registry.mutex };
+
+	if (const auto it{ registry.hashToID.find(hash) }; it != registry.hashToID.end())
+	{
+		const TypeRegistry::TypeInfo& other{ registry.types[it->second] };
+		if (other.name == name) return it->second;
+
+		// The ID stays unique, but the hash no longer identifies a single type
+		Debug::LogError("LeapEngine Error: ComponentType > The component types " + std::string{ other.name } + " and " + std::string{ name } + " have the same typename hash, rename one of them");
+	}
+	else
+	{
+		registry.hashToID.emplace(hash, static_cast<uint32_t>(registry.types.size()));
+	}
+
+	const uint32_t typeID{ static_cast<uint32_t>(registry.types.size()) };
+	registry.types.push_back(TypeRegistry::TypeInfo{ hash, name });
+
+	if (typeID == m_MaxNrOfTypes)
+	{
+		Debug::LogWarning("LeapEngine Warning: ComponentType > More than " + std::to_string(m_MaxNrOfTypes) + " component types are used, GetComponent falls back to a linear search for the extra types");
+	}
+
+	return typeID;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "ReflectionUtils.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace leap
+{
+	/// <summary>
+	/// Gives every component type a dense ID, the IDs are handed out in the order the types are first used
+	/// The IDs are used to index the component lookup tables of the gameobjects, only the first m_MaxNrOfTypes types get a lookup table slot
+	/// The object pools are indexed by the same IDs, so every pooled type gets an ID as well
+	/// Two types with the same typename hash are reported, they still get their own ID
+	/// </summary>
+	class ComponentType final
+	{
+	public:
+		ComponentType() = delete;
+
+		static constexpr uint32_t m_MaxNrOfTypes{ 256 };
+
+		template <class T>
+		static uint32_t GetID();
+
+		static uint32_t GetNrOfTypes();
+		static std::string_view GetName(uint32_t typeID);
+
+	private:
+		static uint32_t Register(unsigned int hash, std::string_view name);
+	};
+
+	template <class T>
+	inline uint32_t ComponentType::GetID()
+	{
+		static const uint32_t typeID{ Register(ReflectionUtils::GenerateTypenameHash<T>(), ReflectionUtils::ConstexprTypeName<T>()) };
+		return typeID;
+	}
+}
\ No newline at end of file
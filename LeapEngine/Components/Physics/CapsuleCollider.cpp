@@ -26,7 +26,7 @@ void leap::CapsuleCollider::SetupShape(physics::IPhysicsMaterial* pMaterial)
 
 void leap::CapsuleCollider::RescaleShape()
 {
-	const auto& scale{ GetTransform()->GetWorldScale() };
+	const glm::vec3 scale{ GetTransform()->GetWorldScale() };
 
 	// Apply radius
 	const float transformRadius{ std::max(scale.x, scale.z) };
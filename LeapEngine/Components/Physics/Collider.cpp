@@ -6,6 +6,8 @@
 #include "../Transform/Transform.h"
 #include "Rigidbody.h"
 
+#include "Debug.h"
+
 #include <Interfaces/IPhysics.h>
 #include <Interfaces/IPhysicsObject.h>
 
@@ -13,11 +15,12 @@ void leap::Collider::BaseSetupShape()
 {
 	SetupShape(m_pMaterial.get());
 	m_pShape->SetTrigger(m_IsTrigger);
+	m_pShape->SetLayer(m_Layer);
 }
 
 void leap::Collider::Awake()
 {
-	if (m_pOwningObject) return;
+	if (m_OwningObject) return;
 
 	BaseSetupShape();
 
@@ -28,14 +31,21 @@ void leap::Collider::Awake()
 	if (!pRigidbody) pRigidbody = GetGameObject()->GetComponentInParent<Rigidbody>();
 
 	// Get the physics object associated with the owning gameobject or the owning gameobject of the closest rigidbody
-	m_pOwningObject = pRigidbody == nullptr ? GetGameObject() : pRigidbody->GetGameObject();
-	physics::IPhysicsObject* pObject{ physics.Get(m_pOwningObject) };
+	// Physics objects are keyed on the transform of their gameobject, components keep their address when the scene gets compacted
+	GameObject* pOwningObject{ pRigidbody == nullptr ? GetGameObject() : pRigidbody->GetGameObject() };
+	m_OwningObject = pOwningObject;
+	physics::IPhysicsObject* pObject{ physics.Get(pOwningObject->GetTransform()) };
 
 	// Apply the shape
 	pObject->AddShape(m_pShape.get());
 
 	// Set the transform of the physics object if there is no rigidbody (if there is, it is the responsibility of the rigidbody)
-	if (!pRigidbody) pObject->SetTransform(GetTransform()->GetWorldPosition(), GetTransform()->GetWorldRotation());
+	// A static physics object is only moved again when its transform changes
+	if (!pRigidbody)
+	{
+		pObject->SetTransform(GetTransform()->GetWorldPosition(), GetTransform()->GetWorldRotation());
+		m_StaticPoseSync.Start();
+	}
 	else
 	{
 		const glm::vec3 relativePosition{ GetTransform()->GetWorldPosition() - pRigidbody->GetTransform()->GetWorldPosition() };
@@ -49,8 +59,9 @@ void leap::Collider::Awake()
 
 void leap::Collider::OnDestroy()
 {
-	ServiceLocator::GetPhysics().Get(m_pOwningObject)->RemoveShape(m_pShape.get());
+	if (const GameObject* pOwningObject{ m_OwningObject.Get() }) ServiceLocator::GetPhysics().Get(pOwningObject->GetTransform())->RemoveShape(m_pShape.get());
 	GetTransform()->OnScaleChanged.RemoveListener(this);
+	m_StaticPoseSync.Stop();
 }
 
 void leap::Collider::Notify()
@@ -58,25 +69,46 @@ void leap::Collider::Notify()
 	RescaleShape();
 }
 
+void leap::Collider::StaticPoseSync::Start()
+{
+	m_pCollider->GetTransform()->OnPositionChanged.AddListener(this);
+	m_pCollider->GetTransform()->OnRotationChanged.AddListener(this);
+}
+
+void leap::Collider::StaticPoseSync::Stop()
+{
+	m_pCollider->GetTransform()->OnPositionChanged.RemoveListener(this);
+	m_pCollider->GetTransform()->OnRotationChanged.RemoveListener(this);
+}
+
+void leap::Collider::StaticPoseSync::Notify()
+{
+	Transform* pTransform{ m_pCollider->GetTransform() };
+	ServiceLocator::GetPhysics().Get(pTransform)->SetTransform(pTransform->GetWorldPosition(), pTransform->GetWorldRotation());
+}
+
 void leap::Collider::Move(const Rigidbody* pRigidbody)
 {
 	// If the rigidbody and collider already share the same physics object, do nothing
-	if (pRigidbody->GetGameObject() == m_pOwningObject) return;
+	if (pRigidbody->GetGameObject() == m_OwningObject.Get()) return;
 
 	physics::IPhysics& physics{ ServiceLocator::GetPhysics() };
 
 	// Remove the shape from the previous owner
-	if (m_pOwningObject) physics.Get(m_pOwningObject)->RemoveShape(m_pShape.get());
+	if (const GameObject* pOwningObject{ m_OwningObject.Get() }) physics.Get(pOwningObject->GetTransform())->RemoveShape(m_pShape.get());
 	else BaseSetupShape();
 
+	// The pose of the shape now follows the rigidbody
+	m_StaticPoseSync.Stop();
+
 	const glm::vec3 relativePosition{ (GetTransform()->GetWorldPosition() - pRigidbody->GetTransform()->GetWorldPosition()) * pRigidbody->GetTransform()->GetWorldRotation() };
 	const glm::quat relativeRotation{ glm::conjugate(pRigidbody->GetTransform()->GetWorldRotation()) * GetTransform()->GetWorldRotation() };
 
 	m_pShape->SetRelativeTransform(relativePosition, relativeRotation);
 
 	// Apply the shape to the rigidbody
-	m_pOwningObject = pRigidbody->GetGameObject();
-	physics.Get(m_pOwningObject)->AddShape(m_pShape.get());
+	m_OwningObject = pRigidbody->GetGameObject();
+	physics.Get(pRigidbody->GetTransform())->AddShape(m_pShape.get());
 }
 
 void leap::Collider::SetMaterial(const std::shared_ptr<physics::IPhysicsMaterial>& pMaterial)
@@ -91,7 +123,22 @@ void leap::Collider::SetTrigger(bool isTrigger)
 	if (m_pShape) m_pShape->SetTrigger(isTrigger);
 }
 
+void leap::Collider::SetLayer(unsigned int layer)
+{
+	// The layer is stored as a bit of a 32 bit mask
+	if (layer >= 32)
+	{
+		Debug::LogWarning("LeapEngine Warning: Collider::SetLayer > A collider can only be on layer 0 to 31, the layer is not changed");
+		return;
+	}
+
+	m_Layer = layer;
+
+	if (m_pShape) m_pShape->SetLayer(layer);
+}
+
 leap::Rigidbody* leap::Collider::GetRigidbody() const
 {
-	return m_pOwningObject->GetComponent<Rigidbody>();
+	const GameObject* pOwningObject{ m_OwningObject.Get() };
+	return pOwningObject ? pOwningObject->GetComponent<Rigidbody>() : nullptr;
 }
\ No newline at end of file
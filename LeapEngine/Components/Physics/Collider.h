@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Component.h"
+#include "../../SceneGraph/Handle.h"
 
 #include <Interfaces/IShape.h>
 #include <Subject.h>
@@ -39,6 +40,13 @@ namespace leap
 		void SetMaterial(const std::shared_ptr<physics::IPhysicsMaterial>& pMaterial);
 		void SetTrigger(bool isTrigger);
 
+		/// <summary>
+		/// Scene queries only hit the colliders on the layers in their layer mask, every collider starts on layer 0
+		/// Only layer 0 to 31 exist, any other layer is ignored with a warning
+		/// </summary>
+		void SetLayer(unsigned int layer);
+		unsigned int GetLayer() const { return m_Layer; }
+
 		Rigidbody* GetRigidbody() const;
 
 	protected:
@@ -59,8 +67,27 @@ namespace leap
 
 		void Move(const Rigidbody* pRigidbody);
 
-		GameObject* m_pOwningObject{};
+		/// <summary>
+		/// Moves the static physics object of a collider without a rigidbody when its transform moves or rotates
+		/// </summary>
+		class StaticPoseSync final : public Observer
+		{
+		public:
+			StaticPoseSync(Collider* pCollider) : m_pCollider{ pCollider } {}
+
+			void Start();
+			void Stop();
+
+		private:
+			virtual void Notify() override;
+
+			Collider* m_pCollider{};
+		};
+
+		StaticPoseSync m_StaticPoseSync{ this };
+		GameObjectHandle m_OwningObject{};
 		std::shared_ptr<physics::IPhysicsMaterial> m_pMaterial{};
+		unsigned int m_Layer{};
 		bool m_IsTrigger{};
 
 		friend Rigidbody;
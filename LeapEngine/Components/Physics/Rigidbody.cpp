@@ -156,8 +156,8 @@ bool leap::Rigidbody::IsConstraint(physics::Rigidbody::Constraint::Flag flag, bo
 
 void leap::Rigidbody::Awake()
 {
-	// Get the physics object for this gameobject
-	physics::IPhysicsObject* pObject{ ServiceLocator::GetPhysics().Get(GetGameObject()) };
+	// Get the physics object for this gameobject, it is keyed on the transform
+	physics::IPhysicsObject* pObject{ ServiceLocator::GetPhysics().Get(GetTransform()) };
 
 	// Create a rigidbody
 	physics::Rigidbody* pNewRigidbody{ pObject->SetRigidbody(true) };
@@ -172,15 +172,29 @@ void leap::Rigidbody::Awake()
 	m_pRigidbody = pNewRigidbody;
 
 	// Set the current transform to the physics object
-	ServiceLocator::GetPhysics().Get(GetGameObject())->SetTransform(GetTransform()->GetWorldPosition(), GetTransform()->GetWorldRotation());
+	ServiceLocator::GetPhysics().Get(GetTransform())->SetTransform(GetTransform()->GetWorldPosition(), GetTransform()->GetWorldRotation());
 
 	ApplyShapes(GetGameObject());
+
+	GetTransform()->OnPositionChanged.AddListener(this);
+	GetTransform()->OnRotationChanged.AddListener(this);
 }
 
 void leap::Rigidbody::OnDestroy()
 {
+	GetTransform()->OnPositionChanged.RemoveListener(this);
+	GetTransform()->OnRotationChanged.RemoveListener(this);
+
 	// Remove the rigidbody
-	ServiceLocator::GetPhysics().Get(GetGameObject())->SetRigidbody(false);
+	ServiceLocator::GetPhysics().Get(GetTransform())->SetRigidbody(false);
+}
+
+void leap::Rigidbody::Notify()
+{
+	// The transform of a dynamic rigidbody is written by the physics engine
+	if (!IsKinematic()) return;
+
+	ServiceLocator::GetPhysics().Get(GetTransform())->SetTransform(GetTransform()->GetWorldPosition(), GetTransform()->GetWorldRotation());
 }
 
 void leap::Rigidbody::CheckExistence()
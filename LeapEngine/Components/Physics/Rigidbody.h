@@ -11,9 +11,11 @@
 
 #include <Data/ForceMode.h>
 
+#include <Observer.h>
+
 namespace leap
 {
-	class Rigidbody final : public Component
+	class Rigidbody final : public Component, public Observer
 	{
 	public:
 		Rigidbody() = default;
@@ -59,6 +61,9 @@ namespace leap
 		virtual void Awake() override;
 		virtual void OnDestroy() override;
 
+		// A kinematic rigidbody follows its transform
+		virtual void Notify() override;
+
 		void CheckExistence();
 		void ApplyShapes(GameObject* pParent) const;
 
@@ -26,7 +26,7 @@ void leap::SphereCollider::SetupShape(physics::IPhysicsMaterial* pMaterial)
 void leap::SphereCollider::RescaleShape()
 {
 	// Apply radius
-	const auto& scale{ GetTransform()->GetWorldScale() };
+	const glm::vec3 scale{ GetTransform()->GetWorldScale() };
 	const float transformSize{ std::max(scale.x, std::max(scale.y, scale.z)) };
 	m_pShape->SetRadius(m_Radius * transformSize);
 }
\ No newline at end of file
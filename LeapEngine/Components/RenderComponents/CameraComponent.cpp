@@ -39,6 +39,12 @@ void leap::CameraComponent::Awake()
 	UpdateTransform();
 }
 
+void leap::CameraComponent::LateUpdate()
+{
+	// An interpolated camera moves every frame, even when its transform didn't change
+	if (GetTransform()->IsInterpolated()) UpdateTransform();
+}
+
 void leap::CameraComponent::OnDestroy()
 {
 	GameContext::GetInstance().GetWindow()->RemoveListener(this);
@@ -59,6 +65,17 @@ void leap::CameraComponent::UpdateTransform() const
 
 	// Update internal camera data with transform
 	Transform* pTransform{ GetTransform() };
+
+	if (pTransform->IsInterpolated())
+	{
+		const glm::vec3 forward{ pTransform->GetRenderRotation() * Vector3::Forward() };
+		const glm::vec3 right{ glm::normalize(glm::cross(Vector3::Up(), forward)) };
+		const glm::vec3 up{ glm::cross(forward, right) };
+
+		m_pCamera->SetTransform({ right, up, forward, pTransform->GetRenderPosition() });
+		return;
+	}
+
 	m_pCamera->SetTransform(
 		{
 			pTransform->GetRight(),
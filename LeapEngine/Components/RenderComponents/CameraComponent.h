@@ -31,6 +31,7 @@ namespace leap
 
 	private:
 		virtual void Awake() override;
+		virtual void LateUpdate() override;
 		virtual void OnDestroy() override;
 		virtual void Notify() override;
 
@@ -36,7 +36,7 @@ leap::graphics::IMaterial* leap::MeshRendererComponent::GetMaterial() const
 
 void leap::MeshRendererComponent::LateUpdate()
 {
-	m_pRenderer->SetTransform(GetTransform()->GetWorldTransform());
+	m_pRenderer->SetTransform(GetTransform()->GetRenderTransform());
 }
 
 void leap::MeshRendererComponent::OnDestroy()
@@ -20,6 +20,9 @@ void leap::CanvasActions::Add(ICanvasElement* pElement)
 void leap::CanvasActions::Remove(ICanvasElement* pElement)
 {
 	m_pElements.erase(std::remove(begin(m_pElements), end(m_pElements), pElement));
+
+	// An element that is removed while it is being clicked doesn't get the rest of the click
+	if (m_pClickingElement == pElement) m_pClickingElement = nullptr;
 }
 
 void leap::CanvasActions::Awake()
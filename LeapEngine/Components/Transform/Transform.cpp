@@ -1,18 +1,24 @@
 #include "Transform.h"
 
 #include "../../SceneGraph/GameObject.h"
+#include "../../Jobs/JobSystem.h"
 
 #include <Quaternion.h>
 
+leap::Transform::~Transform()
+{
+	if (m_pHierarchy) m_pHierarchy->Remove(this);
+}
+
 #pragma region WorldTransform
 void leap::Transform::SetWorldPosition(const glm::vec3& position)
 {
 	Transform* pParent{ GetGameObject()->GetParent()->GetTransform() };
 
 	// Retrieve the transformation of the parent
-	const glm::vec3& parentWorldPosition{ pParent->GetWorldPosition() };
-	const glm::quat& parentWorldRotation{ pParent->GetWorldRotation() };
-	const glm::vec3& parentWorldScale{ pParent->GetWorldScale() };
+	const glm::vec3 parentWorldPosition{ pParent->GetWorldPosition() };
+	const glm::quat parentWorldRotation{ pParent->GetWorldRotation() };
+	const glm::vec3 parentWorldScale{ pParent->GetWorldScale() };
 
 	// Calculate the inverse transformation of the parent
 	const glm::quat& invParentWorldRotation{ glm::conjugate(parentWorldRotation) };
@@ -20,7 +26,7 @@ void leap::Transform::SetWorldPosition(const glm::vec3& position)
 
 	// Apply the inverse transformation to the desired world position
 	const glm::vec3& invParentLocalPosition{ invParentWorldRotation* (position - parentWorldPosition) };
-	m_LocalPosition = invParentLocalPosition * invParentWorldScale;
+	LocalPosition() = invParentLocalPosition * invParentWorldScale;
 
 	SetDirty(DirtyFlags::Translation);
 }
@@ -45,14 +51,14 @@ void leap::Transform::SetWorldRotation(const glm::quat& rotation)
 	Transform* pParent{ GetGameObject()->GetParent()->GetTransform() };
 
 	// Retrieve the transformation of the parent
-	const glm::quat& parentWorldRotation{ pParent->GetWorldRotation() };
+	const glm::quat parentWorldRotation{ pParent->GetWorldRotation() };
 
 	// Calculate the inverse transformation of the parent
 	const glm::quat& invParentWorldRotation{ glm::conjugate(parentWorldRotation) };
 
 	// Apply the inverse transformation to the desired world position
-	m_LocalRotation = invParentWorldRotation * rotation;
-	m_LocalRotationEuler = Quaternion::ToEuler(m_LocalRotation);
+	LocalRotation() = invParentWorldRotation * rotation;
+	m_LocalRotationEuler = Quaternion::ToEuler(LocalRotation());
 
 	SetDirty(DirtyFlags::Rotation);
 	SetDirty(DirtyFlags::DirectionVectors);
@@ -68,15 +74,15 @@ void leap::Transform::SetWorldScale(float x, float y, float z)
 	Transform* pParent{ GetGameObject()->GetParent()->GetTransform() };
 
 	// Retrieve the transformation of the parent
-	const glm::vec3& parentWorldScale{ pParent->GetWorldScale() };
+	const glm::vec3 parentWorldScale{ pParent->GetWorldScale() };
 
 	// Calculate the inverse transformation of the parent
 	const glm::vec3& invParentWorldScale{ 1.0f / parentWorldScale.x, 1.0f / parentWorldScale.y, 1.0f / parentWorldScale.z };
 
 	// Apply the inverse transformation to the desired world position
-	m_LocalScale.x = invParentWorldScale.x * x;
-	m_LocalScale.y = invParentWorldScale.y * y;
-	m_LocalScale.z = invParentWorldScale.z * z;
+	LocalScale().x = invParentWorldScale.x * x;
+	LocalScale().y = invParentWorldScale.y * y;
+	LocalScale().z = invParentWorldScale.z * z;
 
 	SetDirty(DirtyFlags::Scale);
 }
@@ -90,23 +96,23 @@ void leap::Transform::SetWorldScale(float scale)
 #pragma region LocalTransform
 void leap::Transform::SetLocalPosition(const glm::vec3& position)
 {
-	m_LocalPosition = position;
+	LocalPosition() = position;
 
 	SetDirty(DirtyFlags::Translation);
 }
 
 void leap::Transform::SetLocalPosition(float x, float y, float z)
 {
-	m_LocalPosition.x = x;
-	m_LocalPosition.y = y;
-	m_LocalPosition.z = z;
+	LocalPosition().x = x;
+	LocalPosition().y = y;
+	LocalPosition().z = z;
 
 	SetDirty(DirtyFlags::Translation);
 }
 
 void leap::Transform::SetLocalRotation(const glm::vec3& rotation, bool degrees)
 {
-	m_LocalRotation = Quaternion::FromEuler(rotation, degrees);
+	LocalRotation() = Quaternion::FromEuler(rotation, degrees);
 	m_LocalRotationEuler = degrees ? glm::radians(rotation) : rotation;
 
 	SetDirty(DirtyFlags::Rotation);
@@ -120,8 +126,8 @@ void leap::Transform::SetLocalRotation(float x, float y, float z, bool degrees)
 
 void leap::Transform::SetLocalRotation(const glm::quat& rotation)
 {
-	m_LocalRotation = rotation;
-	m_LocalRotationEuler = Quaternion::ToEuler(m_LocalRotation);
+	LocalRotation() = rotation;
+	m_LocalRotationEuler = Quaternion::ToEuler(LocalRotation());
 
 	SetDirty(DirtyFlags::Rotation);
 	SetDirty(DirtyFlags::DirectionVectors);
@@ -129,25 +135,25 @@ void leap::Transform::SetLocalRotation(const glm::quat& rotation)
 
 void leap::Transform::SetLocalScale(const glm::vec3& scale)
 {
-	m_LocalScale = scale;
+	LocalScale() = scale;
 
 	SetDirty(DirtyFlags::Scale);
 }
 
 void leap::Transform::SetLocalScale(float x, float y, float z)
 {
-	m_LocalScale.x = x;
-	m_LocalScale.y = y;
-	m_LocalScale.z = z;
+	LocalScale().x = x;
+	LocalScale().y = y;
+	LocalScale().z = z;
 
 	SetDirty(DirtyFlags::Scale);
 }
 
 void leap::Transform::SetLocalScale(float scale)
 {
-	m_LocalScale.x = scale;
-	m_LocalScale.y = scale;
-	m_LocalScale.z = scale;
+	LocalScale().x = scale;
+	LocalScale().y = scale;
+	LocalScale().z = scale;
 
 	SetDirty(DirtyFlags::Scale);
 }
@@ -156,16 +162,16 @@ void leap::Transform::SetLocalScale(float scale)
 #pragma region RelativeTransform
 void leap::Transform::Translate(const glm::vec3& positionDelta)
 {
-	m_LocalPosition += positionDelta;
+	LocalPosition() += positionDelta;
 
 	SetDirty(DirtyFlags::Translation);
 }
 
 void leap::Transform::Translate(float xDelta, float yDelta, float zDelta)
 {
-	m_LocalPosition.x += xDelta;
-	m_LocalPosition.y += yDelta;
-	m_LocalPosition.z += zDelta;
+	LocalPosition().x += xDelta;
+	LocalPosition().y += yDelta;
+	LocalPosition().z += zDelta;
 
 	SetDirty(DirtyFlags::Translation);
 }
@@ -182,8 +188,8 @@ void leap::Transform::Rotate(float xDelta, float yDelta, float zDelta, bool degr
 
 void leap::Transform::Rotate(const glm::quat& rotationDelta)
 {
-	m_LocalRotation = rotationDelta * m_LocalRotation;
-	m_LocalRotationEuler = Quaternion::ToEuler(m_LocalRotation);
+	LocalRotation() = rotationDelta * LocalRotation();
+	m_LocalRotationEuler = Quaternion::ToEuler(LocalRotation());
 
 	SetDirty(DirtyFlags::Rotation);
 	SetDirty(DirtyFlags::DirectionVectors);
@@ -191,74 +197,82 @@ void leap::Transform::Rotate(const glm::quat& rotationDelta)
 
 void leap::Transform::Scale(const glm::vec3& scaleDelta)
 {
-	m_LocalScale *= scaleDelta;
+	LocalScale() *= scaleDelta;
 
 	SetDirty(DirtyFlags::Scale);
 }
 
 void leap::Transform::Scale(float xDelta, float yDelta, float zDelta)
 {
-	m_LocalScale.x *= xDelta;
-	m_LocalScale.y *= yDelta;
-	m_LocalScale.z *= zDelta;
+	LocalScale().x *= xDelta;
+	LocalScale().y *= yDelta;
+	LocalScale().z *= zDelta;
 
 	SetDirty(DirtyFlags::Scale);
 }
 
 void leap::Transform::Scale(float scaleDelta)
 {
-	m_LocalScale.x *= scaleDelta;
-	m_LocalScale.y *= scaleDelta;
-	m_LocalScale.z *= scaleDelta;
+	LocalScale().x *= scaleDelta;
+	LocalScale().y *= scaleDelta;
+	LocalScale().z *= scaleDelta;
 
 	SetDirty(DirtyFlags::Scale);
 }
 #pragma endregion
 
 #pragma region Getters
-const glm::vec3& leap::Transform::GetWorldPosition()
+glm::vec3 leap::Transform::GetWorldPosition()
 {
-	if (IsDirty(DirtyFlags::Translation)) UpdateTranslation();
+	if (!IsDirty(DirtyFlags::Translation)) return WorldPosition();
+	if (JobSystem::IsExecutingJob()) return CalculateWorldPosition();
 
-	return m_WorldPosition;
+	UpdateTranslation();
+	return WorldPosition();
 }
 
-const glm::quat& leap::Transform::GetWorldRotation()
+glm::quat leap::Transform::GetWorldRotation()
 {
-	if (IsDirty(DirtyFlags::Rotation)) UpdateRotation();
+	if (!IsDirty(DirtyFlags::Rotation)) return WorldRotation();
+	if (JobSystem::IsExecutingJob()) return CalculateWorldRotation();
 
-	return m_WorldRotation;
+	UpdateRotation();
+	return WorldRotation();
 }
 
-const glm::vec3& leap::Transform::GetWorldEulerRotation()
+glm::vec3 leap::Transform::GetWorldEulerRotation()
 {
-	if (IsDirty(DirtyFlags::Rotation)) UpdateRotation();
+	if (!IsDirty(DirtyFlags::EulerRotation)) return m_WorldRotationEuler;
+	if (JobSystem::IsExecutingJob()) return Quaternion::ToEuler(GetWorldRotation());
+
+	m_WorldRotationEuler = Quaternion::ToEuler(GetWorldRotation());
+	m_pHierarchy->ClearDirty(m_HierarchyIndex, DirtyFlags::EulerRotation);
 
 	return m_WorldRotationEuler;
 }
 
 glm::vec3 leap::Transform::GetWorldEulerDegrees()
 {
-	if (IsDirty(DirtyFlags::Rotation)) UpdateRotation();
-
-	return glm::degrees(m_WorldRotationEuler);
+	return glm::degrees(GetWorldEulerRotation());
 }
 
-const glm::vec3& leap::Transform::GetWorldScale()
+glm::vec3 leap::Transform::GetWorldScale()
 {
-	if (IsDirty(DirtyFlags::Scale)) UpdateScale();
+	if (!IsDirty(DirtyFlags::Scale)) return WorldScale();
+	if (JobSystem::IsExecutingJob()) return CalculateWorldScale();
 
-	return m_WorldScale;
+	UpdateScale();
+	return WorldScale();
 }
 
-const glm::vec3& leap::Transform::GetLocalPosition() const
+glm::vec3 leap::Transform::GetLocalPosition() const
 {
-	return m_LocalPosition;
+	return LocalPosition();
 }
 
-const glm::quat& leap::Transform::GetLocalRotation() const
+glm::quat leap::Transform::GetLocalRotation() const
 {
-	return m_LocalRotation;
+	return LocalRotation();
 }
 
 const glm::vec3& leap::Transform::GetLocalEulerRotation() const
@@ -271,158 +285,213 @@ glm::vec3 leap::Transform::GetLocalEulerDegrees() const
 	return glm::degrees(m_LocalRotationEuler);
 }
 
-const glm::vec3& leap::Transform::GetLocalScale() const
+glm::vec3 leap::Transform::GetLocalScale() const
 {
-	return m_LocalScale;
+	return LocalScale();
 }
 
 glm::mat4x4 leap::Transform::GetWorldTransform()
 {
-	glm::mat4x4 worldTransform{ 1.0f };
+	glm::mat4x4& worldTransform{ m_pHierarchy->m_WorldMatrices[m_HierarchyIndex] };
+	if (!IsDirty(DirtyFlags::WorldMatrix)) return worldTransform;
 
-	worldTransform = glm::translate(worldTransform, GetWorldPosition());
-	
-	glm::mat4x4 rotationMatrix{ glm::mat4_cast(GetWorldRotation()) };
-	worldTransform = worldTransform * rotationMatrix;
+	if (JobSystem::IsExecutingJob())
+	{
+		glm::mat4x4 calculatedTransform{};
+		TransformHierarchy::CalculateWorldMatrix(GetWorldPosition(), GetWorldRotation(), GetWorldScale(), calculatedTransform);
+		return calculatedTransform;
+	}
 
-	worldTransform = glm::scale(worldTransform, GetWorldScale());
+	TransformHierarchy::CalculateWorldMatrix(GetWorldPosition(), GetWorldRotation(), GetWorldScale(), worldTransform);
+	m_pHierarchy->ClearDirty(m_HierarchyIndex, DirtyFlags::WorldMatrix);
 
 	return worldTransform;
 }
 
-glm::mat4x4 leap::Transform::GetLocalTransform() const
+void leap::Transform::SetSimulatedWorldPose(const glm::vec3& position, const glm::quat& rotation)
 {
-	glm::mat4x4 worldTransform{};
+	m_pHierarchy->SetInterpolated(this);
 
-	glm::translate(worldTransform, m_LocalPosition);
+	SetWorldPosition(position);
+	SetWorldRotation(rotation);
+}
 
-	glm::mat4x4 rotationMatrix{ glm::mat4_cast(m_LocalRotation) };
-	worldTransform = worldTransform * rotationMatrix;
+bool leap::Transform::IsInterpolated() const
+{
+	return m_pHierarchy->m_InterpolationFlags[m_HierarchyIndex] & static_cast<uint8_t>(TransformHierarchy::InterpolationFlags::UsesRenderTransform);
+}
 
-	worldTransform = glm::scale(worldTransform, m_LocalScale);
+glm::mat4x4 leap::Transform::GetRenderTransform()
+{
+	if (!IsInterpolated()) return GetWorldTransform();
 
-	return worldTransform;
+	return m_pHierarchy->m_RenderMatrices[m_HierarchyIndex];
 }
 
-const glm::vec3& leap::Transform::GetForward()
+glm::vec3 leap::Transform::GetRenderPosition()
 {
-	if (IsDirty(DirtyFlags::DirectionVectors)) UpdateDirectionVectors();
+	if (!IsInterpolated()) return GetWorldPosition();
+
+	return m_pHierarchy->m_RenderPositions[m_HierarchyIndex];
+}
 
+glm::quat leap::Transform::GetRenderRotation()
+{
+	if (!IsInterpolated()) return GetWorldRotation();
+
+	return m_pHierarchy->m_RenderRotations[m_HierarchyIndex];
+}
+
+glm::mat4x4 leap::Transform::GetLocalTransform() const
+{
+	glm::mat4x4 localTransform{};
+
+	TransformHierarchy::CalculateWorldMatrix(LocalPosition(), LocalRotation(), LocalScale(), localTransform);
+
+	return localTransform;
+}
+
+glm::vec3 leap::Transform::GetForward()
+{
+	if (!IsDirty(DirtyFlags::DirectionVectors)) return m_Forward;
+	if (JobSystem::IsExecutingJob()) return CalculateDirectionVectors().forward;
+
+	UpdateDirectionVectors();
 	return m_Forward;
 }
-const glm::vec3& leap::Transform::GetUp()
+glm::vec3 leap::Transform::GetUp()
 {
-	if (IsDirty(DirtyFlags::DirectionVectors)) UpdateDirectionVectors();
+	if (!IsDirty(DirtyFlags::DirectionVectors)) return m_Up;
+	if (JobSystem::IsExecutingJob()) return CalculateDirectionVectors().up;
 
+	UpdateDirectionVectors();
 	return m_Up;
 }
-const glm::vec3& leap::Transform::GetRight()
+glm::vec3 leap::Transform::GetRight()
 {
-	if (IsDirty(DirtyFlags::DirectionVectors)) UpdateDirectionVectors();
+	if (!IsDirty(DirtyFlags::DirectionVectors)) return m_Right;
+	if (JobSystem::IsExecutingJob()) return CalculateDirectionVectors().right;
 
+	UpdateDirectionVectors();
 	return m_Right;
 }
 #pragma endregion
 
-void leap::Transform::UpdateTranslation()
+glm::vec3 leap::Transform::CalculateWorldPosition()
 {
 	GameObject* pParentObj{ GetGameObject()->GetParent() };
 
 	// The root gameobject cannot be moved
-	if (!pParentObj) return;
+	if (!pParentObj) return WorldPosition();
 
 	Transform* pParent{ pParentObj->GetTransform() };
 
 	// Retrieve the transformation of the parent
-	const glm::vec3& parentWorldPosition{ pParent->GetWorldPosition() };
-	const glm::quat& parentWorldRotation{ pParent->GetWorldRotation() };
-	const glm::vec3& parentWorldScale{ pParent->GetWorldScale() };
+	const glm::vec3 parentWorldPosition{ pParent->GetWorldPosition() };
+	const glm::quat parentWorldRotation{ pParent->GetWorldRotation() };
+	const glm::vec3 parentWorldScale{ pParent->GetWorldScale() };
 
 	// Calculate world position
-	m_WorldPosition = parentWorldPosition + (parentWorldRotation * (parentWorldScale * m_LocalPosition));
-
-	// Disable the translation dirty flag
-	m_IsDirty &= ~static_cast<unsigned int>(DirtyFlags::Translation);
+	return parentWorldPosition + (parentWorldRotation * (parentWorldScale * LocalPosition()));
 }
 
-void leap::Transform::UpdateRotation()
+glm::quat leap::Transform::CalculateWorldRotation()
 {
 	GameObject* pParentObj{ GetGameObject()->GetParent() };
 
 	// The root gameobject cannot be moved
-	if (!pParentObj) return;
-
-	Transform* pParent{ pParentObj->GetTransform() };
-
-	// Retrieve the transformation of the parent
-	const glm::quat& parentWorldRotation{ pParent->GetWorldRotation() };
+	if (!pParentObj) return WorldRotation();
 
 	// Calculate world rotation
-	m_WorldRotation = parentWorldRotation * m_LocalRotation;
-	m_WorldRotationEuler = Quaternion::ToEuler(m_WorldRotation);
-
-	// Disable the rotation dirty flag
-	m_IsDirty &= ~static_cast<unsigned int>(DirtyFlags::Rotation);
+	return pParentObj->GetTransform()->GetWorldRotation() * LocalRotation();
 }
 
-void leap::Transform::UpdateScale()
+glm::vec3 leap::Transform::CalculateWorldScale()
 {
 	GameObject* pParentObj{ GetGameObject()->GetParent() };
 
 	// The root gameobject cannot be moved
-	if (!pParentObj) return;
+	if (!pParentObj) return WorldScale();
 
-	Transform* pParent{ pParentObj->GetTransform() };
+	// Calculate world scale
+	return pParentObj->GetTransform()->GetWorldScale() * LocalScale();
+}
 
-	// Retrieve the transformation of the parent
-	const glm::vec3& parentWorldScale{ pParent->GetWorldScale() };
+leap::Transform::DirectionVectors leap::Transform::CalculateDirectionVectors()
+{
+	DirectionVectors directions{};
+	directions.forward = GetWorldRotation() * Vector3::Forward();
+	directions.right = glm::normalize(glm::cross(Vector3::Up(), directions.forward));
+	directions.up = glm::cross(directions.forward, directions.right);
 
-	// Calculate world scale
-	m_WorldScale = parentWorldScale * m_LocalScale;
+	return directions;
+}
+
+void leap::Transform::UpdateTranslation()
+{
+	WorldPosition() = CalculateWorldPosition();
+
+	// Disable the translation dirty flag
+	m_pHierarchy->ClearDirty(m_HierarchyIndex, DirtyFlags::Translation);
+}
+
+void leap::Transform::UpdateRotation()
+{
+	WorldRotation() = CalculateWorldRotation();
+
+	// Disable the rotation dirty flag
+	m_pHierarchy->ClearDirty(m_HierarchyIndex, DirtyFlags::Rotation);
+}
+
+void leap::Transform::UpdateScale()
+{
+	WorldScale() = CalculateWorldScale();
 
 	// Disable the scale dirty flag
-	m_IsDirty &= ~static_cast<unsigned int>(DirtyFlags::Scale);
+	m_pHierarchy->ClearDirty(m_HierarchyIndex, DirtyFlags::Scale);
 }
 
 void leap::Transform::UpdateDirectionVectors()
 {
-	// Calculate direction vectors
-	m_Forward = GetWorldRotation() * Vector3::Forward();
-	m_Right = glm::normalize(glm::cross(Vector3::Up(), m_Forward));
-	m_Up = glm::cross(m_Forward, m_Right);
+	const DirectionVectors directions{ CalculateDirectionVectors() };
+	m_Forward = directions.forward;
+	m_Right = directions.right;
+	m_Up = directions.up;
 
 	// Disable the direction dirty flag
-	m_IsDirty &= ~static_cast<unsigned int>(DirtyFlags::DirectionVectors);
+	m_pHierarchy->ClearDirty(m_HierarchyIndex, DirtyFlags::DirectionVectors);
 }
 
 bool leap::Transform::IsDirty(DirtyFlags flag) const
 {
-	return static_cast<bool>(m_IsDirty & static_cast<unsigned int>(flag));
+	return m_pHierarchy->IsDirty(m_HierarchyIndex, flag);
 }
 
 void leap::Transform::SetDirty(DirtyFlags flag)
 {
-	m_IsDirty |= static_cast<unsigned int>(flag);
+	m_pHierarchy->SetDirty(m_HierarchyIndex, flag);
 
-	for (int i = 0; i < GetGameObject()->GetChildCount(); ++i)
-	{
-		Transform* pChild{ GetGameObject()->GetChild(i)->GetTransform() };
-		pChild->SetDirty(DirtyFlags::Rotation);
-		pChild->SetDirty(DirtyFlags::Scale);
-		pChild->SetDirty(DirtyFlags::Translation);
-		pChild->SetDirty(DirtyFlags::DirectionVectors);
-	}
+	// The direction vectors only depend on the rotation, which already handled the rest
+	if (flag == DirtyFlags::DirectionVectors) return;
+
+	m_pHierarchy->SetDirty(m_HierarchyIndex, DirtyFlags::WorldMatrix);
+	if (flag == DirtyFlags::Rotation) m_pHierarchy->SetDirty(m_HierarchyIndex, DirtyFlags::EulerRotation);
 
+	m_pHierarchy->SetDescendantsDirty(this);
+
+	// The listeners get notified once at the end of the phase
 	switch (flag)
 	{
 	case DirtyFlags::Translation:
-		OnPositionChanged.Notify();
+		m_pHierarchy->QueueChange(this, TransformHierarchy::ChangeFlags::Position);
 		break;
 	case DirtyFlags::Rotation:
-		OnRotationChanged.Notify();
+		m_pHierarchy->QueueChange(this, TransformHierarchy::ChangeFlags::Rotation);
 		break;
 	case DirtyFlags::Scale:
-		OnScaleChanged.Notify();
+		m_pHierarchy->QueueChange(this, TransformHierarchy::ChangeFlags::Scale);
+		break;
+	default:
 		break;
 	}
 }
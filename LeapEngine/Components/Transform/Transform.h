@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../Component.h"
+#include "../../SceneGraph/TransformHierarchy.h"
 
 #include "vec3.hpp"
 #include "vec2.hpp"
@@ -18,7 +19,7 @@ namespace leap
 	{
 	public:
 		Transform() = default;
-		virtual ~Transform() = default;
+		virtual ~Transform();
 
 		Transform(const Transform& other) = delete;
 		Transform(Transform&& other) = delete;
@@ -52,41 +53,80 @@ namespace leap
 		void Scale(float xDelta, float yDelta, float zDelta);
 		void Scale(float scaleDelta);
 
-		const glm::vec3& GetWorldPosition();
-		const glm::quat& GetWorldRotation();
-		const glm::vec3& GetWorldEulerRotation();
+		/// <summary>
+		/// The position, rotation, scale and matrices are stored in the TransformHierarchy of the scene and are returned by value,
+		///		a reference would dangle when the hierarchy grows or reorders its storage
+		/// The world values are cached and updated when they are requested while dirty,
+		///		in a job a dirty value is calculated without updating the cache so parallel Updates only read from the scene
+		/// </summary>
+		glm::vec3 GetWorldPosition();
+		glm::quat GetWorldRotation();
+		glm::vec3 GetWorldEulerRotation();
 		glm::vec3 GetWorldEulerDegrees();
-		const glm::vec3& GetWorldScale();
+		glm::vec3 GetWorldScale();
 
-		const glm::vec3& GetLocalPosition() const;
-		const glm::quat& GetLocalRotation() const;
+		glm::vec3 GetLocalPosition() const;
+		glm::quat GetLocalRotation() const;
 		const glm::vec3& GetLocalEulerRotation() const;
 		glm::vec3 GetLocalEulerDegrees() const;
-		const glm::vec3& GetLocalScale() const;
+		glm::vec3 GetLocalScale() const;
 
+		/// <summary>
+		/// The world matrix is cached, it is recalculated for all dirty transforms of the scene at once before LateUpdate
+		///		or when it is requested while dirty
+		/// </summary>
 		glm::mat4x4 GetWorldTransform();
 		glm::mat4x4 GetLocalTransform() const;
 
-		const glm::vec3& GetForward();
-		const glm::vec3& GetUp();
-		const glm::vec3& GetRight();
+		/// <summary>
+		/// Sets the world pose that was calculated by a fixed step (e.g. by physics)
+		/// The transform is rendered interpolated between the pose of the previous fixed step and this pose
+		/// </summary>
+		void SetSimulatedWorldPose(const glm::vec3& position, const glm::quat& rotation);
+		bool IsInterpolated() const;
+
+		/// <summary>
+		/// The transform that should be used for rendering, this is the interpolated transform when this transform
+		///		or one of its parents is moved by fixed steps, otherwise it's the world transform
+		/// The render transform is updated before LateUpdate
+		/// </summary>
+		glm::mat4x4 GetRenderTransform();
+		glm::vec3 GetRenderPosition();
+		glm::quat GetRenderRotation();
+
+		glm::vec3 GetForward();
+		glm::vec3 GetUp();
+		glm::vec3 GetRight();
 
 		void KeepWorldTransform(GameObject* pParent);
 
+		/// <summary>
+		/// Notified at most once per phase when the world position, rotation or scale changed, also when it was caused by a parent
+		/// </summary>
 		Subject OnPositionChanged{};
 		Subject OnRotationChanged{};
 		Subject OnScaleChanged{};
 
 	private:
-		enum class DirtyFlags
+		friend TransformHierarchy;
+
+		using DirtyFlags = TransformHierarchy::DirtyFlags;
+
+		struct DirectionVectors final
 		{
-			None = 0,
-			Translation = 1,
-			Rotation = 2,
-			Scale = 4,
-			DirectionVectors = 8
+			glm::vec3 forward;
+			glm::vec3 up;
+			glm::vec3 right;
 		};
 
+		/// <summary>
+		/// The Calculate functions return the world value from the parent without writing to the hierarchy,
+		///		the Update functions store it in the hierarchy and clear its dirty flag
+		/// </summary>
+		glm::vec3 CalculateWorldPosition();
+		glm::quat CalculateWorldRotation();
+		glm::vec3 CalculateWorldScale();
+		DirectionVectors CalculateDirectionVectors();
 		void UpdateTranslation();
 		void UpdateRotation();
 		void UpdateScale();
@@ -94,21 +134,24 @@ namespace leap
 		bool IsDirty(DirtyFlags flag) const;
 		void SetDirty(DirtyFlags flag);
 
-		glm::vec3 m_LocalPosition{};
-		glm::vec3 m_WorldPosition{};
+		/// <summary>
+		/// The local and world transformation are stored in the transform hierarchy of the scene
+		/// </summary>
+		glm::vec3& LocalPosition() const { return m_pHierarchy->m_LocalPositions[m_HierarchyIndex]; }
+		glm::quat& LocalRotation() const { return m_pHierarchy->m_LocalRotations[m_HierarchyIndex]; }
+		glm::vec3& LocalScale() const { return m_pHierarchy->m_LocalScales[m_HierarchyIndex]; }
+		glm::vec3& WorldPosition() const { return m_pHierarchy->m_WorldPositions[m_HierarchyIndex]; }
+		glm::quat& WorldRotation() const { return m_pHierarchy->m_WorldRotations[m_HierarchyIndex]; }
+		glm::vec3& WorldScale() const { return m_pHierarchy->m_WorldScales[m_HierarchyIndex]; }
+
+		TransformHierarchy* m_pHierarchy{};
+		uint32_t m_HierarchyIndex{};
 
-		glm::quat m_LocalRotation{ Quaternion::Identity() };
 		glm::vec3 m_LocalRotationEuler{};
-		glm::quat m_WorldRotation{ Quaternion::Identity() };
 		glm::vec3 m_WorldRotationEuler{};
 
-		glm::vec3 m_LocalScale{ Vector3::One() };
-		glm::vec3 m_WorldScale{ Vector3::One() };
-
 		glm::vec3 m_Forward{ Vector3::Forward() };
 		glm::vec3 m_Up{ Vector3::Up() };
 		glm::vec3 m_Right{ Vector3::Right() };
-
-		unsigned int m_IsDirty{ static_cast<unsigned int>(DirtyFlags::Translation) | static_cast<unsigned int>(DirtyFlags::Rotation) | static_cast<unsigned int>(DirtyFlags::Scale) };
 	};
 }
\ No newline at end of file
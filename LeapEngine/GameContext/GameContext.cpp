@@ -2,6 +2,7 @@
 #include "Window.h"
 #include "Timer.h"
 #include "Logger/ILogger.h"
+#include "../Memory/MemoryReport.h"
 
 leap::GameContext::~GameContext()
 {
@@ -15,7 +16,7 @@ leap::GameContext::GameContext()
 void leap::GameContext::Update()
 {
 	m_pTimer->Update();
-	m_pWindow->Update();
+	if (m_pWindow) m_pWindow->Update();
 
 	for (const auto& logger : m_pLoggers)
 	{
@@ -29,6 +30,8 @@ void leap::GameContext::OnGUI()
 	{
 		logger->OnGUI();
 	}
+
+	if (m_IsMemoryReportEnabled) MemoryReport::OnGUI();
 }
 
 void leap::GameContext::CreateWindowWrapper(GLFWwindow* window)
@@ -24,6 +24,9 @@ namespace leap
 		Timer* GetTimer() const { return m_pTimer.get(); }
 		Window* GetWindow() const { return m_pWindow.get(); }
 
+		void SetMemoryReportEnabled(bool isEnabled) { m_IsMemoryReportEnabled = isEnabled; }
+		bool IsMemoryReportEnabled() const { return m_IsMemoryReportEnabled; }
+
 		template <class T>
 		T* AddLogger();
 		template <class T>
@@ -41,6 +44,8 @@ namespace leap
 		std::unique_ptr<Window> m_pWindow;
 
 		std::vector<std::unique_ptr<ILogger>> m_pLoggers{};
+
+		bool m_IsMemoryReportEnabled{};
 	};
 
 	template<class T>
@@ -1,5 +1,8 @@
 #include "ImGuiLogger.h"
 #include "ImGui/imgui.h"
+#include "../../Memory/FrameAllocator.h"
+#include "../../Memory/MemoryTracker.h"
+
 #include <sstream>
 
 leap::ImGuiLogger::ImGuiLogger()
@@ -74,7 +77,7 @@ void leap::ImGuiLogger::OnGUI()
 
     for (const auto& data : m_Logs[static_cast<int>(m_ActiveType)])
     {
-        std::stringstream ss{};
+        std::basic_stringstream<char, std::char_traits<char>, TFrameAllocator<char>> ss{};
         ss << data.Time << ' ' << data.Message << '\n';
         ss << "** " << data.Location.file_name() << " line " << data.Location.line() << ":" << data.Location.column() << '\n';
         ImGui::Text(ss.str().c_str());
@@ -87,6 +90,9 @@ void leap::ImGuiLogger::OnGUI()
 
 void leap::ImGuiLogger::Notify(const Debug::LogInfo& message)
 {
+    // Logs can be sent from anywhere, but the memory they keep belongs to the logger
+    MemoryTagScope tag{ MemoryTag::Logging };
+
     LogInfo log{};
     log.Message = std::string{ message.Message };
     log.Time = std::string{ message.Time };
@@ -4,6 +4,7 @@
 namespace leap
 {
 	class GameContext;
+	class LeapEngine;
 	class Timer final
 	{
 	public:
@@ -19,12 +20,28 @@ namespace leap
 		void SetFixedTime(float value) { m_FixedTime = value; }
 		void SetMaxDelta(float value) { m_MaxDelta = value; }
 
+		/// <summary>
+		/// The amount of fixed steps a single frame can run, time that doesn't fit in these steps is dropped
+		/// This keeps a slow frame from making the next frame even slower
+		/// </summary>
+		void SetMaxFixedSteps(unsigned int value) { m_MaxFixedSteps = value; }
+		unsigned int GetMaxFixedSteps() const { return m_MaxFixedSteps; }
+
+		/// <summary>
+		/// How far the current frame is between the last fixed step and the next one, in the range [0, 1)
+		/// Rendering uses this to interpolate between the previous and the current pose of a fixed step
+		/// </summary>
+		float GetFixedTimeAlpha() const { return m_FixedTimeAlpha; }
+
 	private:
 		friend GameContext;
+		friend LeapEngine;
 		void Update();
 
 		float m_FixedTime{ 0.02f };
 		float m_MaxDelta{ 0.33f };
+		unsigned int m_MaxFixedSteps{ 5 };
+		float m_FixedTimeAlpha{};
 		float m_DeltaTime{};
 		std::chrono::time_point<std::chrono::steady_clock> m_End{};
 	};
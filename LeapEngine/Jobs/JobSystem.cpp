@@ -0,0 +1,227 @@
+#include "JobSystem.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace leap
+{
+	// The job system the calling thread is a worker of and the queue of that worker
+	static thread_local const JobSystem* g_pWorkerOwner{};
+	static thread_local uint32_t g_WorkerQueueIdx{};
+
+	// Jobs can wait on other jobs, so this is a depth instead of a flag
+	static thread_local uint32_t g_JobDepth{};
+	static thread_local uint64_t g_JobSequence{};
+
+	std::atomic<uint64_t> JobSystem::m_NrOfScheduledJobs{};
+
+	static void ApplyWorkerSettings(uint32_t workerIdx, const JobWorkerSettings& settings)
+	{
+		// Worker i gets hardware thread i + 1, the main thread keeps the first one
+		const unsigned int nrOfHardwareThreads{ std::thread::hardware_concurrency() };
+		const uint32_t hardwareThreadIdx{ nrOfHardwareThreads > 0 ? (workerIdx + 1) % nrOfHardwareThreads : 0 };
+
+#ifdef _WIN32
+		if (settings.isPinned && hardwareThreadIdx < sizeof(DWORD_PTR) * 8)
+		{
+			SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{ 1 } << hardwareThreadIdx);
+		}
+
+		switch (settings.priority)
+		{
+		case JobWorkerSettings::Priority::Low:
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+			break;
+		case JobWorkerSettings::Priority::High:
+			SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_ABOVE_NORMAL);
+			break;
+		default:
+			break;
+		}
+#else
+		if (settings.isPinned && hardwareThreadIdx < CPU_SETSIZE)
+		{
+			cpu_set_t cpuSet{};
+			CPU_ZERO(&cpuSet);
+			CPU_SET(hardwareThreadIdx, &cpuSet);
+			pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		}
+
+		// Thread priorities need a realtime scheduling policy on posix, the workers keep the default priority
+#endif
+	}
+
+	JobSystem::JobSystem(unsigned int nrOfWorkerThreads, const JobWorkerSettings& settings)
+	{
+		if (nrOfWorkerThreads == 0)
+		{
+			const unsigned int nrOfHardwareThreads{ std::thread::hardware_concurrency() };
+			nrOfWorkerThreads = nrOfHardwareThreads > 1 ? nrOfHardwareThreads - 1 : 0;
+		}
+
+		// Set up everything the workers use before they start
+		m_NrOfQueues = nrOfWorkerThreads + 1;
+		m_pQueues = std::make_unique<JobQueue[]>(m_NrOfQueues);
+
+		m_Workers.reserve(nrOfWorkerThreads);
+		for (uint32_t i{}; i < nrOfWorkerThreads; ++i)
+		{
+			m_Workers.emplace_back([this, i, settings]() { RunWorker(i, settings); });
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		{
+			const std::lock_guard lock{ m_SleepMutex };
+			m_IsStopping = true;
+		}
+		m_WakeCondition.notify_all();
+
+		for (std::thread& worker : m_Workers) worker.join();
+	}
+
+	void JobSystem::Schedule(const Job& scheduledJob)
+	{
+		Job job{ scheduledJob };
+		job.sequence = m_NrOfScheduledJobs.fetch_add(1, std::memory_order_relaxed) + 1;
+
+		if (job.pCounter) job.pCounter->m_NrOfJobs.fetch_add(1, std::memory_order_relaxed);
+
+		{
+			JobQueue& queue{ m_pQueues[GetQueueIndex()] };
+			std::unique_lock lock{ queue.mutex };
+
+			if (queue.nrOfJobs == m_QueueCapacity)
+			{
+				// The queue is full, do the work right away instead of allocating more space
+				lock.unlock();
+				Execute(job);
+				return;
+			}
+
+			queue.jobs[(queue.first + queue.nrOfJobs) % m_QueueCapacity] = job;
+			++queue.nrOfJobs;
+		}
+
+		m_NrOfQueuedJobs.fetch_add(1, std::memory_order_release);
+
+		// Take the sleep lock so a worker can't miss the wake up between checking for jobs and going to sleep
+		{
+			const std::lock_guard lock{ m_SleepMutex };
+		}
+		m_WakeCondition.notify_one();
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		const uint32_t queueIdx{ GetQueueIndex() };
+
+		while (!counter.IsDone())
+		{
+			if (!TryExecuteJob(queueIdx)) std::this_thread::yield();
+		}
+	}
+
+	bool JobSystem::IsExecutingJob()
+	{
+		return g_JobDepth > 0;
+	}
+
+	uint64_t JobSystem::GetCurrentJobSequence()
+	{
+		return g_JobSequence;
+	}
+
+	uint64_t JobSystem::GetNrOfScheduledJobs()
+	{
+		return m_NrOfScheduledJobs.load(std::memory_order_relaxed);
+	}
+
+	void JobSystem::RunWorker(uint32_t queueIdx, JobWorkerSettings settings)
+	{
+		g_pWorkerOwner = this;
+		g_WorkerQueueIdx = queueIdx;
+
+		ApplyWorkerSettings(queueIdx, settings);
+
+		while (true)
+		{
+			if (TryExecuteJob(queueIdx)) continue;
+
+			std::unique_lock lock{ m_SleepMutex };
+			m_WakeCondition.wait(lock, [this]() { return m_IsStopping || m_NrOfQueuedJobs.load(std::memory_order_acquire) > 0; });
+
+			if (m_IsStopping) return;
+		}
+	}
+
+	bool JobSystem::TryExecuteJob(uint32_t queueIdx)
+	{
+		Job job;
+		if (!TryPop(queueIdx, job) && !TrySteal(queueIdx, job)) return false;
+
+		m_NrOfQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		Execute(job);
+
+		return true;
+	}
+
+	bool JobSystem::TryPop(uint32_t queueIdx, Job& job)
+	{
+		JobQueue& queue{ m_pQueues[queueIdx] };
+		const std::lock_guard lock{ queue.mutex };
+
+		if (queue.nrOfJobs == 0) return false;
+
+		// Take the newest job, its data is most likely still in the cache
+		--queue.nrOfJobs;
+		job = queue.jobs[(queue.first + queue.nrOfJobs) % m_QueueCapacity];
+
+		return true;
+	}
+
+	bool JobSystem::TrySteal(uint32_t queueIdx, Job& job)
+	{
+		for (uint32_t offset{ 1 }; offset < m_NrOfQueues; ++offset)
+		{
+			JobQueue& queue{ m_pQueues[(queueIdx + offset) % m_NrOfQueues] };
+			const std::lock_guard lock{ queue.mutex };
+
+			if (queue.nrOfJobs == 0) continue;
+
+			// Take the oldest job, the owner of the queue keeps working on the newest ones
+			job = queue.jobs[queue.first];
+			queue.first = (queue.first + 1) % m_QueueCapacity;
+			--queue.nrOfJobs;
+
+			return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::Execute(const Job& job)
+	{
+		const uint64_t outerSequence{ g_JobSequence };
+
+		++g_JobDepth;
+		g_JobSequence = job.sequence;
+		job.pFunction(job.pData, job.begin, job.end);
+		g_JobSequence = outerSequence;
+		--g_JobDepth;
+
+		if (job.pCounter) job.pCounter->m_NrOfJobs.fetch_sub(1, std::memory_order_release);
+	}
+
+	uint32_t JobSystem::GetQueueIndex() const
+	{
+		return g_pWorkerOwner == this ? g_WorkerQueueIdx : m_NrOfQueues - 1;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace leap
+{
+	/// <summary>
+	/// Counts the jobs that still need to finish, a counter can be waited on with JobSystem::Wait
+	/// A counter needs to outlive the jobs it is passed to
+	/// </summary>
+	class JobCounter final
+	{
+	public:
+		JobCounter() = default;
+		~JobCounter() = default;
+
+		JobCounter(const JobCounter& other) = delete;
+		JobCounter(JobCounter&& other) = delete;
+		JobCounter& operator=(const JobCounter& other) = delete;
+		JobCounter& operator=(JobCounter&& other) = delete;
+
+		bool IsDone() const { return m_NrOfJobs.load(std::memory_order_acquire) == 0; }
+
+	private:
+		friend class JobSystem;
+
+		std::atomic<uint32_t> m_NrOfJobs{};
+	};
+
+	/// <summary>
+	/// A job calls pFunction with its data and the range [begin, end) it needs to handle
+	/// The sequence is filled in when the job gets scheduled
+	/// </summary>
+	struct Job final
+	{
+		void (*pFunction)(void* pData, uint32_t begin, uint32_t end);
+		void* pData;
+		uint32_t begin;
+		uint32_t end;
+		JobCounter* pCounter;
+		uint64_t sequence;
+	};
+
+	/// <summary>
+	/// Settings of the worker threads of a job system
+	/// A pinned worker only runs on its own hardware thread, worker i runs on hardware thread i + 1 so the main thread keeps hardware thread 0
+	/// </summary>
+	struct JobWorkerSettings final
+	{
+		enum class Priority
+		{
+			Low,
+			Normal,
+			High
+		};
+
+		bool isPinned{};
+		Priority priority{ Priority::Normal };
+	};
+
+	/// <summary>
+	/// JobSystem runs jobs on a fixed set of worker threads
+	/// Every worker has its own queue, it takes its newest job first and steals the oldest jobs of other queues when it runs empty
+	/// Jobs scheduled from other threads (e.g. the main thread) go to a shared queue
+	/// A thread waiting on a counter keeps executing jobs until the counter is done, so waiting inside a job doesn't deadlock
+	/// Scheduling doesn't allocate, a job is executed immediately if its queue is full
+	/// </summary>
+	class JobSystem final
+	{
+	public:
+		/// <summary>
+		/// Starts nrOfWorkerThreads worker threads, 0 uses one worker per hardware thread except for the calling thread
+		/// </summary>
+		explicit JobSystem(unsigned int nrOfWorkerThreads = 0, const JobWorkerSettings& settings = {});
+		~JobSystem();
+
+		JobSystem(const JobSystem& other) = delete;
+		JobSystem(JobSystem&& other) = delete;
+		JobSystem& operator=(const JobSystem& other) = delete;
+		JobSystem& operator=(JobSystem&& other) = delete;
+
+		void Schedule(const Job& job);
+		void Wait(const JobCounter& counter);
+
+		/// <summary>
+		/// Calls function(index) for every index in [0, nrOfElements) spread over the workers in batches of batchSize
+		/// Returns once every index is handled, the calling thread helps executing the batches
+		/// </summary>
+		template <class Function>
+		void ParallelFor(uint32_t nrOfElements, uint32_t batchSize, const Function& function);
+
+		/// <summary>
+		/// Returns the amount of threads that execute jobs, including the thread that waits on them
+		/// </summary>
+		unsigned int GetNrOfThreads() const { return m_NrOfQueues; }
+
+		/// <summary>
+		/// Returns true if the calling thread is currently executing a job
+		/// </summary>
+		static bool IsExecutingJob();
+
+		/// <summary>
+		/// Every scheduled job gets the next sequence number, jobs scheduled in a fixed order from one thread get the same numbers every run
+		/// GetCurrentJobSequence returns the sequence of the job the calling thread is executing, or 0 outside of a job
+		/// </summary>
+		static uint64_t GetCurrentJobSequence();
+		static uint64_t GetNrOfScheduledJobs();
+
+	private:
+		static constexpr uint32_t m_QueueCapacity{ 1024 };
+
+		struct alignas(64) JobQueue final
+		{
+			std::mutex mutex{};
+			std::array<Job, m_QueueCapacity> jobs{};
+			uint32_t first{};
+			uint32_t nrOfJobs{};
+		};
+
+		void RunWorker(uint32_t queueIdx, JobWorkerSettings settings);
+		bool TryExecuteJob(uint32_t queueIdx);
+		bool TryPop(uint32_t queueIdx, Job& job);
+		bool TrySteal(uint32_t queueIdx, Job& job);
+		void Execute(const Job& job);
+		uint32_t GetQueueIndex() const;
+
+		static std::atomic<uint64_t> m_NrOfScheduledJobs;
+
+		// One queue per worker, the last queue is shared by all threads that aren't workers
+		uint32_t m_NrOfQueues{};
+		std::unique_ptr<JobQueue[]> m_pQueues{};
+		std::vector<std::thread> m_Workers{};
+
+		std::mutex m_SleepMutex{};
+		std::condition_variable m_WakeCondition{};
+		std::atomic<uint32_t> m_NrOfQueuedJobs{};
+		bool m_IsStopping{};
+	};
+
+	template <class Function>
+	inline void JobSystem::ParallelFor(uint32_t nrOfElements, uint32_t batchSize, const Function& function)
+	{
+		if (batchSize == 0) batchSize = 1;
+
+		// Not worth spreading out
+		if (m_NrOfQueues == 1 || nrOfElements <= batchSize)
+		{
+			for (uint32_t i{}; i < nrOfElements; ++i) function(i);
+			return;
+		}
+
+		JobCounter counter{};
+
+		Job job
+		{
+			[](void* pData, uint32_t begin, uint32_t end)
+			{
+				const Function& function{ *static_cast<const Function*>(pData) };
+				for (uint32_t i{ begin }; i < end; ++i) function(i);
+			},
+			const_cast<void*>(static_cast<const void*>(&function)),
+			0, 0,
+			&counter,
+			0
+		};
+
+		for (uint32_t begin{}; begin < nrOfElements; begin += batchSize)
+		{
+			job.begin = begin;
+			job.end = nrOfElements - begin > batchSize ? begin + batchSize : nrOfElements;
+			Schedule(job);
+		}
+
+		Wait(counter);
+	}
+}
\ No newline at end of file
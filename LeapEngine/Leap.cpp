@@ -15,8 +15,17 @@
 #include "GameContext/Timer.h"
 #include "GameContext/Window.h"
 #include "SceneGraph/SceneManager.h"
+#include "SceneGraph/CommandBuffer.h"
 
 #include "Physics/PhysicsSync.h"
+#include "Physics/PhysicsTaskScheduler.h"
+
+#include "Memory/FrameAllocator.h"
+#include "Memory/MemoryTracker.h"
+
+#include <array>
+#include <climits>
+#include <sstream>
 
 leap::LeapEngine::LeapEngine(int width, int height, const char* title)
 {
@@ -44,13 +53,35 @@ leap::LeapEngine::LeapEngine(int width, int height, const char* title)
     GameContext::GetInstance().CreateWindowWrapper(m_pWindow);
 
     Debug::Log("LeapEngine Log: Registering default audio system (FMOD)");
-    ServiceLocator::RegisterAudioSystem<audio::FmodAudioSystem>();
+    {
+        MemoryTagScope tag{ MemoryTag::Audio };
+        ServiceLocator::RegisterAudioSystem<audio::FmodAudioSystem>();
+    }
 
     Debug::Log("LeapEngine Log: Registering default renderer (DirectX)");
-    ServiceLocator::RegisterRenderer<graphics::DirectXEngine>(m_pWindow);
+    {
+        MemoryTagScope tag{ MemoryTag::Graphics };
+        ServiceLocator::RegisterRenderer<graphics::DirectXEngine>(m_pWindow);
+    }
+
+    Debug::Log("LeapEngine Log: Registering default physics (PhysX)");
+    {
+        MemoryTagScope tag{ MemoryTag::Physics };
+        ServiceLocator::RegisterPhysics<physics::PhysXEngine>();
+    }
+
+    Debug::Log("LeapEngine Log: Engine is successfully constructed");
+}
+
+leap::LeapEngine::LeapEngine()
+{
+    Debug::Log("LeapEngine Log: Creating a headless engine, the default audio system and renderer are used");
 
     Debug::Log("LeapEngine Log: Registering default physics (PhysX)");
-    ServiceLocator::RegisterPhysics<physics::PhysXEngine>();
+    {
+        MemoryTagScope tag{ MemoryTag::Physics };
+        ServiceLocator::RegisterPhysics<physics::PhysXEngine>();
+    }
 
     Debug::Log("LeapEngine Log: Engine is successfully constructed");
 }
@@ -61,9 +92,17 @@ leap::LeapEngine::~LeapEngine()
 }
 
 void leap::LeapEngine::Run(const std::function<void()>& afterInitialize, int desiredFPS)
+{
+    Run(afterInitialize, desiredFPS, UINT_MAX);
+}
+
+void leap::LeapEngine::Run(const std::function<void()>& afterInitialize, int desiredFPS, unsigned int nrOfFrames)
 {
     auto& renderer{ ServiceLocator::GetRenderer() };
-    renderer.Initialize();
+    {
+        MemoryTagScope tag{ MemoryTag::Graphics };
+        renderer.Initialize();
+    }
 
     afterInitialize();
 
@@ -80,7 +119,10 @@ void leap::LeapEngine::Run(const std::function<void()>& afterInitialize, int des
 
     auto& audio{ ServiceLocator::GetAudio() };
     auto& physics{ ServiceLocator::GetPhysics() };
-    physics.SetSyncFunc(PhysicsSync::SetTransform, PhysicsSync::GetTransform);
+    auto& frameAllocator{ FrameAllocator::GetInstance() };
+    auto& commandBuffer{ CommandBuffer::GetInstance() };
+    physics.SetSyncFunc(PhysicsSync::SetTransform);
+    physics.SetTaskScheduler(std::make_unique<PhysicsTaskScheduler>());
     physics.OnCollisionEnter().AddListener(PhysicsSync::OnCollisionEnter);
     physics.OnCollisionStay().AddListener(PhysicsSync::OnCollisionStay);
     physics.OnCollisionExit().AddListener(PhysicsSync::OnCollisionExit);
@@ -89,42 +131,93 @@ void leap::LeapEngine::Run(const std::function<void()>& afterInitialize, int des
     physics.OnTriggerExit().AddListener(PhysicsSync::OnTriggerExit);
     
 
-    while (!glfwWindowShouldClose(m_pWindow))
+    for (unsigned int frameIdx{}; frameIdx < nrOfFrames; ++frameIdx)
     {
+        if (m_pWindow && glfwWindowShouldClose(m_pWindow)) break;
+
         const auto currentTime = std::chrono::high_resolution_clock::now();
 
         // Update gamecontext (Timer & window)
         gameContext.Update();
         fixedTotalTime += timer->GetDeltaTime();
 
-        glfwPollEvents();
-        input.ProcessInput();
+        {
+            MemoryTagScope tag{ MemoryTag::Input };
+            if (m_pWindow)
+            {
+                glfwPollEvents();
+                input.ProcessInput();
+            }
+        }
 
-        sceneManager.OnFrameStart();
+        {
+            MemoryTagScope tag{ MemoryTag::SceneGraph };
+            sceneManager.OnFrameStart();
+        }
 
         const float fixedInterval = timer->GetFixedTime();
+
+        // Never run more fixed steps than allowed, otherwise every slow frame makes the next one slower
+        const float maxFixedTotalTime{ fixedInterval * static_cast<float>(timer->GetMaxFixedSteps()) };
+        if (fixedTotalTime > maxFixedTotalTime) fixedTotalTime = maxFixedTotalTime;
+
         while (fixedTotalTime >= fixedInterval)
         {
             fixedTotalTime -= fixedInterval;
-            sceneManager.FixedUpdate();
-            physics.Update(fixedInterval);
+            {
+                MemoryTagScope tag{ MemoryTag::Components };
+                sceneManager.FixedUpdate();
+            }
+            {
+                // With async simulation the last step keeps running during Update, LateUpdate and rendering,
+                //      its results are applied at the start of the next step
+                MemoryTagScope tag{ MemoryTag::Physics };
+                physics.Update(fixedInterval);
+            }
         }
+        timer->m_FixedTimeAlpha = fixedTotalTime / fixedInterval;
 
-        sceneManager.Update();
+        {
+            MemoryTagScope tag{ MemoryTag::Components };
+            sceneManager.Update();
+        }
 
-        audio.Update();
+        {
+            MemoryTagScope tag{ MemoryTag::Audio };
+            audio.Update();
+        }
+
+        {
+            MemoryTagScope tag{ MemoryTag::Components };
+            sceneManager.LateUpdate();
+        }
 
-        sceneManager.LateUpdate();
+        {
+            // Sync point for the scene changes recorded from any thread
+            MemoryTagScope tag{ MemoryTag::SceneGraph };
+            commandBuffer.Playback(sceneManager.GetActiveScene());
+        }
 
-        renderer.GuiDraw();
-        sceneManager.OnGUI();
-        gameContext.OnGUI();
+        {
+            MemoryTagScope tag{ MemoryTag::Graphics };
+            renderer.GuiDraw();
+            sceneManager.OnGUI();
+            gameContext.OnGUI();
+
+            renderer.DrawLines(physics.GetDebugDrawings());
+            renderer.Draw();
+            if (m_pWindow) glfwSwapBuffers(m_pWindow);
+        }
 
-        renderer.DrawLines(physics.GetDebugDrawings());
-        renderer.Draw();
-        glfwSwapBuffers(m_pWindow);
+        {
+            MemoryTagScope tag{ MemoryTag::SceneGraph };
+            sceneManager.OnFrameEnd();
+        }
+        frameAllocator.OnFrameEnd();
 
-        sceneManager.OnFrameEnd();
+        // Checked before the counters of the frame are closed, the allocations of a report land in the frame that is reported
+        if (m_IsZeroAllocationMode) CheckFrameAllocations(sceneManager.GetActiveScene());
+        MemoryTracker::OnFrameEnd();
 
         // Wait to sync back with desired fps
         long long curFrameTimeNs{};
@@ -134,8 +227,62 @@ void leap::LeapEngine::Run(const std::function<void()>& afterInitialize, int des
         } while (frameTimeNs - curFrameTimeNs > 0);
     }
 
+    // The objects of the scene can't be released while a step is still running
+    physics.FetchResults();
     sceneManager.UnloadScene();
 
-    Debug::Log("LeapEngine Log: Destroying window");
-    glfwTerminate();
+    if (m_pWindow)
+    {
+        Debug::Log("LeapEngine Log: Destroying window");
+        glfwTerminate();
+    }
+}
+
+void leap::LeapEngine::SetZeroAllocationMode(bool isEnabled, unsigned int nrOfWarmupFrames)
+{
+    m_IsZeroAllocationMode = isEnabled;
+    m_NrOfWarmupFrames = nrOfWarmupFrames;
+    m_NrOfSceneFrames = 0;
+    m_NrOfAllocatingFrames = 0;
+    m_pCheckedScene = nullptr;
+    m_IsSceneReported = false;
+}
+
+void leap::LeapEngine::CheckFrameAllocations(const Scene* pActiveScene)
+{
+    // Loading a scene allocates, so every scene gets its own warm-up
+    if (pActiveScene != m_pCheckedScene)
+    {
+        m_pCheckedScene = pActiveScene;
+        m_NrOfSceneFrames = 0;
+        m_IsSceneReported = false;
+    }
+
+    if (m_NrOfSceneFrames < m_NrOfWarmupFrames)
+    {
+        ++m_NrOfSceneFrames;
+        return;
+    }
+
+    const uint64_t nrOfAllocations{ MemoryTracker::GetCurrentFrameAllocations() };
+    if (nrOfAllocations == 0) return;
+
+    ++m_NrOfAllocatingFrames;
+
+    // Only report the first allocating frame of a scene, logging itself allocates
+    if (m_IsSceneReported) return;
+    m_IsSceneReported = true;
+
+    // Every counter is read before the report itself allocates
+    std::array<uint64_t, static_cast<size_t>(MemoryTag::Count)> nrOfTagAllocations{};
+    for (size_t i{}; i < nrOfTagAllocations.size(); ++i) nrOfTagAllocations[i] = MemoryTracker::GetCurrentFrameAllocations(static_cast<MemoryTag>(i));
+
+    std::stringstream ss{};
+    ss << "LeapEngine Warning: Steady state frame made " << nrOfAllocations << " heap allocations (";
+    for (size_t i{}; i < nrOfTagAllocations.size(); ++i)
+    {
+        if (nrOfTagAllocations[i] > 0) ss << ' ' << MemoryTracker::GetTagName(static_cast<MemoryTag>(i)) << ": " << nrOfTagAllocations[i];
+    }
+    ss << " )";
+    Debug::LogWarning(ss.str());
 }
\ No newline at end of file
@@ -10,10 +10,16 @@ namespace leap
 		class IRenderer;
 	}
 
+	class Scene;
+
 	class LeapEngine final
 	{
 	public:
 		explicit LeapEngine(int width, int height, const char* title);
+		/// <summary>
+		/// Creates an engine without a window, renderer and audio system to run scenes headless (e.g. in tests)
+		/// </summary>
+		LeapEngine();
 		~LeapEngine();
 		LeapEngine(const LeapEngine& other) = delete;
 		LeapEngine(LeapEngine&& other) = delete;
@@ -21,8 +27,28 @@ namespace leap
 		LeapEngine& operator=(LeapEngine&& other) = delete;
 
 		void Run(const std::function<void()>& afterInitialize, int desiredFPS);
+		/// <summary>
+		/// Runs nrOfFrames frames, or less when the window is closed first
+		/// </summary>
+		void Run(const std::function<void()>& afterInitialize, int desiredFPS, unsigned int nrOfFrames);
+
+		/// <summary>
+		/// In zero allocation mode every frame after the warm-up frames of a scene is checked for heap allocations
+		/// The first frame of a scene that still allocates logs a warning with the allocations per MemoryTag
+		/// </summary>
+		void SetZeroAllocationMode(bool isEnabled, unsigned int nrOfWarmupFrames = 120);
+		unsigned int GetNrOfAllocatingFrames() const { return m_NrOfAllocatingFrames; }
 
 	private:
+		void CheckFrameAllocations(const Scene* pActiveScene);
+
 		GLFWwindow* m_pWindow{};
+
+		bool m_IsZeroAllocationMode{};
+		unsigned int m_NrOfWarmupFrames{};
+		unsigned int m_NrOfSceneFrames{};
+		unsigned int m_NrOfAllocatingFrames{};
+		const Scene* m_pCheckedScene{};
+		bool m_IsSceneReported{};
 	};
 }
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "FrameAllocator.h"
+#include "MemoryTracker.h"
+
+#include <stdlib.h>
+#include <assert.h>
+
+namespace leap
+{
+	static size_t AlignUp(size_t value, size_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	FrameAllocator::FrameAllocator()
+	{
+		for (Arena& arena : m_Arenas)
+		{
+			arena.pBuffer = static_cast<char*>(malloc(m_InitialCapacity));
+			arena.capacity = m_InitialCapacity;
+
+			assert(arena.pBuffer != nullptr);
+		}
+	}
+
+	FrameAllocator::~FrameAllocator()
+	{
+		for (Arena& arena : m_Arenas)
+		{
+			ResetArena(arena);
+			free(arena.pBuffer);
+		}
+	}
+
+	void* FrameAllocator::Allocate(size_t nrOfBytes, size_t alignment)
+	{
+		assert((alignment & (alignment - 1)) == 0 && "Alignment needs to be a power of two");
+
+		Arena& arena{ m_Arenas[m_CurrentArena] };
+
+		// Bump the offset of the current arena if the allocation still fits
+		const size_t start{ AlignUp(reinterpret_cast<size_t>(arena.pBuffer) + arena.offset, alignment) - reinterpret_cast<size_t>(arena.pBuffer) };
+		if (start + nrOfBytes <= arena.capacity)
+		{
+			arena.offset = start + nrOfBytes;
+			return arena.pBuffer + start;
+		}
+
+		return AllocateOverflow(arena, nrOfBytes, alignment);
+	}
+
+	size_t FrameAllocator::GetUsedMemory() const
+	{
+		const Arena& arena{ m_Arenas[m_CurrentArena] };
+		return arena.offset + arena.overflowSize;
+	}
+
+	void FrameAllocator::OnFrameEnd()
+	{
+		// Report the high-water mark of the frame that just ended
+		MemoryTracker::TrackFrameArena(GetUsedMemory());
+
+		// Swap to the arena of the previous frame, its data is not used anymore
+		m_CurrentArena = (m_CurrentArena + 1) % m_Arenas.size();
+		ResetArena(m_Arenas[m_CurrentArena]);
+	}
+
+	void* FrameAllocator::AllocateOverflow(Arena& arena, size_t nrOfBytes, size_t alignment)
+	{
+		// The arena is full, keep this frame going with a separate block
+		//		the arena will grow the next time it gets reset
+		const size_t headerSize{ AlignUp(sizeof(Overflow), alignment) };
+		char* const pMemory{ static_cast<char*>(malloc(headerSize + nrOfBytes + alignment)) };
+
+		assert(pMemory != nullptr);
+
+		Overflow* const pOverflow{ reinterpret_cast<Overflow*>(pMemory) };
+		pOverflow->pNext = arena.pOverflow;
+		arena.pOverflow = pOverflow;
+		arena.overflowSize += nrOfBytes + alignment;
+
+		return reinterpret_cast<char*>(AlignUp(reinterpret_cast<size_t>(pMemory) + headerSize, alignment));
+	}
+
+	void FrameAllocator::ResetArena(Arena& arena)
+	{
+		// Release all overflow blocks
+		Overflow* pOverflow{ arena.pOverflow };
+		while (pOverflow)
+		{
+			Overflow* pOverflowToRemove{ pOverflow };
+			pOverflow = pOverflow->pNext;
+			free(pOverflowToRemove);
+		}
+
+		// Grow the arena so the same workload fits without overflowing next time
+		const size_t usedMemory{ arena.offset + arena.overflowSize };
+		if (arena.overflowSize > 0 && usedMemory > arena.capacity)
+		{
+			size_t newCapacity{ arena.capacity };
+			while (newCapacity < usedMemory) newCapacity *= 2;
+
+			free(arena.pBuffer);
+			arena.pBuffer = static_cast<char*>(malloc(newCapacity));
+			arena.capacity = newCapacity;
+
+			assert(arena.pBuffer != nullptr);
+		}
+
+		arena.offset = 0;
+		arena.overflowSize = 0;
+		arena.pOverflow = nullptr;
+	}
+}
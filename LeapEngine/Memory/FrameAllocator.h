@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Singleton.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace leap
+{
+	class LeapEngine;
+
+	/// <summary>
+	/// FrameAllocator is a double-buffered linear arena for transient per-frame allocations
+	/// Memory handed out during a frame stays valid until the end of the next frame, it is never freed individually
+	/// This allocator is not thread safe and should only be used from the main thread
+	/// </summary>
+	class FrameAllocator final : public Singleton<FrameAllocator>
+	{
+	public:
+		virtual ~FrameAllocator();
+		FrameAllocator(const FrameAllocator& other) = delete;
+		FrameAllocator(FrameAllocator&& other) = delete;
+		FrameAllocator& operator=(const FrameAllocator& other) = delete;
+		FrameAllocator& operator=(FrameAllocator&& other) = delete;
+
+		void* Allocate(size_t nrOfBytes, size_t alignment = alignof(std::max_align_t));
+
+		template <class T>
+		T* Allocate(size_t count);
+
+		size_t GetUsedMemory() const;
+
+	private:
+		friend Singleton;
+		friend LeapEngine;
+		FrameAllocator();
+
+		/// <summary>
+		/// Internally used to swap the arenas at the end of every frame
+		/// The arena of two frames ago gets reset and grows if it overflowed
+		/// </summary>
+		void OnFrameEnd();
+
+		struct Overflow final
+		{
+			Overflow* pNext;
+		};
+
+		struct Arena final
+		{
+			char* pBuffer{};
+			size_t capacity{};
+			size_t offset{};
+			size_t overflowSize{};
+			Overflow* pOverflow{};
+		};
+
+		void* AllocateOverflow(Arena& arena, size_t nrOfBytes, size_t alignment);
+		void ResetArena(Arena& arena);
+
+		static constexpr size_t m_InitialCapacity{ 256 * 1024 };
+
+		std::array<Arena, 2> m_Arenas{};
+		size_t m_CurrentArena{};
+	};
+
+	template<class T>
+	inline T* FrameAllocator::Allocate(size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	/// <summary>
+	/// STL compatible allocator that allocates from the FrameAllocator
+	/// Containers using this allocator may only be kept alive until the end of the next frame
+	/// </summary>
+	template <class T>
+	class TFrameAllocator
+	{
+	public:
+		using value_type = T;
+
+		TFrameAllocator() = default;
+		template <class U>
+		TFrameAllocator(const TFrameAllocator<U>&) noexcept {}
+
+		T* allocate(size_t count) { return FrameAllocator::GetInstance().Allocate<T>(count); }
+		void deallocate(T*, size_t) noexcept {}
+
+		template <class U>
+		bool operator==(const TFrameAllocator<U>&) const noexcept { return true; }
+	};
+
+	template <class T>
+	using FrameVector = std::vector<T, TFrameAllocator<T>>;
+}
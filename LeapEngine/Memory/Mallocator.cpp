@@ -1,32 +1,53 @@
 #include "Mallocator.h"
 #include "MemoryTracker.h"
 
-#include <algorithm>
+#include <stdlib.h>
 #include <assert.h>
 
-#define SAFE_DELETE(pointer) free(pointer); pointer = nullptr;
-
 namespace leap
 {
 	static const uint16_t MEMORY_TAG = 0xBEEF;
 
+	// Every slab starts with a Slab header, padded so the first block keeps the malloc() alignment
+	static constexpr int32_t SLAB_HEADER_SIZE{ 16 };
+
+	/// <summary>
+	/// Free blocks owned by a single thread, this is trivially destructible so it stays usable
+	///		while other thread_local objects get destroyed
+	/// </summary>
+	struct Mallocator::ThreadCache
+	{
+		std::array<Block*, m_NrOfSizeClasses> pFreeLists;
+		std::array<uint32_t, m_NrOfSizeClasses> nrOfBlocks;
+		bool isRegistered;
+		bool isReleased;
+	};
+
+	thread_local Mallocator::ThreadCache Mallocator::m_ThreadCache{};
+
+	Mallocator::ThreadCacheReleaser::~ThreadCacheReleaser()
+	{
+		pMallocator->ReleaseThreadCache();
+	}
+
 	Mallocator::Mallocator()
-		: m_pBlocks{}
-		, m_pCurrentEnd{}
-	{}
+		: m_Depots{}
+		, m_pSlabs{}
+	{
+		static_assert(sizeof(Block) % m_Granularity == 0, "The block header needs to keep allocations aligned");
+	}
 
 	Mallocator::~Mallocator()
 	{
-		Node* pNode{ m_pBlocks };
+		Slab* pSlab{ m_pSlabs };
 
-		while (pNode)
+		while (pSlab)
 		{
-			Node* pNodeToRemove{ pNode };
+			Slab* pSlabToRemove{ pSlab };
 
-			pNode = pNode->pNext;
+			pSlab = pSlab->pNext;
 
-			SAFE_DELETE(pNodeToRemove->pBlock);
-			SAFE_DELETE(pNodeToRemove);
+			free(pSlabToRemove);
 		}
 	}
 
@@ -34,125 +55,287 @@ namespace leap
 	{
 		assert(nrOfBytes > 0);
 
-		// Allocate a Block + the actual memory we're trying to allocate
-		Block* pNewBlock{ static_cast<Block*>(malloc(sizeof(Block) + nrOfBytes)) };
+		if (nrOfBytes > m_MaxSmallSize)
+		{
+			return AllocateLarge(nrOfBytes);
+		}
 
-		assert(pNewBlock != nullptr);
+		const uint16_t sizeClass{ GetSizeClass(nrOfBytes) };
 
-		pNewBlock->tag = MEMORY_TAG;
-		pNewBlock->size = nrOfBytes;
-		pNewBlock->pBlock = reinterpret_cast<void*>(reinterpret_cast<uint64_t>(pNewBlock) + sizeof(Block));
+		ThreadCache& cache{ m_ThreadCache };
+		Block* pBlock{};
 
-		AddNewBlock(pNewBlock);
+		// The cache of this thread is already released (thread is shutting down), blocks that are put in it now would never be returned
+		if (cache.isReleased)
+		{
+			pBlock = TakeFromDepot(sizeClass);
+		}
+		else
+		{
+			if (!cache.pFreeLists[sizeClass])
+			{
+				RefillThreadCache(sizeClass);
+			}
 
-		MemoryTracker::TrackMemory(nrOfBytes);
+			// Pop the first free block of this size class
+			pBlock = cache.pFreeLists[sizeClass];
+			cache.pFreeLists[sizeClass] = pBlock->pNextFree;
+			--cache.nrOfBlocks[sizeClass];
+		}
+
+		const MemoryTag memoryTag{ MemoryTracker::GetCurrentTag() };
+
+		pBlock->tag = MEMORY_TAG;
+		pBlock->memoryTag = static_cast<uint8_t>(memoryTag);
+		pBlock->size = nrOfBytes;
+		pBlock->pNextFree = nullptr;
 
-		return pNewBlock->pBlock;
+		MemoryTracker::TrackMemory(nrOfBytes, memoryTag);
+
+		return reinterpret_cast<char*>(pBlock) + sizeof(Block);
 	}
 
 	void Mallocator::Deallocate(void* pMemory)
 	{
 		// check if this piece of memory is part of our memory
 		// we do this by taking the memory address and going BACK to the tag to check if it's 0xBEEF
-		Block* const pBlock{ reinterpret_cast<Block*>(reinterpret_cast<uint64_t>(pMemory) - sizeof(Block::size) - sizeof(Block::tag)) };
-		const uint16_t tag{ pBlock->tag };
+		Block* const pBlock{ reinterpret_cast<Block*>(static_cast<char*>(pMemory) - sizeof(Block)) };
 
-		if (tag != MEMORY_TAG)
+		if (pBlock->tag != MEMORY_TAG)
 		{
 			return;
 		}
 
-		MemoryTracker::UntrackMemory(pBlock->size);
+		MemoryTracker::UntrackMemory(pBlock->size, static_cast<MemoryTag>(pBlock->memoryTag));
 
-		RemoveExistingBlock(pBlock);
-	}
+		// Clear the tag so a double delete gets ignored instead of corrupting a free list
+		pBlock->tag = 0;
 
-	void Mallocator::AddNewBlock(Block* const pBlock)
-	{
-		Node* const pNewNode{ static_cast<Node*>(malloc(sizeof(Node))) };
+		if (pBlock->sizeClass == m_LargeAllocation)
+		{
+			free(pBlock);
+			return;
+		}
 
-		pNewNode->pBlock = pBlock;
-		pNewNode->pNext = nullptr;
+		const uint16_t sizeClass{ pBlock->sizeClass };
+		ThreadCache& cache{ m_ThreadCache };
 
-		if (!m_pBlocks)
+		// The cache of this thread is already released (thread is shutting down), go straight to the depot
+		if (cache.isReleased)
 		{
-			m_pBlocks = pNewNode;
+			ReturnToDepot(sizeClass, pBlock, pBlock);
+			return;
 		}
 
-		if (!m_pCurrentEnd)
+		if (!cache.isRegistered)
 		{
-			m_pCurrentEnd = pNewNode;
+			RegisterThreadCache();
 		}
-		else
+
+		// Blocks freed by another thread than the one that allocated them simply join the cache of this thread
+		pBlock->pNextFree = cache.pFreeLists[sizeClass];
+		cache.pFreeLists[sizeClass] = pBlock;
+
+		// Hand a batch back to the depot if this thread is hoarding too many blocks
+		if (++cache.nrOfBlocks[sizeClass] > m_BatchSize * 2)
 		{
-			m_pCurrentEnd->pNext = pNewNode;
-			m_pCurrentEnd = pNewNode;
+			ReturnBatch(sizeClass, m_BatchSize);
 		}
+	}
+
+	uint16_t Mallocator::GetSizeClass(int32_t nrOfBytes)
+	{
+		// Lookup table from (nrOfBytes / granularity) to the smallest size class that fits
+		static constexpr auto lookup
+		{
+			[]()
+			{
+				std::array<uint8_t, m_MaxSmallSize / m_Granularity + 1> table{};
 
-		++m_NrOfBlocks;
+				uint8_t sizeClass{};
+				for (size_t i{}; i < table.size(); ++i)
+				{
+					while (m_SizeClasses[sizeClass] < static_cast<int32_t>(i) * m_Granularity) ++sizeClass;
+					table[i] = sizeClass;
+				}
+
+				return table;
+			}()
+		};
+
+		return lookup[(nrOfBytes + m_Granularity - 1) / m_Granularity];
+	}
+
+	void* Mallocator::AllocateLarge(const int32_t nrOfBytes)
+	{
+		// Allocate a Block + the actual memory we're trying to allocate
+		Block* const pBlock{ static_cast<Block*>(malloc(sizeof(Block) + nrOfBytes)) };
+
+		assert(pBlock != nullptr);
+
+		const MemoryTag memoryTag{ MemoryTracker::GetCurrentTag() };
+
+		pBlock->tag = MEMORY_TAG;
+		pBlock->sizeClass = m_LargeAllocation;
+		pBlock->memoryTag = static_cast<uint8_t>(memoryTag);
+		pBlock->size = nrOfBytes;
+		pBlock->pNextFree = nullptr;
+
+		MemoryTracker::TrackMemory(nrOfBytes, memoryTag);
+
+		return reinterpret_cast<char*>(pBlock) + sizeof(Block);
 	}
 
-	void Mallocator::RemoveExistingBlock(Block* const pBlock)
+	void Mallocator::RefillThreadCache(uint16_t sizeClass)
 	{
-		if (!m_pBlocks)
+		ThreadCache& cache{ m_ThreadCache };
+
+		if (!cache.isRegistered)
 		{
-			// no point in searching if we have not allocated
-			return;
+			RegisterThreadCache();
 		}
 
-		// first, do a trivial check for the beginning and end of our list
-		if (Node* pStart{ m_pBlocks }; pStart->pBlock == pBlock)
+		// Take a batch of blocks from the depot
 		{
-			m_pBlocks = pStart->pNext;
+			Depot& depot{ m_Depots[sizeClass] };
+			const std::lock_guard lock{ depot.mutex };
 
-			SAFE_DELETE(pStart->pBlock);
-			SAFE_DELETE(pStart);
+			Block* pLast{ depot.pFreeList };
+			if (pLast)
+			{
+				uint32_t nrOfBlocks{ 1 };
+				while (nrOfBlocks < m_BatchSize && pLast->pNextFree)
+				{
+					pLast = pLast->pNextFree;
+					++nrOfBlocks;
+				}
 
-			--m_NrOfBlocks;
+				cache.pFreeLists[sizeClass] = depot.pFreeList;
+				cache.nrOfBlocks[sizeClass] = nrOfBlocks;
 
-			return;
+				depot.pFreeList = pLast->pNextFree;
+				pLast->pNextFree = nullptr;
+
+				return;
+			}
 		}
-		else if (Node* pEnd{ m_pCurrentEnd }; pEnd->pBlock == pBlock)
+
+		// The depot is empty too, create new blocks
+		CarveSlab(sizeClass);
+	}
+
+	Mallocator::Block* Mallocator::TakeFromDepot(uint16_t sizeClass)
+	{
 		{
-			// traverse all the way to the second last node
-			Node* pNewEnd{ m_pBlocks };
-			while (pNewEnd->pNext != pEnd)
+			Depot& depot{ m_Depots[sizeClass] };
+			const std::lock_guard lock{ depot.mutex };
+
+			if (Block* const pBlock{ depot.pFreeList })
 			{
-				pNewEnd = pNewEnd->pNext;
+				depot.pFreeList = pBlock->pNextFree;
+				return pBlock;
 			}
+		}
 
-			m_pCurrentEnd = pEnd;
+		// The depot is empty too, the new blocks except the one that is used go straight to the depot
+		CarveSlab(sizeClass);
 
-			SAFE_DELETE(pEnd->pBlock);
-			SAFE_DELETE(pEnd);
+		ThreadCache& cache{ m_ThreadCache };
 
-			--m_NrOfBlocks;
+		Block* const pBlock{ cache.pFreeLists[sizeClass] };
+		cache.pFreeLists[sizeClass] = pBlock->pNextFree;
+		--cache.nrOfBlocks[sizeClass];
 
-			return;
+		ReturnBatch(sizeClass, cache.nrOfBlocks[sizeClass]);
+
+		return pBlock;
+	}
+
+	void Mallocator::CarveSlab(uint16_t sizeClass)
+	{
+		char* const pMemory{ static_cast<char*>(malloc(m_SlabSize)) };
+
+		assert(pMemory != nullptr);
+
+		// Link the slab so it can be released when the allocator gets destroyed
+		{
+			const std::lock_guard lock{ m_SlabMutex };
+
+			Slab* const pSlab{ reinterpret_cast<Slab*>(pMemory) };
+			pSlab->pNext = m_pSlabs;
+			m_pSlabs = pSlab;
 		}
 
-		// we've already checked the first node, so we can start at the second node
-		Node* pPreviousNode{ m_pBlocks };
-		Node* pNode{ m_pBlocks->pNext };
+		// Carve the slab into blocks and push them on the free list of this thread
+		ThreadCache& cache{ m_ThreadCache };
 
-		while (pNode)
+		const int32_t blockSize{ static_cast<int32_t>(sizeof(Block)) + m_SizeClasses[sizeClass] };
+		const int32_t nrOfBlocks{ (m_SlabSize - SLAB_HEADER_SIZE) / blockSize };
+
+		for (int32_t i{ nrOfBlocks - 1 }; i >= 0; --i)
 		{
-			if (pNode->pBlock == pBlock)
-			{
-				// we found our block, we want to remove this node and block
-				// so, we need to link the previous block to the next block
-				pPreviousNode->pNext = pNode->pNext;
+			Block* const pBlock{ reinterpret_cast<Block*>(pMemory + SLAB_HEADER_SIZE + i * blockSize) };
+
+			pBlock->tag = 0;
+			pBlock->sizeClass = static_cast<uint8_t>(sizeClass);
+			pBlock->memoryTag = 0;
+			pBlock->size = 0;
+			pBlock->pNextFree = cache.pFreeLists[sizeClass];
 
-				SAFE_DELETE(pNode->pBlock);
-				SAFE_DELETE(pNode);
+			cache.pFreeLists[sizeClass] = pBlock;
+		}
 
-				--m_NrOfBlocks;
+		cache.nrOfBlocks[sizeClass] += static_cast<uint32_t>(nrOfBlocks);
+	}
 
-				return;
-			}
+	void Mallocator::ReturnBatch(uint16_t sizeClass, uint32_t nrOfBlocks)
+	{
+		ThreadCache& cache{ m_ThreadCache };
+
+		Block* const pFirst{ cache.pFreeLists[sizeClass] };
+		if (!pFirst) return;
+
+		// Find the end of the batch outside of the lock
+		Block* pLast{ pFirst };
+		uint32_t nrOfReturnedBlocks{ 1 };
+		while (nrOfReturnedBlocks < nrOfBlocks && pLast->pNextFree)
+		{
+			pLast = pLast->pNextFree;
+			++nrOfReturnedBlocks;
+		}
+
+		cache.pFreeLists[sizeClass] = pLast->pNextFree;
+		cache.nrOfBlocks[sizeClass] -= nrOfReturnedBlocks;
+
+		ReturnToDepot(sizeClass, pFirst, pLast);
+	}
 
-			pPreviousNode = pNode;
-			pNode = pNode->pNext;
+	void Mallocator::ReturnToDepot(uint16_t sizeClass, Block* pFirst, Block* pLast)
+	{
+		Depot& depot{ m_Depots[sizeClass] };
+		const std::lock_guard lock{ depot.mutex };
+
+		pLast->pNextFree = depot.pFreeList;
+		depot.pFreeList = pFirst;
+	}
+
+	void Mallocator::RegisterThreadCache()
+	{
+		m_ThreadCache.isRegistered = true;
+
+		// Constructed once per thread, its destructor returns the cache of this thread to the depots
+		static thread_local ThreadCacheReleaser releaser{ this };
+	}
+
+	void Mallocator::ReleaseThreadCache()
+	{
+		ThreadCache& cache{ m_ThreadCache };
+
+		for (uint16_t sizeClass{}; sizeClass < m_NrOfSizeClasses; ++sizeClass)
+		{
+			ReturnBatch(sizeClass, cache.nrOfBlocks[sizeClass]);
 		}
+
+		cache.isReleased = true;
 	}
-}
\ No newline at end of file
+}
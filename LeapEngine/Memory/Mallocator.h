@@ -1,12 +1,18 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
+#include <array>
+#include <mutex>
 
 namespace leap
 {
 	/// <summary>
-	/// Mallocator is a simple malloc() based allocator, with tags for memory tracking
+	/// Mallocator is a malloc() based size-class slab allocator, with tags for (per-subsystem) memory tracking
+	/// Small allocations are served from per-thread caches of free blocks per size class,
+	///		caches exchange blocks in batches with a shared depot which is refilled from large slabs
+	/// Allocating and freeing are O(1) and don't take a lock unless a thread cache runs empty or overflows
+	/// Allocations bigger than the largest size class go directly to malloc()
+	/// There is only supposed to be one Mallocator, the thread caches are shared process-wide
 	/// </summary>
 	class Mallocator final
 	{
@@ -14,30 +20,79 @@ namespace leap
 		struct Block
 		{
 			uint16_t tag;
+			uint8_t sizeClass;
+			// The MemoryTag this allocation is accounted to
+			uint8_t memoryTag;
 			int32_t size;
-			void* pBlock;
+			// Only valid while the block is inside a free list
+			Block* pNextFree;
 		};
 
-		struct Node
+		struct Slab
 		{
-			Block* pBlock;
-			Node* pNext;
+			Slab* pNext;
+		};
+
+		struct Depot
+		{
+			std::mutex mutex{};
+			Block* pFreeList{};
+		};
+
+		struct ThreadCache;
+		struct ThreadCacheReleaser
+		{
+			~ThreadCacheReleaser();
+
+			Mallocator* pMallocator{};
 		};
 
 	public:
 		Mallocator();
 		~Mallocator();
 
+		Mallocator(const Mallocator& other) = delete;
+		Mallocator(Mallocator&& other) = delete;
+		Mallocator& operator=(const Mallocator& other) = delete;
+		Mallocator& operator=(Mallocator&& other) = delete;
+
 		void* Allocate(const int32_t nrOfBytes);
 		void Deallocate(void* pMemory);
 
 	private:
-		void AddNewBlock(Block* const pBlock);
-		void RemoveExistingBlock(Block* const pBlock);
+		static constexpr uint16_t m_NrOfSizeClasses{ 28 };
+		static constexpr uint8_t m_LargeAllocation{ UINT8_MAX };
+		static constexpr int32_t m_Granularity{ 16 };
+		static constexpr int32_t m_MaxSmallSize{ 4096 };
+		static constexpr int32_t m_SlabSize{ 64 * 1024 };
+		static constexpr uint32_t m_BatchSize{ 32 };
+
+		static constexpr std::array<int32_t, m_NrOfSizeClasses> m_SizeClasses
+		{
+			16, 32, 48, 64, 80, 96, 112, 128,
+			160, 192, 224, 256,
+			320, 384, 448, 512,
+			640, 768, 896, 1024,
+			1280, 1536, 1792, 2048,
+			2560, 3072, 3584, 4096
+		};
+
+		static uint16_t GetSizeClass(int32_t nrOfBytes);
+
+		void* AllocateLarge(const int32_t nrOfBytes);
+		void RefillThreadCache(uint16_t sizeClass);
+		Block* TakeFromDepot(uint16_t sizeClass);
+		void CarveSlab(uint16_t sizeClass);
+		void ReturnBatch(uint16_t sizeClass, uint32_t nrOfBlocks);
+		void ReturnToDepot(uint16_t sizeClass, Block* pFirst, Block* pLast);
+		void RegisterThreadCache();
+		void ReleaseThreadCache();
+
+		static thread_local ThreadCache m_ThreadCache;
 
-		Node* m_pBlocks;
-		Node* m_pCurrentEnd;
+		std::array<Depot, m_NrOfSizeClasses> m_Depots{};
 
-		int32_t m_NrOfBlocks;
+		std::mutex m_SlabMutex{};
+		Slab* m_pSlabs{};
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,76 @@
+#include "MemoryReport.h"
+#include "MemoryTracker.h"
+
+#include "ImGui/imgui.h"
+
+#include <fstream>
+
+namespace leap
+{
+	void MemoryReport::OnGUI()
+	{
+		constexpr float bytesPerKiB{ 1024.0f };
+
+		ImGui::Begin("Memory");
+
+		ImGui::Text("Total: %.1f KiB", MemoryTracker::GetTotalAllocatedMemory() / bytesPerKiB);
+		ImGui::Text("Allocations last frame: %llu", static_cast<unsigned long long>(MemoryTracker::GetFrameAllocations()));
+		ImGui::Text("Frame arena: %.1f KiB (peak %.1f KiB)", MemoryTracker::GetFrameArenaUsage() / bytesPerKiB, MemoryTracker::GetFrameArenaPeak() / bytesPerKiB);
+
+		if (ImGui::BeginTable("Tags", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+		{
+			ImGui::TableSetupColumn("Tag");
+			ImGui::TableSetupColumn("Current (KiB)");
+			ImGui::TableSetupColumn("Peak (KiB)");
+			ImGui::TableSetupColumn("Allocations");
+			ImGui::TableSetupColumn("Last frame");
+			ImGui::TableHeadersRow();
+
+			for (size_t i{}; i < static_cast<size_t>(MemoryTag::Count); ++i)
+			{
+				const MemoryTag tag{ static_cast<MemoryTag>(i) };
+				const MemoryTracker::TagStats stats{ MemoryTracker::GetTagStats(tag) };
+
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(MemoryTracker::GetTagName(tag));
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.currentMemory / bytesPerKiB);
+				ImGui::TableNextColumn();
+				ImGui::Text("%.1f", stats.peakMemory / bytesPerKiB);
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(stats.nrOfAllocations));
+				ImGui::TableNextColumn();
+				ImGui::Text("%llu", static_cast<unsigned long long>(stats.nrOfFrameAllocations));
+			}
+
+			ImGui::EndTable();
+		}
+
+		ImGui::End();
+	}
+
+	bool MemoryReport::WriteCSV(const std::string& filePath)
+	{
+		std::ofstream file{ filePath };
+		if (!file.is_open()) return false;
+
+		file << "Tag,CurrentBytes,PeakBytes,Allocations,LastFrameAllocations\n";
+
+		for (size_t i{}; i < static_cast<size_t>(MemoryTag::Count); ++i)
+		{
+			const MemoryTag tag{ static_cast<MemoryTag>(i) };
+			const MemoryTracker::TagStats stats{ MemoryTracker::GetTagStats(tag) };
+
+			file << MemoryTracker::GetTagName(tag) << ','
+				<< stats.currentMemory << ','
+				<< stats.peakMemory << ','
+				<< stats.nrOfAllocations << ','
+				<< stats.nrOfFrameAllocations << '\n';
+		}
+
+		file << "Total," << MemoryTracker::GetTotalAllocatedMemory() << ",,," << MemoryTracker::GetFrameAllocations() << '\n';
+
+		return true;
+	}
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <string>
+
+namespace leap
+{
+	/// <summary>
+	/// Reports the per-subsystem statistics of the MemoryTracker
+	/// </summary>
+	class MemoryReport final
+	{
+	public:
+		/// <summary>
+		/// Draws a window with the memory usage per MemoryTag, needs to be called between the ImGui frame begin and end
+		/// </summary>
+		static void OnGUI();
+
+		/// <summary>
+		/// Writes the memory usage per MemoryTag to a csv file, returns false if the file could not be opened
+		/// </summary>
+		static bool WriteCSV(const std::string& filePath);
+	};
+}
@@ -1,14 +1,95 @@
 #include "MemoryTracker.h"
 
+#include <assert.h>
+
 namespace leap
 {
-	void MemoryTracker::TrackMemory(const uint64_t nrOfBytes)
+	void MemoryTracker::TrackMemory(const uint64_t nrOfBytes, MemoryTag tag)
+	{
+		m_TotalAllocatedMemory.fetch_add(nrOfBytes, std::memory_order_relaxed);
+		m_FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		AtomicTagStats& stats{ m_TagStats[static_cast<size_t>(tag)] };
+		const uint64_t currentMemory{ stats.currentMemory.fetch_add(nrOfBytes, std::memory_order_relaxed) + nrOfBytes };
+		UpdatePeak(stats.peakMemory, currentMemory);
+		stats.nrOfAllocations.fetch_add(1, std::memory_order_relaxed);
+		stats.nrOfFrameAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::UntrackMemory(const uint64_t nrOfBytes, MemoryTag tag)
+	{
+		m_TotalAllocatedMemory.fetch_sub(nrOfBytes, std::memory_order_relaxed);
+		m_TagStats[static_cast<size_t>(tag)].currentMemory.fetch_sub(nrOfBytes, std::memory_order_relaxed);
+	}
+
+	void MemoryTracker::TrackFrameArena(const uint64_t nrOfBytes)
 	{
-		m_TotalAllocatedMemory += nrOfBytes;
+		m_FrameArenaUsage.store(nrOfBytes, std::memory_order_relaxed);
+		UpdatePeak(m_FrameArenaPeak, nrOfBytes);
+	}
+
+	void MemoryTracker::PushTag(MemoryTag tag)
+	{
+		assert(m_TagStackSize < m_MaxTagDepth && "MemoryTracker tag stack overflow");
+
+		m_TagStack[m_TagStackSize++] = tag;
+	}
+
+	void MemoryTracker::PopTag()
+	{
+		assert(m_TagStackSize > 0 && "MemoryTracker tag stack underflow");
+
+		--m_TagStackSize;
+	}
+
+	MemoryTag MemoryTracker::GetCurrentTag()
+	{
+		return m_TagStackSize > 0 ? m_TagStack[m_TagStackSize - 1] : MemoryTag::General;
+	}
+
+	const char* MemoryTracker::GetTagName(MemoryTag tag)
+	{
+		static constexpr std::array<const char*, m_NrOfTags> names
+		{
+			"General",
+			"SceneGraph",
+			"Components",
+			"Physics",
+			"Audio",
+			"Graphics",
+			"Input",
+			"Logging"
+		};
+
+		return names[static_cast<size_t>(tag)];
+	}
+
+	MemoryTracker::TagStats MemoryTracker::GetTagStats(MemoryTag tag)
+	{
+		const AtomicTagStats& stats{ m_TagStats[static_cast<size_t>(tag)] };
+
+		return TagStats
+		{
+			stats.currentMemory.load(std::memory_order_relaxed),
+			stats.peakMemory.load(std::memory_order_relaxed),
+			stats.nrOfAllocations.load(std::memory_order_relaxed),
+			stats.nrOfPreviousFrameAllocations.load(std::memory_order_relaxed)
+		};
+	}
+
+	void MemoryTracker::OnFrameEnd()
+	{
+		m_PreviousFrameAllocations.store(m_FrameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+
+		for (AtomicTagStats& stats : m_TagStats)
+		{
+			stats.nrOfPreviousFrameAllocations.store(stats.nrOfFrameAllocations.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		}
 	}
 
-	void MemoryTracker::UntrackMemory(const uint64_t nrOfBytes)
+	void MemoryTracker::UpdatePeak(std::atomic<uint64_t>& peak, uint64_t value)
 	{
-		m_TotalAllocatedMemory -= nrOfBytes;
+		uint64_t currentPeak{ peak.load(std::memory_order_relaxed) };
+		while (value > currentPeak && !peak.compare_exchange_weak(currentPeak, value, std::memory_order_relaxed));
 	}
-}
\ No newline at end of file
+}
@@ -1,16 +1,119 @@
 #pragma once
 
 #include <cstdint>
+#include <atomic>
+#include <array>
 
 namespace leap
 {
+	class LeapEngine;
+
+	/// <summary>
+	/// The subsystem an allocation is accounted to
+	/// </summary>
+	enum class MemoryTag : uint8_t
+	{
+		General,
+		SceneGraph,
+		Components,
+		Physics,
+		Audio,
+		Graphics,
+		Input,
+		Logging,
+		Count
+	};
+
 	class MemoryTracker final
 	{
 	public:
-		static void TrackMemory(const uint64_t nrOfBytes);
-		static void UntrackMemory(const uint64_t nrOfBytes);
+		struct TagStats final
+		{
+			uint64_t currentMemory{};
+			uint64_t peakMemory{};
+			uint64_t nrOfAllocations{};
+			uint64_t nrOfFrameAllocations{};
+		};
+
+		static void TrackMemory(const uint64_t nrOfBytes, MemoryTag tag = MemoryTag::General);
+		static void UntrackMemory(const uint64_t nrOfBytes, MemoryTag tag = MemoryTag::General);
+
+		/// <summary>
+		/// Stores the amount of memory the frame arena used during the previous frame
+		/// </summary>
+		static void TrackFrameArena(const uint64_t nrOfBytes);
+
+		/// <summary>
+		/// Allocations on this thread are accounted to the tag on top of the tag stack
+		/// Prefer using MemoryTagScope over calling these manually
+		/// </summary>
+		static void PushTag(MemoryTag tag);
+		static void PopTag();
+		static MemoryTag GetCurrentTag();
+
+		static const char* GetTagName(MemoryTag tag);
+		/// <summary>
+		/// Returns the statistics of a tag, the frame allocations are the allocations of the previous frame
+		/// </summary>
+		static TagStats GetTagStats(MemoryTag tag);
+
+		static uint64_t GetTotalAllocatedMemory() { return m_TotalAllocatedMemory.load(std::memory_order_relaxed); }
+		static uint64_t GetFrameAllocations() { return m_PreviousFrameAllocations.load(std::memory_order_relaxed); }
+		static uint64_t GetFrameArenaUsage() { return m_FrameArenaUsage.load(std::memory_order_relaxed); }
+		static uint64_t GetFrameArenaPeak() { return m_FrameArenaPeak.load(std::memory_order_relaxed); }
 
 	private:
-		inline static uint64_t m_TotalAllocatedMemory;
+		friend LeapEngine;
+
+		/// <summary>
+		/// Internally used to close the per-frame allocation counters
+		/// </summary>
+		static void OnFrameEnd();
+
+		/// <summary>
+		/// Internally used to check the allocations of the current frame before its counters are closed
+		/// </summary>
+		static uint64_t GetCurrentFrameAllocations() { return m_FrameAllocations.load(std::memory_order_relaxed); }
+		static uint64_t GetCurrentFrameAllocations(MemoryTag tag) { return m_TagStats[static_cast<size_t>(tag)].nrOfFrameAllocations.load(std::memory_order_relaxed); }
+
+		static void UpdatePeak(std::atomic<uint64_t>& peak, uint64_t value);
+
+		struct AtomicTagStats final
+		{
+			std::atomic<uint64_t> currentMemory;
+			std::atomic<uint64_t> peakMemory;
+			std::atomic<uint64_t> nrOfAllocations;
+			std::atomic<uint64_t> nrOfFrameAllocations;
+			std::atomic<uint64_t> nrOfPreviousFrameAllocations;
+		};
+
+		static constexpr size_t m_NrOfTags{ static_cast<size_t>(MemoryTag::Count) };
+		static constexpr size_t m_MaxTagDepth{ 32 };
+
+		// Allocations can happen on any thread, so every counter is atomic
+		inline static std::atomic<uint64_t> m_TotalAllocatedMemory{};
+		inline static std::atomic<uint64_t> m_FrameAllocations{};
+		inline static std::atomic<uint64_t> m_PreviousFrameAllocations{};
+		inline static std::atomic<uint64_t> m_FrameArenaUsage{};
+		inline static std::atomic<uint64_t> m_FrameArenaPeak{};
+		inline static std::array<AtomicTagStats, m_NrOfTags> m_TagStats{};
+
+		inline static thread_local std::array<MemoryTag, m_MaxTagDepth> m_TagStack{};
+		inline static thread_local size_t m_TagStackSize{};
+	};
+
+	/// <summary>
+	/// Accounts all allocations on this thread to the given tag while this object is alive
+	/// </summary>
+	class MemoryTagScope final
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) { MemoryTracker::PushTag(tag); }
+		~MemoryTagScope() { MemoryTracker::PopTag(); }
+
+		MemoryTagScope(const MemoryTagScope& other) = delete;
+		MemoryTagScope(MemoryTagScope&& other) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope& other) = delete;
+		MemoryTagScope& operator=(MemoryTagScope&& other) = delete;
 	};
-}
\ No newline at end of file
+}
@@ -28,4 +28,9 @@ void operator delete(void* pMemory)
 	}
 
 	GetMallocator().Deallocate(pMemory);
-}
\ No newline at end of file
+}
+
+void operator delete(void* pMemory, size_t)
+{
+	operator delete(pMemory);
+}
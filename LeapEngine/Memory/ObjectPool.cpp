@@ -0,0 +1,99 @@
+#include "ObjectPool.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <functional>
+#include <new>
+
+namespace leap
+{
+	ObjectPool::ObjectPool(size_t elementSize, size_t nrOfElementsPerChunk)
+		// Every slot needs to be able to hold a free list node and keep the next slot aligned
+		: m_ElementSize{ (std::max(elementSize, sizeof(FreeSlot)) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1) }
+		, m_NrOfElementsPerChunk{ nrOfElementsPerChunk }
+	{
+	}
+
+	ObjectPool::~ObjectPool()
+	{
+		assert(m_NrOfUsedElements == 0 && "ObjectPool is destroyed while its objects are still alive");
+
+		for (void* pChunk : m_pChunks)
+		{
+			::operator delete(pChunk);
+		}
+	}
+
+	void* ObjectPool::Allocate()
+	{
+		if (!m_pFreeList) AddChunk(m_NrOfElementsPerChunk);
+
+		FreeSlot* pSlot{ m_pFreeList };
+		m_pFreeList = pSlot->pNext;
+		++m_NrOfUsedElements;
+
+		return pSlot;
+	}
+
+	void ObjectPool::Deallocate(void* pMemory)
+	{
+		FreeSlot* pSlot{ static_cast<FreeSlot*>(pMemory) };
+		pSlot->pNext = m_pFreeList;
+		m_pFreeList = pSlot;
+		--m_NrOfUsedElements;
+	}
+
+	void ObjectPool::Reserve(size_t nrOfElements)
+	{
+		const size_t nrOfFreeElements{ m_Capacity - m_NrOfUsedElements };
+		if (nrOfFreeElements >= nrOfElements) return;
+
+		AddChunk(std::max(nrOfElements - nrOfFreeElements, m_NrOfElementsPerChunk));
+	}
+
+	void ObjectPool::SortFreeList()
+	{
+		std::vector<FreeSlot*> pFreeSlots{};
+		pFreeSlots.reserve(m_Capacity - m_NrOfUsedElements);
+		for (FreeSlot* pSlot{ m_pFreeList }; pSlot != nullptr; pSlot = pSlot->pNext) pFreeSlots.push_back(pSlot);
+
+		std::sort(begin(pFreeSlots), end(pFreeSlots), std::greater<FreeSlot*>{});
+
+		// Link the slots back to front, like a new chunk
+		m_pFreeList = nullptr;
+		for (FreeSlot* pSlot : pFreeSlots)
+		{
+			pSlot->pNext = m_pFreeList;
+			m_pFreeList = pSlot;
+		}
+	}
+
+	void ObjectPool::AddChunk(size_t nrOfElements)
+	{
+		char* pChunk{ static_cast<char*>(::operator new(m_ElementSize * nrOfElements)) };
+		m_pChunks.push_back(pChunk);
+		m_Capacity += nrOfElements;
+
+		// Link the slots back to front, so objects get handed out in memory order
+		for (size_t i{ nrOfElements }; i > 0; --i)
+		{
+			FreeSlot* pSlot{ reinterpret_cast<FreeSlot*>(pChunk + (i - 1) * m_ElementSize) };
+			pSlot->pNext = m_pFreeList;
+			m_pFreeList = pSlot;
+		}
+	}
+
+	ObjectPool& ObjectPools::GetPool(uint32_t typeID, size_t elementSize)
+	{
+		if (typeID >= m_pPools.size()) m_pPools.resize(typeID + 1);
+
+		std::unique_ptr<ObjectPool>& pPool{ m_pPools[typeID] };
+		if (pPool == nullptr)
+		{
+			const size_t nrOfElementsPerChunk{ std::max(m_ChunkSize / elementSize, m_MinElementsPerChunk) };
+			pPool = std::make_unique<ObjectPool>(elementSize, nrOfElementsPerChunk);
+		}
+
+		return *pPool;
+	}
+}
\ No newline at end of file
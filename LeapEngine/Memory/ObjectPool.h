@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Singleton.h"
+
+#include "../Components/ComponentType.h"
+
+#include <cstddef>
+#include <memory>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace leap
+{
+	/// <summary>
+	/// ObjectPool hands out fixed-size slots from large contiguous chunks
+	/// Freed slots are recycled through an intrusive free list, chunks are only released when the pool gets destroyed
+	/// This pool is not thread safe and should only be used from the main thread
+	/// </summary>
+	class ObjectPool final
+	{
+	public:
+		ObjectPool(size_t elementSize, size_t nrOfElementsPerChunk);
+		~ObjectPool();
+
+		ObjectPool(const ObjectPool& other) = delete;
+		ObjectPool(ObjectPool&& other) = delete;
+		ObjectPool& operator=(const ObjectPool& other) = delete;
+		ObjectPool& operator=(ObjectPool&& other) = delete;
+
+		void* Allocate();
+		void Deallocate(void* pMemory);
+
+		/// <summary>
+		/// Makes sure the next nrOfElements allocations don't need a new chunk, missing elements are added as one single chunk
+		/// </summary>
+		void Reserve(size_t nrOfElements);
+
+		/// <summary>
+		/// Links the free slots in memory order, so the next allocations fill the lowest free slots first
+		/// </summary>
+		void SortFreeList();
+
+		size_t GetElementSize() const { return m_ElementSize; }
+		size_t GetNrOfUsedElements() const { return m_NrOfUsedElements; }
+		size_t GetCapacity() const { return m_Capacity; }
+
+	private:
+		struct FreeSlot final
+		{
+			FreeSlot* pNext;
+		};
+
+		void AddChunk(size_t nrOfElements);
+
+		const size_t m_ElementSize;
+		const size_t m_NrOfElementsPerChunk;
+
+		std::vector<void*> m_pChunks{};
+		FreeSlot* m_pFreeList{};
+		size_t m_NrOfUsedElements{};
+		size_t m_Capacity{};
+	};
+
+	/// <summary>
+	/// unique_ptr deleter that destroys an object and returns its memory to the pool it was created from
+	/// </summary>
+	template <class T>
+	struct TPoolDeleter final
+	{
+		TPoolDeleter() = default;
+		TPoolDeleter(ObjectPool* pPool) : pPool{ pPool } {}
+		template <class U>
+		TPoolDeleter(const TPoolDeleter<U>& other) noexcept : pPool{ other.pPool } {}
+
+		void operator()(T* pObject) const
+		{
+			// The memory of the pool starts at the most derived object, which isn't always the address of a base class
+			void* pMemory;
+			if constexpr (std::is_polymorphic_v<T>) pMemory = dynamic_cast<void*>(pObject);
+			else pMemory = pObject;
+
+			pObject->~T();
+			pPool->Deallocate(pMemory);
+		}
+
+		ObjectPool* pPool{};
+	};
+
+	template <class T>
+	using PooledPtr = std::unique_ptr<T, TPoolDeleter<T>>;
+
+	/// <summary>
+	/// Owns one ObjectPool per type, indexed by the dense ComponentType ID of the type
+	/// Unlike the typename hash, the ID is unique per type, so two types can never share a pool
+	/// </summary>
+	class ObjectPools final : public Singleton<ObjectPools>
+	{
+	public:
+		virtual ~ObjectPools() = default;
+		ObjectPools(const ObjectPools& other) = delete;
+		ObjectPools(ObjectPools&& other) = delete;
+		ObjectPools& operator=(const ObjectPools& other) = delete;
+		ObjectPools& operator=(ObjectPools&& other) = delete;
+
+		template <class T, class... Args>
+		PooledPtr<T> Create(Args&&... args);
+
+		template <class T>
+		ObjectPool& GetPool();
+
+		/// <summary>
+		/// Makes sure the next nrOfElements objects of type T can be created without more than one allocation
+		/// </summary>
+		template <class T>
+		void Reserve(size_t nrOfElements);
+
+	private:
+		friend Singleton;
+		ObjectPools() = default;
+
+		ObjectPool& GetPool(uint32_t typeID, size_t elementSize);
+
+		static constexpr size_t m_ChunkSize{ 64 * 1024 };
+		static constexpr size_t m_MinElementsPerChunk{ 16 };
+
+		std::vector<std::unique_ptr<ObjectPool>> m_pPools{};
+	};
+
+	template <class T, class... Args>
+	inline PooledPtr<T> ObjectPools::Create(Args&&... args)
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Pooled types can't be over-aligned");
+
+		ObjectPool& pool{ GetPool<T>() };
+
+		void* pMemory{ pool.Allocate() };
+		return PooledPtr<T>{ new (pMemory) T(std::forward<Args>(args)...), TPoolDeleter<T>{ &pool } };
+	}
+
+	template <class T>
+	inline ObjectPool& ObjectPools::GetPool()
+	{
+		return GetPool(ComponentType::GetID<T>(), sizeof(T));
+	}
+
+	template <class T>
+	inline void ObjectPools::Reserve(size_t nrOfElements)
+	{
+		GetPool<T>().Reserve(nrOfElements);
+	}
+}
@@ -3,6 +3,7 @@
 #include "../ServiceLocator/ServiceLocator.h"
 #include <Interfaces/IPhysics.h>
 #include <Data/RaycastHit.h>
+#include <Data/SceneQuery.h>
 #include "../Components/Physics/Collider.h"
 
 bool leap::Physics::Raycast(const glm::vec3& start, const glm::vec3& direction, float distance, RaycastHitInfo& hitInfo)
@@ -12,11 +13,7 @@ bool leap::Physics::Raycast(const glm::vec3& start, const glm::vec3& direction,
 	const bool succes{ ServiceLocator::GetPhysics().Raycast(start, direction, distance, hit) };
 	if (!succes) return false;
 
-	hitInfo.distance = hit.distance;
-	hitInfo.pCollider = static_cast<Collider*>(hit.pCollider);
-	hitInfo.pRigidbody = hitInfo.pCollider->GetRigidbody();
-	hitInfo.point = hit.point;
-	hitInfo.normal = hit.normal;
+	hitInfo = GetHitInfo(hit);
 
 	return succes;
 }
@@ -37,3 +34,14 @@ bool leap::Physics::Raycast(const glm::vec3& start, const glm::vec3& direction)
 	RaycastHitInfo temp{};
 	return Raycast(start, direction, FLT_MAX, temp);
 }
+
+void leap::Physics::ExecuteQueries(physics::SceneQueryBatch& batch)
+{
+	ServiceLocator::GetPhysics().ExecuteQueries(batch);
+}
+
+leap::RaycastHitInfo leap::Physics::GetHitInfo(const physics::RaycastHit& hit)
+{
+	Collider* pCollider{ static_cast<Collider*>(hit.pCollider) };
+	return RaycastHitInfo{ pCollider, pCollider->GetRigidbody(), hit.distance, hit.point, hit.normal };
+}
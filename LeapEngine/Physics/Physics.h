@@ -7,6 +7,12 @@ namespace leap
 	class Collider;
 	class Rigidbody;
 
+	namespace physics
+	{
+		struct RaycastHit;
+		struct SceneQueryBatch;
+	}
+
 	struct RaycastHitInfo final
 	{
 		Collider* pCollider{};
@@ -27,5 +33,11 @@ namespace leap
 		static bool Raycast(const glm::vec3& start, const glm::vec3& direction, RaycastHitInfo& hitInfo);
 		// Calls raycast using FLT_MAX as distance
 		static bool Raycast(const glm::vec3& start, const glm::vec3& direction);
+
+		// Executes every query of the batch across the worker threads, see physics::SceneQueryBatch
+		// Use it instead of Raycast when a system has a lot of queries every frame
+		static void ExecuteQueries(physics::SceneQueryBatch& batch);
+		// Returns the collider and rigidbody of a hit in the results of a batch
+		static RaycastHitInfo GetHitInfo(const physics::RaycastHit& hit);
 	};
 }
\ No newline at end of file
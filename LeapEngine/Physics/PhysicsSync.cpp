@@ -10,20 +10,11 @@
 
 void leap::PhysicsSync::SetTransform(void* pOwner, const glm::vec3& position, const glm::quat& rotation)
 {
-	Transform* pTransform{ static_cast<GameObject*>(pOwner)->GetTransform() };
+	// The owner of a physics object is the transform of its gameobject
+	Transform* pTransform{ static_cast<Transform*>(pOwner) };
 
-	pTransform->SetWorldPosition(position);
-	pTransform->SetWorldRotation(rotation);
-}
-
-std::pair<glm::vec3, glm::quat> leap::PhysicsSync::GetTransform(void* pOwner)
-{
-	Transform* pTransform{ static_cast<GameObject*>(pOwner)->GetTransform() };
-
-	const glm::vec3& position{ pTransform->GetWorldPosition() };
-	const glm::quat& rotation{ pTransform->GetWorldRotation() };
-
-	return std::make_pair(position, rotation);
+	// Physics runs at the fixed rate, rendering interpolates between the poses of the fixed steps
+	pTransform->SetSimulatedWorldPose(position, rotation);
 }
 
 void leap::PhysicsSync::OnCollisionEnter(const physics::CollisionData& collision)
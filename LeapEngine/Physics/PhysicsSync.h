@@ -18,7 +18,6 @@ namespace leap
 	{
 	public:
 		static void SetTransform(void* pOwner, const glm::vec3& position, const glm::quat& rotation);
-		static std::pair<glm::vec3, glm::quat> GetTransform(void* pOwner);
 		static void OnCollisionEnter(const physics::CollisionData& collision);
 		static void OnCollisionStay(const physics::CollisionData& collision);
 		static void OnCollisionExit(const physics::CollisionData& collision);
@@ -0,0 +1,43 @@
+#include "PhysicsTaskScheduler.h"
+
+#include "../ServiceLocator/ServiceLocator.h"
+#include "../Jobs/JobSystem.h"
+
+void leap::PhysicsTaskScheduler::Schedule(physics::IPhysicsTask* pTask)
+{
+	const Job job
+	{
+		[](void* pData, uint32_t, uint32_t) { static_cast<physics::IPhysicsTask*>(pData)->Run(); },
+		pTask,
+		0, 1,
+		nullptr,
+		0
+	};
+
+	ServiceLocator::GetJobSystem().Schedule(job);
+}
+
+unsigned int leap::PhysicsTaskScheduler::GetNrOfWorkers() const
+{
+	// The thread that starts a step doesn't execute jobs while it waits for the results
+	return ServiceLocator::GetJobSystem().GetNrOfThreads() - 1;
+}
+
+void leap::PhysicsTaskScheduler::ParallelFor(uint32_t nrOfElements, uint32_t batchSize, void (*pFunction)(void* pData, uint32_t begin, uint32_t end), void* pData)
+{
+	if (batchSize == 0) batchSize = 1;
+
+	JobSystem& jobSystem{ ServiceLocator::GetJobSystem() };
+	JobCounter counter{};
+
+	Job job{ pFunction, pData, 0, 0, &counter, 0 };
+	for (uint32_t begin{}; begin < nrOfElements; begin += batchSize)
+	{
+		job.begin = begin;
+		job.end = nrOfElements - begin > batchSize ? begin + batchSize : nrOfElements;
+		jobSystem.Schedule(job);
+	}
+
+	// Waiting executes jobs, so this doesn't block a worker when it is called from a job
+	jobSystem.Wait(counter);
+}
\ No newline at end of file
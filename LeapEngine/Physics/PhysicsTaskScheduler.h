@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Interfaces/IPhysicsTaskScheduler.h>
+
+namespace leap
+{
+	/// <summary>
+	/// Runs the tasks of the physics engine as jobs on the job system of the ServiceLocator
+	/// The physics engine uses every worker of the job system, the size and the settings of the workers are set with ServiceLocator::RegisterJobSystem
+	/// </summary>
+	class PhysicsTaskScheduler final : public physics::IPhysicsTaskScheduler
+	{
+	public:
+		PhysicsTaskScheduler() = default;
+		virtual ~PhysicsTaskScheduler() = default;
+
+		PhysicsTaskScheduler(const PhysicsTaskScheduler& other) = delete;
+		PhysicsTaskScheduler(PhysicsTaskScheduler&& other) = delete;
+		PhysicsTaskScheduler& operator=(const PhysicsTaskScheduler& other) = delete;
+		PhysicsTaskScheduler& operator=(PhysicsTaskScheduler&& other) = delete;
+
+		virtual void Schedule(physics::IPhysicsTask* pTask) override;
+		virtual unsigned int GetNrOfWorkers() const override;
+		virtual void ParallelFor(uint32_t nrOfElements, uint32_t batchSize, void (*pFunction)(void* pData, uint32_t begin, uint32_t end), void* pData) override;
+	};
+}
\ No newline at end of file
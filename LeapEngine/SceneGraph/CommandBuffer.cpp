@@ -0,0 +1,203 @@
+#include "CommandBuffer.h"
+
+#include "Scene.h"
+#include "../Components/Transform/Transform.h"
+#include "../Jobs/JobSystem.h"
+
+#include <algorithm>
+
+thread_local leap::CommandBuffer::ThreadBuffer* leap::CommandBuffer::m_pThreadBuffer{};
+
+leap::DeferredGameObject leap::CommandBuffer::CreateGameObject(const char* name, CommandTarget parent)
+{
+	return CreateGameObjects(name, 1, parent);
+}
+
+leap::DeferredGameObject leap::CommandBuffer::CreateGameObjects(const char* name, uint32_t nrOfObjects, CommandTarget parent)
+{
+	Command command{};
+	command.type = CommandType::Create;
+	command.other = parent;
+	command.nrOfObjects = nrOfObjects;
+	command.nameID = StringTable::GetInstance().Intern(name);
+
+	// Claim the indices of the deferred gameobjects right away, so the caller can use them in later commands
+	const uint32_t firstIdx{ m_NrOfDeferredObjects.fetch_add(nrOfObjects, std::memory_order_relaxed) };
+	command.object = DeferredGameObject{ firstIdx };
+
+	Record(command);
+
+	return DeferredGameObject{ firstIdx };
+}
+
+void leap::CommandBuffer::Destroy(CommandTarget object)
+{
+	Command command{};
+	command.type = CommandType::Destroy;
+	command.object = object;
+
+	Record(command);
+}
+
+void leap::CommandBuffer::SetParent(CommandTarget object, CommandTarget parent)
+{
+	Command command{};
+	command.type = CommandType::SetParent;
+	command.object = object;
+	command.other = parent;
+
+	Record(command);
+}
+
+void leap::CommandBuffer::SetActive(CommandTarget object, bool isActive)
+{
+	Command command{};
+	command.type = CommandType::SetActive;
+	command.object = object;
+	command.isActive = isActive;
+
+	Record(command);
+}
+
+leap::GameObject* leap::CommandBuffer::Resolve(DeferredGameObject object) const
+{
+	return object.index < m_CreatedObjects.size() ? m_CreatedObjects[object.index].Get() : nullptr;
+}
+
+void leap::CommandBuffer::Record(Command& command)
+{
+	if (m_pThreadBuffer == nullptr)
+	{
+		const std::lock_guard lock{ m_BuffersMutex };
+		m_pThreadBuffer = m_pThreadBuffers.emplace_back(std::make_unique<ThreadBuffer>()).get();
+	}
+
+	command.isRecordedInJob = JobSystem::IsExecutingJob();
+	command.order = command.isRecordedInJob ? JobSystem::GetCurrentJobSequence() : JobSystem::GetNrOfScheduledJobs();
+
+	ThreadBuffer& buffer{ *m_pThreadBuffer };
+	const std::lock_guard lock{ buffer.mutex };
+
+	command.sequence = static_cast<uint32_t>(buffer.commands.size());
+	buffer.commands.push_back(command);
+}
+
+leap::GameObject* leap::CommandBuffer::Resolve(const CommandTarget& target) const
+{
+	if (target.m_DeferredIdx == CommandTarget::m_InvalidIndex) return target.m_Object.Get();
+
+	GameObject* pObject{ Resolve(DeferredGameObject{ target.m_DeferredIdx }) };
+	if (pObject == nullptr)
+	{
+		Debug::LogWarning("LeapEngine Warning: CommandBuffer > A command uses a deferred gameobject that doesn't exist, it is not created yet or its parent was destroyed before it could be created. The command is skipped");
+	}
+
+	return pObject;
+}
+
+void leap::CommandBuffer::Playback(Scene* pScene)
+{
+	// Merge the buffers of all threads
+	m_Commands.clear();
+	{
+		const std::lock_guard lock{ m_BuffersMutex };
+
+		for (uint32_t bufferIdx{}; bufferIdx < m_pThreadBuffers.size(); ++bufferIdx)
+		{
+			ThreadBuffer& buffer{ *m_pThreadBuffers[bufferIdx] };
+			const std::lock_guard bufferLock{ buffer.mutex };
+
+			for (Command& command : buffer.commands)
+			{
+				command.bufferIdx = bufferIdx;
+				m_Commands.push_back(command);
+			}
+			buffer.commands.clear();
+		}
+	}
+
+	m_CreatedObjects.assign(m_NrOfDeferredObjects.exchange(0, std::memory_order_relaxed), GameObjectHandle{});
+
+	if (pScene == nullptr || m_Commands.empty()) return;
+
+	// The thread a job ran on doesn't matter, only the order the jobs were scheduled in
+	std::sort(begin(m_Commands), end(m_Commands), [](const Command& a, const Command& b)
+		{
+			if (a.order != b.order) return a.order < b.order;
+			if (a.isRecordedInJob != b.isRecordedInJob) return a.isRecordedInJob;
+			if (a.bufferIdx != b.bufferIdx) return a.bufferIdx < b.bufferIdx;
+			return a.sequence < b.sequence;
+		});
+
+	for (const Command& command : m_Commands)
+	{
+		if (command.type == CommandType::Create)
+		{
+			// Without a parent the gameobjects are added to the root, a parent that was destroyed before the playback skips the creation
+			// The deferred gameobjects stay null then, so the commands on them are skipped too
+			GameObject* pParent{ command.other.IsSet() ? Resolve(command.other) : pScene->GetRootObject() };
+			if (pParent == nullptr) continue;
+
+			// Reserve the memory of all gameobjects at once
+			if (command.nrOfObjects > 1)
+			{
+				ObjectPools& pools{ ObjectPools::GetInstance() };
+				pools.Reserve<GameObject>(command.nrOfObjects);
+				pools.Reserve<Transform>(command.nrOfObjects);
+				pParent->m_pChildrenToAdd.reserve(pParent->m_pChildrenToAdd.size() + command.nrOfObjects);
+			}
+
+			const char* name{ StringTable::GetInstance().GetString(command.nameID) };
+			for (uint32_t i{}; i < command.nrOfObjects; ++i)
+			{
+				m_CreatedObjects[command.object.m_DeferredIdx + i] = pParent->CreateChild(name);
+			}
+
+			continue;
+		}
+
+		GameObject* pObject{ Resolve(command.object) };
+		if (pObject == nullptr) continue;
+
+		switch (command.type)
+		{
+		case CommandType::Destroy:
+			pObject->Destroy();
+			break;
+		case CommandType::SetParent:
+		{
+			// Without a parent the gameobject moves to the root, a parent that was destroyed before the playback skips the command
+			GameObject* pParent{ Resolve(command.other) };
+			if (pParent == nullptr && command.other.IsSet()) break;
+
+			pObject->SetParent(pParent);
+			break;
+		}
+		case CommandType::SetActive:
+			pObject->SetActive(command.isActive);
+			break;
+		case CommandType::AddComponent:
+			command.pAddComponent(pObject);
+			break;
+		case CommandType::Create:
+			// Handled above, it doesn't act on an existing gameobject
+			break;
+		}
+	}
+
+	m_Commands.clear();
+}
+
+void leap::CommandBuffer::Clear()
+{
+	const std::lock_guard lock{ m_BuffersMutex };
+
+	for (const auto& pBuffer : m_pThreadBuffers)
+	{
+		const std::lock_guard bufferLock{ pBuffer->mutex };
+		pBuffer->commands.clear();
+	}
+
+	m_NrOfDeferredObjects.store(0, std::memory_order_relaxed);
+	m_CreatedObjects.clear();
+}
\ No newline at end of file
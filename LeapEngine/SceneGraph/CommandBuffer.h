@@ -0,0 +1,164 @@
+#pragma once
+
+#include "GameObject.h"
+#include "Singleton.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace leap
+{
+	class LeapEngine;
+	class SceneManager;
+
+	/// <summary>
+	/// Refers to a gameobject that gets created when the command buffer is played back
+	/// </summary>
+	struct DeferredGameObject final
+	{
+		uint32_t index;
+
+		/// <summary>
+		/// Returns the gameobject at the given offset of a bulk creation
+		/// </summary>
+		DeferredGameObject At(uint32_t offset) const { return DeferredGameObject{ index + offset }; }
+	};
+
+	/// <summary>
+	/// The gameobject a command acts on, either an existing gameobject or one that gets created by an earlier command
+	/// </summary>
+	class CommandTarget final
+	{
+	public:
+		CommandTarget() = default;
+		CommandTarget(GameObject* pObject) : m_Object{ pObject } {}
+		CommandTarget(DeferredGameObject object) : m_DeferredIdx{ object.index } {}
+
+	private:
+		friend class CommandBuffer;
+
+		static constexpr uint32_t m_InvalidIndex{ 0xFFFFFFFF };
+
+		/// <summary>
+		/// Returns false for the default target (nullptr), which means no gameobject was given
+		/// </summary>
+		bool IsSet() const { return m_DeferredIdx != m_InvalidIndex || m_Object != GameObjectHandle{}; }
+
+		GameObjectHandle m_Object{};
+		uint32_t m_DeferredIdx{ m_InvalidIndex };
+	};
+
+	/// <summary>
+	/// CommandBuffer records structural changes to the scene (create, destroy, reparent, add component and set active) from any thread
+	/// Every thread records into its own buffer, the buffers get merged and played back on the main thread after LateUpdate
+	/// Commands are played back in a fixed order: ordered by the job that recorded them, commands from outside a job come after the jobs
+	///		that were scheduled before them and commands of the same thread keep the order they were recorded in
+	/// Commands on a gameobject or with a parent that is destroyed (or was never created) before the playback are skipped
+	/// </summary>
+	class CommandBuffer final : public Singleton<CommandBuffer>
+	{
+	public:
+		virtual ~CommandBuffer() = default;
+		CommandBuffer(const CommandBuffer& other) = delete;
+		CommandBuffer(CommandBuffer&& other) = delete;
+		CommandBuffer& operator=(const CommandBuffer& other) = delete;
+		CommandBuffer& operator=(CommandBuffer&& other) = delete;
+
+		/// <summary>
+		/// Creates one or multiple gameobjects, without a parent they are added to the root of the active scene
+		/// Nothing is created when the parent is destroyed before the playback, the commands on the deferred gameobjects are skipped then
+		/// Memory for a bulk creation is reserved with a single allocation
+		/// The deferred gameobjects can be used as target of the commands that are recorded after this one
+		/// </summary>
+		DeferredGameObject CreateGameObject(const char* name, CommandTarget parent = nullptr);
+		DeferredGameObject CreateGameObjects(const char* name, uint32_t nrOfObjects, CommandTarget parent = nullptr);
+
+		void Destroy(CommandTarget object);
+		void SetParent(CommandTarget object, CommandTarget parent);
+		void SetActive(CommandTarget object, bool isActive);
+		template <class T>
+		void AddComponent(CommandTarget object);
+
+		/// <summary>
+		/// Returns the gameobject that was created for a deferred gameobject by the last playback
+		/// </summary>
+		GameObject* Resolve(DeferredGameObject object) const;
+
+	private:
+		friend Singleton;
+		friend LeapEngine;
+		friend SceneManager;
+		CommandBuffer() = default;
+
+		enum class CommandType : uint8_t
+		{
+			Create,
+			Destroy,
+			SetParent,
+			SetActive,
+			AddComponent
+		};
+
+		struct Command final
+		{
+			// The sequence of the job that recorded this command, or the amount of scheduled jobs if it was recorded outside a job
+			uint64_t order;
+			// The order of the command in the buffer of its thread
+			uint32_t sequence;
+			uint32_t bufferIdx;
+			CommandType type;
+			bool isRecordedInJob;
+			bool isActive;
+			CommandTarget object;
+			// The parent of Create and SetParent
+			CommandTarget other;
+			uint32_t nrOfObjects;
+			// The name of Create is interned, so the string of the caller doesn't have to outlive the playback
+			StringID nameID;
+			void (*pAddComponent)(GameObject* pObject);
+		};
+
+		struct ThreadBuffer final
+		{
+			std::mutex mutex{};
+			std::vector<Command> commands{};
+		};
+
+		void Record(Command& command);
+		GameObject* Resolve(const CommandTarget& target) const;
+
+		/// <summary>
+		/// Internally used to apply all recorded commands to the scene, this can only be called when no jobs are recording
+		/// Clear removes every recorded command, it is used when a new scene gets loaded
+		/// </summary>
+		void Playback(Scene* pScene);
+		void Clear();
+
+		// The buffer the calling thread records into
+		static thread_local ThreadBuffer* m_pThreadBuffer;
+
+		std::mutex m_BuffersMutex{};
+		std::vector<std::unique_ptr<ThreadBuffer>> m_pThreadBuffers{};
+		std::atomic<uint32_t> m_NrOfDeferredObjects{};
+
+		// Reused every playback, so a steady state doesn't allocate
+		std::vector<Command> m_Commands{};
+		std::vector<GameObjectHandle> m_CreatedObjects{};
+	};
+
+	template <class T>
+	inline void CommandBuffer::AddComponent(CommandTarget object)
+	{
+		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
+
+		Command command{};
+		command.type = CommandType::AddComponent;
+		command.object = object;
+		command.pAddComponent = [](GameObject* pObject) { pObject->AddComponent<T>(); };
+
+		Record(command);
+	}
+}
\ No newline at end of file
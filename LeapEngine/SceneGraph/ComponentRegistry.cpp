@@ -0,0 +1,66 @@
+#include "ComponentRegistry.h"
+
+#include "../Components/Component.h"
+
+#include <utility>
+
+void leap::ComponentRegistry::Add(Component* pComponent)
+{
+	const uint32_t typeID{ pComponent->m_TypeID };
+	if (typeID >= m_Types.size()) m_Types.resize(typeID + 1);
+
+	// New components are inactive until their active state is applied
+	TypeRegistry& type{ m_Types[typeID] };
+	pComponent->m_RegistryIndex = static_cast<unsigned int>(type.pComponents.size());
+	type.pComponents.push_back(pComponent);
+}
+
+void leap::ComponentRegistry::Remove(Component* pComponent)
+{
+	const unsigned int index{ pComponent->m_RegistryIndex };
+	if (index == Component::m_InvalidStorageIndex) return;
+
+	// Move the component to the end of the list, without changing the order of the active and inactive components
+	SetActive(pComponent, false);
+
+	TypeRegistry& type{ m_Types[pComponent->m_TypeID] };
+	Swap(type, pComponent->m_RegistryIndex, static_cast<uint32_t>(type.pComponents.size() - 1));
+	type.pComponents.pop_back();
+
+	pComponent->m_RegistryIndex = Component::m_InvalidStorageIndex;
+}
+
+void leap::ComponentRegistry::SetActive(Component* pComponent, bool isActive)
+{
+	const unsigned int index{ pComponent->m_RegistryIndex };
+	if (index == Component::m_InvalidStorageIndex) return;
+
+	TypeRegistry& type{ m_Types[pComponent->m_TypeID] };
+
+	const bool isInActivePart{ index < type.nrOfActiveComponents };
+	if (isInActivePart == isActive) return;
+
+	// Swap the component with the first inactive or the last active component and move the border
+	if (isActive)
+	{
+		Swap(type, index, type.nrOfActiveComponents);
+		++type.nrOfActiveComponents;
+	}
+	else
+	{
+		--type.nrOfActiveComponents;
+		Swap(type, index, type.nrOfActiveComponents);
+	}
+}
+
+void leap::ComponentRegistry::Swap(TypeRegistry& type, uint32_t index, uint32_t otherIndex)
+{
+	if (index == otherIndex) return;
+
+	Component*& pComponent{ type.pComponents[index] };
+	Component*& pOther{ type.pComponents[otherIndex] };
+
+	std::swap(pComponent, pOther);
+	pComponent->m_RegistryIndex = index;
+	pOther->m_RegistryIndex = otherIndex;
+}
\ No newline at end of file
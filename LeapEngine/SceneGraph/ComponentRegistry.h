@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace leap
+{
+	class Component;
+
+	/// <summary>
+	/// A view on the components of one type, iterating it doesn't allocate
+	/// The view stays valid until components get added, (de)activated or removed, which only happens at the start and the end of a frame
+	/// </summary>
+	template <class T>
+	class ComponentRange final
+	{
+	public:
+		class Iterator final
+		{
+		public:
+			explicit Iterator(Component* const* pComponent) : m_pComponent{ pComponent } {}
+
+			T* operator*() const { return static_cast<T*>(*m_pComponent); }
+			Iterator& operator++() { ++m_pComponent; return *this; }
+			bool operator==(const Iterator& other) const { return m_pComponent == other.m_pComponent; }
+
+		private:
+			Component* const* m_pComponent;
+		};
+
+		ComponentRange() = default;
+		ComponentRange(Component* const* pFirst, size_t size) : m_pFirst{ pFirst }, m_Size{ size } {}
+
+		Iterator begin() const { return Iterator{ m_pFirst }; }
+		Iterator end() const { return Iterator{ m_pFirst + m_Size }; }
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		T* operator[](size_t index) const { return static_cast<T*>(m_pFirst[index]); }
+
+	private:
+		Component* const* m_pFirst{};
+		size_t m_Size{};
+	};
+
+	/// <summary>
+	/// The components of a scene stored in one contiguous list per component type
+	/// Every list keeps its active components in front of the inactive ones, so a query for active components doesn't check every component
+	/// Components are swapped around when they get added, (de)activated or removed, the order of a list is not stable
+	/// </summary>
+	class ComponentRegistry final
+	{
+	public:
+		ComponentRegistry() = default;
+		~ComponentRegistry() = default;
+
+		ComponentRegistry(const ComponentRegistry& other) = delete;
+		ComponentRegistry(ComponentRegistry&& other) = delete;
+		ComponentRegistry& operator=(const ComponentRegistry& other) = delete;
+		ComponentRegistry& operator=(ComponentRegistry&& other) = delete;
+
+		void Add(Component* pComponent);
+		void Remove(Component* pComponent);
+		void SetActive(Component* pComponent, bool isActive);
+
+		template <class T>
+		ComponentRange<T> Get(uint32_t typeID, bool includeInactive) const;
+
+	private:
+		struct TypeRegistry final
+		{
+			// Active components first, then the inactive ones
+			std::vector<Component*> pComponents{};
+			uint32_t nrOfActiveComponents{};
+		};
+
+		void Swap(TypeRegistry& type, uint32_t index, uint32_t otherIndex);
+
+		// Indexed by component type ID
+		std::vector<TypeRegistry> m_Types{};
+	};
+
+	template <class T>
+	inline ComponentRange<T> ComponentRegistry::Get(uint32_t typeID, bool includeInactive) const
+	{
+		if (typeID >= m_Types.size()) return {};
+
+		const TypeRegistry& type{ m_Types[typeID] };
+		return { type.pComponents.data(), includeInactive ? type.pComponents.size() : type.nrOfActiveComponents };
+	}
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "ComponentStorage.h"
+
+#include "../Components/Component.h"
+#include "../Jobs/JobSystem.h"
+#include "../ServiceLocator/ServiceLocator.h"
+
+void leap::ComponentStorage::Add(unsigned int typeID, Component* pComponent)
+{
+	// Without grouping, every component ends up in the same list in the order it was added
+	const unsigned int groupID{ m_IsGroupedByType ? typeID : 0 };
+
+	for (size_t phaseIdx{}; phaseIdx < m_Phases.size(); ++phaseIdx)
+	{
+		if ((pComponent->m_TickFlags & (1 << phaseIdx)) == 0) continue;
+
+		Phase& phase{ m_Phases[phaseIdx] };
+
+		auto it{ phase.typeIndices.find(groupID) };
+		if (it == phase.typeIndices.end())
+		{
+			it = phase.typeIndices.emplace(groupID, phase.types.size()).first;
+			phase.types.emplace_back(TypeStorage{ groupID });
+		}
+
+		std::vector<Component*>& pComponents{ phase.types[it->second].pComponents };
+
+		// The component remembers its index, so it can be removed in constant time
+		pComponent->m_TickIndices[phaseIdx] = static_cast<unsigned int>(pComponents.size());
+		pComponents.push_back(pComponent);
+	}
+}
+
+void leap::ComponentStorage::Remove(unsigned int typeID, Component* pComponent)
+{
+	const unsigned int groupID{ m_IsGroupedByType ? typeID : 0 };
+
+	for (size_t phaseIdx{}; phaseIdx < m_Phases.size(); ++phaseIdx)
+	{
+		const unsigned int index{ pComponent->m_TickIndices[phaseIdx] };
+		if (index == Component::m_InvalidStorageIndex) continue;
+
+		Phase& phase{ m_Phases[phaseIdx] };
+
+		const auto it{ phase.typeIndices.find(groupID) };
+		if (it == phase.typeIndices.end()) continue;
+
+		std::vector<Component*>& pComponents{ phase.types[it->second].pComponents };
+		if (index >= pComponents.size() || pComponents[index] != pComponent) continue;
+
+		// Swap the last component into the hole
+		Component* pLast{ pComponents.back() };
+		pComponents[index] = pLast;
+		pLast->m_TickIndices[phaseIdx] = index;
+		pComponents.pop_back();
+
+		pComponent->m_TickIndices[phaseIdx] = Component::m_InvalidStorageIndex;
+	}
+}
+
+void leap::ComponentStorage::Clear()
+{
+	for (size_t phaseIdx{}; phaseIdx < m_Phases.size(); ++phaseIdx)
+	{
+		for (TypeStorage& type : m_Phases[phaseIdx].types)
+		{
+			for (Component* pComponent : type.pComponents) pComponent->m_TickIndices[phaseIdx] = Component::m_InvalidStorageIndex;
+		}
+
+		m_Phases[phaseIdx].types.clear();
+		m_Phases[phaseIdx].typeIndices.clear();
+	}
+}
+
+void leap::ComponentStorage::SetGroupedByType(bool isGroupedByType)
+{
+	if (m_IsGroupedByType == isGroupedByType) return;
+
+	Clear();
+	m_IsGroupedByType = isGroupedByType;
+}
+
+template <void (leap::Component::*pMethod)()>
+void leap::ComponentStorage::Tick(const Phase& phase) const
+{
+	for (const TypeStorage& type : phase.types)
+	{
+		for (Component* pComponent : type.pComponents) (pComponent->*pMethod)();
+	}
+}
+
+template <void (leap::Component::*pMethod)()>
+void leap::ComponentStorage::TickParallel(const Phase& phase) const
+{
+	JobSystem& jobSystem{ ServiceLocator::GetJobSystem() };
+
+	for (const TypeStorage& type : phase.types)
+	{
+		const std::vector<Component*>& pComponents{ type.pComponents };
+		jobSystem.ParallelFor(static_cast<uint32_t>(pComponents.size()), m_ParallelBatchSize,
+			[&pComponents](uint32_t index) { (pComponents[index]->*pMethod)(); });
+	}
+}
+
+void leap::ComponentStorage::FixedUpdate() const
+{
+	Tick<&Component::FixedUpdate>(m_Phases[0]);
+}
+
+void leap::ComponentStorage::Update() const
+{
+	if (!m_Phases[4].types.empty()) TickParallel<&Component::Update>(m_Phases[4]);
+	Tick<&Component::Update>(m_Phases[1]);
+}
+
+void leap::ComponentStorage::LateUpdate() const
+{
+	Tick<&Component::LateUpdate>(m_Phases[2]);
+}
+
+void leap::ComponentStorage::OnGUI() const
+{
+	Tick<&Component::OnGUI>(m_Phases[3]);
+}
+
+size_t leap::ComponentStorage::GetNrOfTicks() const
+{
+	size_t nrOfComponents{};
+	for (const Phase& phase : m_Phases)
+	{
+		for (const TypeStorage& type : phase.types) nrOfComponents += type.pComponents.size();
+	}
+
+	return nrOfComponents;
+}
\ No newline at end of file
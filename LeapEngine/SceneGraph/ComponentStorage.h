@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace leap
+{
+	class Component;
+
+	/// <summary>
+	/// The tick lists of a scene, one flat list of components per lifecycle phase (FixedUpdate, Update, LateUpdate and OnGUI)
+	/// Components are only added to the phases their type overrides, so empty callbacks are never called
+	/// Components with a parallel safe Update (see UpdateAccess) are updated in batches on the job system, before the other Updates
+	/// The lists can optionally be grouped per type, so components of the same type are ticked together
+	/// The components themselves live in the per-type object pools so their addresses stay stable
+	/// </summary>
+	class ComponentStorage final
+	{
+	public:
+		ComponentStorage() = default;
+		~ComponentStorage() = default;
+
+		ComponentStorage(const ComponentStorage& other) = delete;
+		ComponentStorage(ComponentStorage&& other) = delete;
+		ComponentStorage& operator=(const ComponentStorage& other) = delete;
+		ComponentStorage& operator=(ComponentStorage&& other) = delete;
+
+		void Add(unsigned int typeID, Component* pComponent);
+		void Remove(unsigned int typeID, Component* pComponent);
+		void Clear();
+
+		/// <summary>
+		/// Changing the grouping clears the storage, the components need to be added again
+		/// </summary>
+		void SetGroupedByType(bool isGroupedByType);
+		bool IsGroupedByType() const { return m_IsGroupedByType; }
+
+		void FixedUpdate() const;
+		void Update() const;
+		void LateUpdate() const;
+		void OnGUI() const;
+
+		/// <summary>
+		/// Returns the amount of callbacks per frame, a component that ticks in multiple phases is counted for each phase
+		/// </summary>
+		size_t GetNrOfTicks() const;
+
+	private:
+		struct TypeStorage final
+		{
+			unsigned int typeID{};
+			std::vector<Component*> pComponents{};
+		};
+
+		struct Phase final
+		{
+			std::vector<TypeStorage> types{};
+			std::unordered_map<unsigned int, size_t> typeIndices{};
+		};
+
+		template <void (Component::*pMethod)()>
+		void Tick(const Phase& phase) const;
+		template <void (Component::*pMethod)()>
+		void TickParallel(const Phase& phase) const;
+
+		// The amount of components a job of a parallel tick handles
+		static constexpr uint32_t m_ParallelBatchSize{ 64 };
+
+		// The phases are in the same order as the bits of Component::TickFlags
+		std::array<Phase, 5> m_Phases{};
+		bool m_IsGroupedByType{};
+	};
+}
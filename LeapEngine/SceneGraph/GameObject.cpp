@@ -3,20 +3,114 @@
 #include "../Components/Transform/Transform.h"
 
 #include "SceneManager.h"
+#include "ComponentStorage.h"
 
-unsigned int leap::GameObject::m_TransformComponentID = leap::ReflectionUtils::GenerateTypenameHash<Transform>();
-
-leap::GameObject::GameObject(const char* name)
-	: m_Name{ name }
+leap::GameObject::GameObject(const char* name, Scene* pScene)
+	: m_NameID{ StringTable::GetInstance().Intern(name) }
+	, m_pScene{ pScene }
 {
+	m_Name = StringTable::GetInstance().GetString(m_NameID);
+	m_HandleIndex = HandleTables::GetInstance().GetGameObjects().Add(this);
+
+	// The root gameobject is created before the scene has a root and is not indexed
+	if (m_pScene->GetRootObject() != nullptr) m_pScene->m_ObjectsByName.Add(m_NameID, this);
+
+	// A new gameobject gets its active state applied at the start of the next frame
+	m_pScene->QueueActiveStateChange(this);
+
 	m_pTransform = AddComponent<Transform>();
+	m_pScene->m_TransformHierarchy.Add(m_pTransform);
+}
+
+leap::GameObject::GameObject(GameObject* pOther)
+	: m_StateFlags{ pOther->m_StateFlags }
+	, m_Name{ pOther->m_Name }
+	, m_Tag{ pOther->m_Tag }
+	, m_NameID{ pOther->m_NameID }
+	, m_TagID{ pOther->m_TagID }
+	, m_NameSlot{ pOther->m_NameSlot }
+	, m_TagSlot{ pOther->m_TagSlot }
+	, m_pScene{ pOther->m_pScene }
+	, m_pParent{ pOther->m_pParent }
+	, m_pTransform{ pOther->m_pTransform }
+	, m_pChildrenToAdd{ std::move(pOther->m_pChildrenToAdd) }
+	, m_pChildren{ std::move(pOther->m_pChildren) }
+	, m_ComponentsToAdd{ std::move(pOther->m_ComponentsToAdd) }
+	, m_Components{ std::move(pOther->m_Components) }
+	, m_ComponentMask{ pOther->m_ComponentMask }
+	, m_ComponentIndices{ std::move(pOther->m_ComponentIndices) }
+	, m_HandleIndex{ pOther->m_HandleIndex }
+{
+	// Everything that refers to the old address is pointed to this gameobject
+	HandleTables::GetInstance().GetGameObjects().Relocate(m_HandleIndex, this);
+
+	for (const auto& pChild : m_pChildren) pChild->m_pParent = this;
+	for (const auto& pChild : m_pChildrenToAdd) pChild->m_pParent = this;
+	for (const auto& [pComponent, id] : m_Components) pComponent->m_pOwner = this;
+	for (const auto& [pComponent, id] : m_ComponentsToAdd) pComponent->m_pOwner = this;
+
+	m_pScene->m_ObjectsByName.Replace(m_NameID, pOther, this);
+	m_pScene->m_ObjectsByTag.Replace(m_TagID, pOther, this);
+	m_pScene->Requeue(pOther, this);
+
+	// The destructor of the old gameobject has nothing left to remove
+	pOther->m_StateFlags = 0;
+	pOther->m_HandleIndex = HandleTable::m_InvalidIndex;
+}
+
+leap::GameObject::~GameObject()
+{
+	// Make sure the scene doesn't hold on to gameobjects/components that are destroyed before their queued changes are handled
+	for (const auto& [pComponent, id] : m_Components)
+	{
+		m_pScene->Dequeue(pComponent.get());
+		m_pScene->m_ComponentRegistry.Remove(pComponent.get());
+	}
+	for (const auto& [pComponent, id] : m_ComponentsToAdd) m_pScene->Dequeue(pComponent.get());
+	m_pScene->Dequeue(this);
+
+	m_pScene->m_ObjectsByName.Remove(m_NameID, this);
+	m_pScene->m_ObjectsByTag.Remove(m_TagID, this);
+
+	if (m_HandleIndex != HandleTable::m_InvalidIndex) HandleTables::GetInstance().GetGameObjects().Remove(m_HandleIndex);
+}
+
+void leap::GameObject::SetName(const char* name)
+{
+	const StringID nameID{ StringTable::GetInstance().Intern(name) };
+	if (nameID == m_NameID) return;
+
+	if (m_pParent != nullptr)
+	{
+		m_pScene->m_ObjectsByName.Remove(m_NameID, this);
+		m_pScene->m_ObjectsByName.Add(nameID, this);
+	}
+
+	m_NameID = nameID;
+	m_Name = StringTable::GetInstance().GetString(nameID);
+}
+
+void leap::GameObject::SetTag(const char* tag)
+{
+	const StringID tagID{ StringTable::GetInstance().Intern(tag) };
+	if (tagID == m_TagID) return;
+
+	if (m_pParent != nullptr)
+	{
+		m_pScene->m_ObjectsByTag.Remove(m_TagID, this);
+		m_pScene->m_ObjectsByTag.Add(tagID, this);
+	}
+
+	m_TagID = tagID;
+	m_Tag = StringTable::GetInstance().GetString(tagID);
 }
 
 void leap::GameObject::SetParent(GameObject* pParent)
 {
 	if (pParent == nullptr)
 	{
-		pParent = SceneManager::GetInstance().GetActiveScene()->GetRootObject();
+		// The scene of this gameobject, the active scene can still be the previous one while a scene is loaded
+		pParent = m_pScene->GetRootObject();
 	}
 
 	GameObject* pPrevParent{ m_pParent };
@@ -24,36 +118,61 @@ void leap::GameObject::SetParent(GameObject* pParent)
 	// You can't change the parent of the root gameobject
 	if (pPrevParent == nullptr) return;
 
+	if (!CanChangeStructure()) return;
+
 	// Don't do anything if you're assigning the same parent again
 	if (pPrevParent == pParent) return;
 
+	// A gameobject created this frame still waits in the temp container of its parent
+	const bool isWaitingToBeAdded{ IsWaitingToBeAdded() };
+	auto& pPrevChildren{ isWaitingToBeAdded ? pPrevParent->m_pChildrenToAdd : pPrevParent->m_pChildren };
+
 	// Move the unique ptr of itself from the parent to this function
-	const auto selfIt{ std::find_if(begin(pPrevParent->m_pChildren), end(pPrevParent->m_pChildren), [this](const auto& pChild) { return pChild.get() == this; }) };
-	std::unique_ptr<GameObject> pSelf{ std::move(*selfIt) };
+	const auto selfIt{ std::find_if(begin(pPrevChildren), end(pPrevChildren), [this](const auto& pChild) { return pChild.get() == this; }) };
+	PooledPtr<GameObject> pSelf{ std::move(*selfIt) };
 
 	// Keep the world transform
 	GetTransform()->KeepWorldTransform(pParent);
 
 	// Add self to the new parent
-	pParent->m_pChildren.emplace_back(std::move(pSelf));
+	if (isWaitingToBeAdded)
+	{
+		pParent->QueueNewContent();
+		pParent->m_pChildrenToAdd.emplace_back(std::move(pSelf));
+	}
+	else
+	{
+		pParent->m_pChildren.emplace_back(std::move(pSelf));
+	}
 
 	// Erase self from previous parent
-	pPrevParent->m_pChildren.erase(selfIt);
+	pPrevChildren.erase(selfIt);
 
 	// Set the new parent of this gameobject
 	m_pParent = pParent;
+	m_pScene->m_TransformHierarchy.SetParent(m_pTransform, pParent->m_pTransform);
+
+	// The new parent can have a different active state
+	m_pScene->QueueActiveStateChange(this);
 }
 
 leap::GameObject* leap::GameObject::CreateChild(const char* name)
 {
+	if (!CanChangeStructure()) return nullptr;
+
+	// The new child gets moved into the children of this gameobject at the start of the next frame
+	QueueNewContent();
+
 	// Create a new gameobject
-	auto pGameObject{ std::make_unique<GameObject>(name) };
+	auto pGameObject{ ObjectPools::GetInstance().Create<GameObject>(name, m_pScene) };
 
 	// Store the raw ptr
 	GameObject* pRawGameObject{ pGameObject.get() };
 
 	// Set the parent of the new gameobject and add it as a child
 	pGameObject->m_pParent = this;
+	m_pScene->m_TransformHierarchy.SetParent(pGameObject->m_pTransform, m_pTransform);
+	pGameObject->m_StateFlags |= static_cast<unsigned char>(StateFlags::IsWaitingToBeAdded);
 	m_pChildrenToAdd.emplace_back(std::move(pGameObject));
 
 	// Return the raw ptr to the new gameobject
@@ -74,6 +193,8 @@ leap::GameObject* leap::GameObject::GetChild(int index) const
 
 void leap::GameObject::SetActive(bool isActive)
 {
+	if (!CanChangeStructure()) return;
+
 	// Set the next active state
 	// The new active state will be handled at the end of the frame
 	//		(e.g. call OnEnable/OnDisable)
@@ -82,6 +203,7 @@ void leap::GameObject::SetActive(bool isActive)
 	else
 		m_StateFlags &= ~static_cast<unsigned char>(StateFlags::IsActiveLocalNextFrame);
 
+	m_pScene->QueueActiveStateChange(this);
 }
 
 bool leap::GameObject::IsActive() const
@@ -91,7 +213,12 @@ bool leap::GameObject::IsActive() const
 
 void leap::GameObject::Destroy()
 {
+	// The root gameobject can't be destroyed
+	if (m_pParent == nullptr || IsMarkedAsDead()) return;
+	if (!CanChangeStructure()) return;
+
 	m_StateFlags |= static_cast<unsigned char>(StateFlags::IsMarkedAsDead);
+	m_pScene->QueueDestroy(this);
 }
 
 bool leap::GameObject::IsMarkedAsDead() const
@@ -99,186 +226,160 @@ bool leap::GameObject::IsMarkedAsDead() const
 	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsMarkedAsDead);
 }
 
-void leap::GameObject::OnFrameStart()
-{
-	MoveNewObjectsAndComponents(); // Move components and children from the temp container to the normal container
-	CallAwake(); // Call Awake on all new children and components
-	ChangeActiveState(); // Update the local and world active states
-	CallStart(); // Call the start when needed
-	CallEnableAndDisable(); // Call OnEnable and OnDisable when needed
-}
-
-void leap::GameObject::MoveNewObjectsAndComponents()
+void leap::GameObject::MoveNewObjectsAndComponents(ComponentStorage& storage, std::vector<Component*>& pNewComponents)
 {	
 	// Move the components from the temp container to the default container
 	for (auto& pComponent : m_ComponentsToAdd)
 	{
+		storage.Add(pComponent.id, pComponent.pComponent.get());
+		m_pScene->m_ComponentRegistry.Add(pComponent.pComponent.get());
+		pNewComponents.push_back(pComponent.pComponent.get());
 		m_Components.emplace_back(std::move(pComponent));
 	}
 
+	if (!m_ComponentsToAdd.empty()) UpdateComponentLookup();
+
 	// Move the children from the temp container to the default container
 	for (auto& pChild : m_pChildrenToAdd)
 	{
+		pChild->m_StateFlags &= ~static_cast<unsigned char>(StateFlags::IsWaitingToBeAdded);
 		m_pChildren.emplace_back(std::move(pChild));
 	}
 
 	// Clear the temp folders
 	m_ComponentsToAdd.clear();
 	m_pChildrenToAdd.clear();
+}
 
-	// Call MoveNewObjectsAndComponents on all children
-	for (const auto& pChild : m_pChildren)
+void leap::GameObject::ChangeActiveState(std::vector<Component*>& pChangedComponents)
+{
+	// Ensure that the root gameobject is always enabled
+	if (m_pParent == nullptr)
 	{
-		if (pChild) pChild->MoveNewObjectsAndComponents();
+		SetActiveLocal(true);
+		SetWorldState(true, pChangedComponents);
+		return;
 	}
+
+	// Set the new local state and update the world state of this object and its children
+	SetActiveLocal(IsActiveLocalNextFrame());
+	SetWorldState(m_pParent->IsActive(), pChangedComponents);
 }
 
-void leap::GameObject::CallAwake() const
+void leap::GameObject::SetWorldState(bool isParentActive, std::vector<Component*>& pChangedComponents)
 {
-	// Call awake on the new components and children
-	for (const auto& [pComponent, id] : m_Components)
-	{
-		if (!pComponent->IsInitialized())
-		{
-			pComponent->Initialize();
-			pComponent->Awake();
-		}
-	}
-	
-	// Call awake on all children
+	const bool isActive{ isParentActive && IsActiveLocal() };
+
+	// Children that didn't change locally keep their world state if this one doesn't change
+	if (isActive == IsActiveWorld()) return;
+
+	// Update the world active state
+	SetActiveWorld(isActive);
+
+	// The world state of the components depends on this gameobject
+	for (const auto& [pComponent, id] : m_Components) pChangedComponents.push_back(pComponent.get());
+
+	// Update the world state of every child
 	for (const auto& pChild : m_pChildren)
 	{
-		if (pChild) pChild->CallAwake();
+		if (pChild) pChild->SetWorldState(isActive, pChangedComponents);
 	}
 }
 
-void leap::GameObject::ChangeActiveState()
+void leap::GameObject::RemoveDeadComponents(ComponentStorage& storage)
 {
-	// Only update the active state if this gameobject is not the root gameobject
-	//	and the active state has been changed
-	if (m_pParent != nullptr && IsActiveLocalNextFrame() != IsActiveLocal())
+	// Remove all marked components from the tick lists and the queues of the scene before they get destroyed
+	for (const auto& [pComponent, id] : m_Components)
 	{
-		// Set the new local state
-		SetActiveLocal(IsActiveLocalNextFrame());
+		if (!pComponent->IsMarkedAsDead()) continue;
 
-		// Update the world state of this object and its children
-		SetWorldState(IsActiveLocal() && m_pParent->IsActive());
+		storage.Remove(id, pComponent.get());
+		m_pScene->m_ComponentRegistry.Remove(pComponent.get());
+		m_pScene->Dequeue(pComponent.get());
 	}
-	else if (m_pParent == nullptr)
+
+	// Remove all marked components
+	const auto firstDeadIt
 	{
-		// Ensure that the root gameobject is always enabled
-		SetActiveLocal(true);
-		SetActiveWorld(true);
-	}
+		std::remove_if(
+			begin(m_Components), end(m_Components), 
+			[](const ComponentInfo& CInfo) { return CInfo.pComponent->IsMarkedAsDead(); }
+		)
+	};
+	if (firstDeadIt == end(m_Components)) return;
 
-	// Update the active state of the components
-	for (const auto& [pComponent, id] : m_Components) pComponent->ChangeActiveState();
+	m_Components.erase(firstDeadIt, end(m_Components));
+	UpdateComponentLookup();
+}
 
-	// Update the active state of the children
-	for (const auto& pChild : m_pChildren)
+void leap::GameObject::UpdateComponentLookup()
+{
+	m_ComponentMask.fill(0);
+	for (const ComponentInfo& CInfo : m_Components)
 	{
-		if (pChild) pChild->ChangeActiveState();
+		if (CInfo.id < ComponentType::m_MaxNrOfTypes) m_ComponentMask[CInfo.id / 64] |= uint64_t{ 1 } << (CInfo.id % 64);
 	}
-}
 
-void leap::GameObject::SetWorldState(bool isActive)
-{
-	// Update the world active state
-	SetActiveWorld(isActive && IsActiveLocal());
+	uint32_t nrOfTypes{};
+	for (const uint64_t word : m_ComponentMask) nrOfTypes += static_cast<uint32_t>(std::popcount(word));
+	m_ComponentIndices.assign(nrOfTypes, m_InvalidComponentIndex);
 
-	// Update the world state of every child
-	for (const auto& pChild : m_pChildren)
+	// Keep the index of the first component of every type
+	for (uint32_t componentIdx{}; componentIdx < m_Components.size(); ++componentIdx)
 	{
-		if (pChild) pChild->SetWorldState(isActive);
+		const uint32_t typeID{ m_Components[componentIdx].id };
+		if (typeID >= ComponentType::m_MaxNrOfTypes) continue;
+
+		uint32_t& firstComponentIdx{ m_ComponentIndices[GetLookupTableIndex(typeID)] };
+		if (firstComponentIdx == m_InvalidComponentIndex) firstComponentIdx = componentIdx;
 	}
 }
 
-void leap::GameObject::CallStart() const
+void leap::GameObject::RemoveDeadChildren(ComponentStorage& storage)
 {
-	// Call Start on the components if needed
-	for (const auto& [pComponent, id] : m_Components) pComponent->TryCallStart();
-
-	// Call OnEnable or OnDisable on the children
+	// Remove all marked children from the tick lists before they get destroyed
 	for (const auto& pChild : m_pChildren)
 	{
-		if (pChild) pChild->CallStart();
+		if (pChild && pChild->IsMarkedAsDead()) pChild->UnregisterComponents(storage);
 	}
+
+	// Remove all marked children and children that are nullptr
+	m_pChildren.erase(
+		std::remove_if(
+			begin(m_pChildren), end(m_pChildren), 
+			[](const auto& pChild) { return pChild.get() == nullptr || pChild->IsMarkedAsDead(); }
+		),
+		end(m_pChildren));
 }
 
-void leap::GameObject::CallEnableAndDisable() const
+bool leap::GameObject::HasDeadAncestor() const
 {
-	// Call OnEnable or OnDisable on the components if needed
-	for (const auto& [pComponent, id] : m_Components) pComponent->TryCallEnableAndDisable();
-
-	// Call OnEnable or OnDisable on the children
-	for (const auto& pChild : m_pChildren)
+	for (const GameObject* pParent{ m_pParent }; pParent != nullptr; pParent = pParent->m_pParent)
 	{
-		if (pChild) pChild->CallEnableAndDisable();
+		if (pParent->IsMarkedAsDead()) return true;
 	}
-}
 
-void leap::GameObject::OnFrameEnd()
-{
-	CheckDestroyFlag(); // Call OnDestroy on children and components
-	UpdateCleanup(); // Remove children en components that are marked as dead
+	return false;
 }
 
-void leap::GameObject::CheckDestroyFlag() const
+void leap::GameObject::RegisterComponents(ComponentStorage& storage) const
 {
-	// If this gameobject is the root gameobject, just delegate this method to the children
-	if (m_pParent == nullptr)
-	{
-		// Call OnDestroy on every child if necessary
-		for (const auto& pChild : m_pChildren) pChild->CheckDestroyFlag();
-		return;
-	}
+	for (const auto& [pComponent, id] : m_Components) storage.Add(id, pComponent.get());
 
-	// Call OnDestroy on this gameobject and its children
-	if (IsMarkedAsDead()) OnDestroy();
-	else
+	for (const auto& pChild : m_pChildren)
 	{
-		// Call OnDestroy on components if needed
-		for (const auto& [pComponent, id] : m_Components)
-		{
-			if (pComponent->IsMarkedAsDead()) pComponent->OnDestroy();
-		}
-
-		// Call OnDestroy on every child if necessary
-		for (const auto& pChild : m_pChildren)
-		{
-			if (pChild) pChild->CheckDestroyFlag();
-		}
+		if (pChild) pChild->RegisterComponents(storage);
 	}
 }
 
-void leap::GameObject::UpdateCleanup()
+void leap::GameObject::UnregisterComponents(ComponentStorage& storage) const
 {
-	// Remove all marked components
-	m_Components.erase(
-		std::remove_if(
-			begin(m_Components), end(m_Components), 
-			[](const ComponentInfo& CInfo) { return CInfo.pComponent->IsMarkedAsDead(); }
-		),
-		end(m_Components));
-
-	// Remove all children that are nullptr
-	m_pChildren.erase(
-		std::remove_if(
-			begin(m_pChildren), end(m_pChildren),
-			[](const auto& pChild) { return pChild.get() == nullptr; }
-		),
-		end(m_pChildren));
-
-	// Remove all marked children
-	m_pChildren.erase(
-		std::remove_if(
-			begin(m_pChildren), end(m_pChildren), 
-			[](const auto& pChild) { return pChild->IsMarkedAsDead(); }
-		),
-		end(m_pChildren));
+	for (const auto& [pComponent, id] : m_Components) storage.Remove(id, pComponent.get());
 
-	// Cleanup every child
-	for (const auto& pChild : m_pChildren) pChild->UpdateCleanup();
+	for (const auto& pChild : m_pChildren)
+	{
+		if (pChild) pChild->UnregisterComponents(storage);
+	}
 }
 
 bool leap::GameObject::IsActiveLocalNextFrame() const
@@ -312,6 +413,21 @@ void leap::GameObject::SetActiveWorld(bool isActive)
 		m_StateFlags &= ~static_cast<unsigned char>(StateFlags::IsActiveWorld);
 }
 
+bool leap::GameObject::IsWaitingToBeAdded() const
+{
+	return m_StateFlags & static_cast<unsigned char>(StateFlags::IsWaitingToBeAdded);
+}
+
+void leap::GameObject::QueueNewContent()
+{
+	m_pScene->QueueNewContent(this);
+}
+
+bool leap::GameObject::CanChangeStructure()
+{
+	return Scene::CanChangeStructure();
+}
+
 leap::Transform* leap::GameObject::GetTransform() const
 {
 	return m_pTransform;
@@ -332,54 +448,6 @@ void leap::GameObject::OnDisable() const
 	for (const auto& [pComponent, id] : m_Components) pComponent->OnDisable();
 }
 
-void leap::GameObject::Update() const
-{
-	// Delegate Update method to the components
-	for (const auto& [pComponent, id] : m_Components) pComponent->Update();
-
-	// Delegate Update method to the children
-	for (const auto& pChild : m_pChildren)
-	{
-		if (pChild) pChild->Update();
-	}
-}
-
-void leap::GameObject::FixedUpdate() const
-{
-	// Delegate FixedUpdate method to the components
-	for (const auto& [pComponent, id] : m_Components) pComponent->FixedUpdate();
-
-	// Delegate FixedUpdate method to the children
-	for (const auto& pChild : m_pChildren)
-	{
-		if (pChild) pChild->FixedUpdate();
-	}
-}
-
-void leap::GameObject::LateUpdate() const
-{
-	// Delegate LateUpdate method to the components
-	for (const auto& [pComponent, id] : m_Components) pComponent->LateUpdate();
-
-	// Delegate LateUpdate method to the children
-	for (const auto& pChild : m_pChildren)
-	{
-		if (pChild) pChild->LateUpdate();
-	}
-}
-
-void leap::GameObject::OnGUI() const
-{
-	// Delegate OnGUI method to the components
-	for (const auto& [pComponent, id] : m_Components) pComponent->OnGUI();
-
-	// Delegate OnGUI method to the children
-	for (const auto& pChild : m_pChildren)
-	{
-		pChild->OnGUI();
-	}
-}
-
 void leap::GameObject::OnDestroy() const
 {
 	// Delegate OnDestroy method to the components
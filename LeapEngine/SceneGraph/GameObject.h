@@ -1,9 +1,17 @@
 #pragma once
 
 #include "../Components/Component.h"
+#include "../Components/ComponentType.h"
+#include "Handle.h"
 #include "Debug.h"
 #include "ReflectionUtils.h"
+#include "StringTable.h"
 
+#include "../Memory/ObjectPool.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -14,20 +22,21 @@ namespace leap
 	class Scene;
 	class Collider;
 	class PhysicsSync;
+	class ComponentStorage;
+	class CommandBuffer;
+	class GameObjectIndex;
 
 	class GameObject final
 	{
 		struct ComponentInfo
 		{
-			std::unique_ptr<Component> pComponent;
-			unsigned int id;
+			PooledPtr<Component> pComponent;
+			uint32_t id;
 		};
 
-		static unsigned int m_TransformComponentID;
-
 	public:
-		GameObject(const char* name);
-		~GameObject() = default;
+		GameObject(const char* name, Scene* pScene);
+		~GameObject();
 
 		GameObject(const GameObject& other) = delete;
 		GameObject(GameObject&& other) = delete;
@@ -41,11 +50,18 @@ namespace leap
 		GameObject* GetChild(int index) const;
 		size_t GetChildCount() const { return m_pChildren.size(); };
 
-		void SetName(const char* name) { m_Name = name; }
+		/// <summary>
+		/// Names and tags are interned, comparing their IDs is the same as comparing the strings
+		/// The scene indexes the gameobjects on name and tag, so these can't be changed from a parallel Update
+		/// </summary>
+		void SetName(const char* name);
 		const char* GetName() const { return m_Name; };
+		StringID GetNameID() const { return m_NameID; }
 
-		void SetTag(const char* tag) { m_Tag = tag; }
+		void SetTag(const char* tag);
 		const char* GetTag() const { return m_Tag; }
+		StringID GetTagID() const { return m_TagID; }
+		bool CompareTag(StringID tagID) const { return m_TagID == tagID; }
 
 		void SetActive(bool isActive);
 		bool IsActive() const;
@@ -53,6 +69,8 @@ namespace leap
 		void Destroy();
 		bool IsMarkedAsDead() const;
 
+		Scene* GetScene() const { return m_pScene; }
+
 		template <class T>
 		T* AddComponent();
 		template <class T>
@@ -72,13 +90,19 @@ namespace leap
 	private:
 		friend Scene;
 		friend PhysicsSync;
+		friend CommandBuffer;
+		friend GameObjectIndex;
+		friend HandleTables;
+
+		/// <summary>
+		/// Internally used by the scene to move a gameobject to new memory, see Scene::Compact
+		/// The new gameobject takes over the children, components, handle and queued changes of pOther,
+		///		pOther is left empty and can be destroyed without side effects
+		/// </summary>
+		explicit GameObject(GameObject* pOther);
 
 		void OnEnable() const;
 		void OnDisable() const;
-		void Update() const;
-		void FixedUpdate() const;
-		void LateUpdate() const;
-		void OnGUI() const;
 		void OnDestroy() const;
 		void OnCollisionEnter(Collider* pCollider, Collider* pOther) const;
 		void OnCollisionStay(Collider* pCollider, Collider* pOther) const;
@@ -90,26 +114,30 @@ namespace leap
 		const char* GetRawName() const { return m_Name; };
 
 		/// <summary>
-		/// Internally used to initialize gameobjects/components and update their active state
-		/// This will call the Awake, Start, OnEnable and OnDisable methods
-		/// This is not leaked to components
+		/// The component lookup keeps a bit per component type and the index of the first component of every type that is present
+		/// FindComponentIndex is a bit test and an array lookup, UpdateComponentLookup is called after components were added or removed
 		/// </summary>
-		void OnFrameStart();
-		void MoveNewObjectsAndComponents();
-		void CallAwake() const;
-		void ChangeActiveState();
-		void SetWorldState(bool isActive);
-		void CallStart() const;
-		void CallEnableAndDisable() const;
+		uint32_t FindComponentIndex(uint32_t typeID) const;
+		uint32_t GetLookupTableIndex(uint32_t typeID) const;
+		void UpdateComponentLookup();
 
 		/// <summary>
-		/// Internally used to remove gameobjects/components
-		/// This will call OnDestroy methods
+		/// Internally used by the scene to handle the queued changes of this gameobject
+		/// Only gameobjects/components that were created, (de)activated or destroyed are visited
 		/// This is not leaked to components
 		/// </summary>
-		void OnFrameEnd();
-		void CheckDestroyFlag() const;
-		void UpdateCleanup();
+		void MoveNewObjectsAndComponents(ComponentStorage& storage, std::vector<Component*>& pNewComponents);
+		void ChangeActiveState(std::vector<Component*>& pChangedComponents);
+		void SetWorldState(bool isParentActive, std::vector<Component*>& pChangedComponents);
+		void RemoveDeadComponents(ComponentStorage& storage);
+		void RemoveDeadChildren(ComponentStorage& storage);
+		bool HasDeadAncestor() const;
+
+		/// <summary>
+		/// Internally used to add/remove the components of this gameobject and its children to/from a component storage
+		/// </summary>
+		void RegisterComponents(ComponentStorage& storage) const;
+		void UnregisterComponents(ComponentStorage& storage) const;
 
 		/// <summary>
 		/// These functions are internally used to 
@@ -120,45 +148,103 @@ namespace leap
 		void SetActiveLocal(bool isActive);
 		bool IsActiveWorld() const;
 		void SetActiveWorld(bool isActive);
+		bool IsWaitingToBeAdded() const;
+		void QueueNewContent();
+		static bool CanChangeStructure();
 
 		enum class StateFlags : char
 		{
 			IsActiveLocalNextFrame	= 1 << 0,
 			IsActiveLocal			= 1 << 1,
 			IsActiveWorld			= 1 << 2,
-			IsMarkedAsDead			= 1 << 3
+			IsMarkedAsDead			= 1 << 3,
+			IsQueuedForAdd			= 1 << 4,
+			IsQueuedForStateChange	= 1 << 5,
+			IsWaitingToBeAdded		= 1 << 6
 		};
 
 		unsigned char m_StateFlags{ static_cast<unsigned char>(StateFlags::IsActiveLocalNextFrame) };
 
+		// The interned strings of the name and tag
 		const char* m_Name{};
 		const char* m_Tag{};
+		StringID m_NameID{};
+		StringID m_TagID{};
+		// The position of this gameobject in the name and tag index of the scene
+		uint32_t m_NameSlot{};
+		uint32_t m_TagSlot{};
 
+		Scene* m_pScene{};
 		GameObject* m_pParent{};
 		Transform* m_pTransform{};
 
-		std::vector<std::unique_ptr<GameObject>> m_pChildrenToAdd{};
-		std::vector<std::unique_ptr<GameObject>> m_pChildren{};
+		std::vector<PooledPtr<GameObject>> m_pChildrenToAdd{};
+		std::vector<PooledPtr<GameObject>> m_pChildren{};
 
 		std::vector<ComponentInfo> m_ComponentsToAdd{};
 		std::vector<ComponentInfo> m_Components{};
+
+		static constexpr uint32_t m_InvalidComponentIndex{ 0xFFFFFFFF };
+		static constexpr uint32_t m_NrOfMaskWords{ ComponentType::m_MaxNrOfTypes / 64 };
+
+		std::array<uint64_t, m_NrOfMaskWords> m_ComponentMask{};
+		// Ordered on type ID, one index for every bit that is set in the mask
+		std::vector<uint32_t> m_ComponentIndices{};
+
+		// The slot of this gameobject in the handle table
+		uint32_t m_HandleIndex{ HandleTable::m_InvalidIndex };
 	};
 
+	inline uint32_t GameObject::FindComponentIndex(uint32_t typeID) const
+	{
+		// Types without a bit in the mask are searched for
+		if (typeID >= ComponentType::m_MaxNrOfTypes)
+		{
+			for (uint32_t i{}; i < m_Components.size(); ++i)
+			{
+				if (m_Components[i].id == typeID) return i;
+			}
+			return m_InvalidComponentIndex;
+		}
+
+		if ((m_ComponentMask[typeID / 64] & (uint64_t{ 1 } << (typeID % 64))) == 0) return m_InvalidComponentIndex;
+
+		return m_ComponentIndices[GetLookupTableIndex(typeID)];
+	}
+
+	inline uint32_t GameObject::GetLookupTableIndex(uint32_t typeID) const
+	{
+		// The amount of present types with a lower ID is the position in the index table
+		const uint32_t wordIdx{ typeID / 64 };
+		uint32_t tableIdx{ static_cast<uint32_t>(std::popcount(m_ComponentMask[wordIdx] & ((uint64_t{ 1 } << (typeID % 64)) - 1))) };
+		for (uint32_t i{}; i < wordIdx; ++i) tableIdx += static_cast<uint32_t>(std::popcount(m_ComponentMask[i]));
+
+		return tableIdx;
+	}
+
 	template<class T>
 	inline T* GameObject::AddComponent()
 	{
 		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
 
-		constexpr uint32_t componentID{ ReflectionUtils::GenerateTypenameHash<T>() };
-		if (componentID == m_TransformComponentID && HasComponent<T>())
+		if (!CanChangeStructure()) return nullptr;
+
+		const uint32_t componentID{ ComponentType::GetID<T>() };
+		if constexpr (std::is_same_v<T, Transform>)
 		{
-			Debug::LogError("LeapEngine Error: GameObject::AddComponent() > Can't add multiple Transforms");
-			return nullptr;
+			if (HasComponent<T>())
+			{
+				Debug::LogError("LeapEngine Error: GameObject::AddComponent() > Can't add multiple Transforms");
+				return nullptr;
+			}
 		}
 
-		ComponentInfo& CInfo{ m_ComponentsToAdd.emplace_back(std::make_unique<T>(), componentID) };
+		ComponentInfo& CInfo{ m_ComponentsToAdd.emplace_back(ObjectPools::GetInstance().Create<T>(), componentID) };
+		QueueNewContent();
 
 		CInfo.pComponent->SetOwner(this);
+		CInfo.pComponent->m_TickFlags = Component::GetTickFlags<T>();
+		CInfo.pComponent->m_TypeID = componentID;
 
 		return static_cast<T*>(CInfo.pComponent.get());
 	}
@@ -166,7 +252,9 @@ namespace leap
 	template<class T>
 	inline bool GameObject::HasComponent() const
 	{
-		return GetComponent<T>() != nullptr;
+		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
+
+		return FindComponentIndex(ComponentType::GetID<T>()) != m_InvalidComponentIndex;
 	}
 
 	template<class T>
@@ -174,18 +262,10 @@ namespace leap
 	{
 		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
 
-		constexpr uint32_t componentID{ ReflectionUtils::GenerateTypenameHash<T>() };
-
-		const auto iterator
-		{
-			std::find_if(m_Components.begin(), m_Components.end(),
-			[componentID](const ComponentInfo& CInfo)
-			{
-				return componentID == CInfo.id;
-			})
-		};
+		const uint32_t componentIdx{ FindComponentIndex(ComponentType::GetID<T>()) };
+		if (componentIdx == m_InvalidComponentIndex) return nullptr;
 
-		return iterator != m_Components.end() ? static_cast<T*>(iterator->pComponent.get()) : nullptr;
+		return static_cast<T*>(m_Components[componentIdx].pComponent.get());
 	}
 
 	template<class T>
@@ -194,13 +274,17 @@ namespace leap
 		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
 
 		std::vector<T*> pComponents{};
-		constexpr uint32_t componentID{ ReflectionUtils::GenerateTypenameHash<T>() };
 
-		for (const ComponentInfo& CInfo : m_Components)
+		const uint32_t componentID{ ComponentType::GetID<T>() };
+		const uint32_t firstComponentIdx{ FindComponentIndex(componentID) };
+		if (firstComponentIdx == m_InvalidComponentIndex) return pComponents;
+
+		// Components of the same type can't be stored before the first one
+		for (size_t i{ firstComponentIdx }; i < m_Components.size(); ++i)
 		{
-			if (componentID == CInfo.id)
+			if (componentID == m_Components[i].id)
 			{
-				pComponents.push_back(static_cast<T*>(CInfo.pComponent.get()));
+				pComponents.push_back(static_cast<T*>(m_Components[i].pComponent.get()));
 			}
 		}
 
@@ -212,13 +296,15 @@ namespace leap
 	{
 		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
 
-		GameObject* pParent{ GetParent() };
-		if (pParent == nullptr) return nullptr;
+		const uint32_t componentID{ ComponentType::GetID<T>() };
 
-		T* pComponent{ pParent->GetComponent<T>() };
-		if (pComponent != nullptr) return pComponent;
+		for (const GameObject* pParent{ GetParent() }; pParent != nullptr; pParent = pParent->GetParent())
+		{
+			const uint32_t componentIdx{ pParent->FindComponentIndex(componentID) };
+			if (componentIdx != m_InvalidComponentIndex) return static_cast<T*>(pParent->m_Components[componentIdx].pComponent.get());
+		}
 
-		return pParent->GetComponentInParent<T>();
+		return nullptr;
 	}
 
 	template<class T>
@@ -226,8 +312,7 @@ namespace leap
 	{
 		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
 
-		constexpr uint32_t componentID{ ReflectionUtils::GenerateTypenameHash<T>() };
-		if (componentID == m_TransformComponentID)
+		if constexpr (std::is_same_v<T, Transform>)
 		{
 			Debug::LogError("LeapEngine Error: GameObject::RemoveComponent() > Cannot manually remove Transform");
 			return;
@@ -241,15 +326,14 @@ namespace leap
 	{
 		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
 
-		constexpr uint32_t componentID{ ReflectionUtils::GenerateTypenameHash<T>() };
-		if (componentID == m_TransformComponentID)
+		if constexpr (std::is_same_v<T, Transform>)
 		{
 			Debug::LogError("LeapEngine Error: GameObject::RemoveComponent() > Cannot manually remove Transform");
 			return;
 		}
 
 		// Don't try to remove a component that is not on this gameobject
-		if (std::find_if(begin(m_Components), end(m_Components), [](const ComponentInfo& CInfo)
+		if (std::find_if(begin(m_Components), end(m_Components), [pComponent](const ComponentInfo& CInfo)
 			{ return CInfo.pComponent.get() == pComponent; }) == end(m_Components))
 		{
 			return;
@@ -0,0 +1,51 @@
+#include "GameObjectIndex.h"
+
+#include "GameObject.h"
+
+void leap::GameObjectIndex::Add(StringID id, GameObject* pObject)
+{
+	if (id == StringTable::m_InvalidID) return;
+
+	std::vector<GameObject*>& pObjects{ m_pObjects[id] };
+	pObject->*m_pSlot = static_cast<uint32_t>(pObjects.size());
+	pObjects.push_back(pObject);
+}
+
+void leap::GameObjectIndex::Remove(StringID id, GameObject* pObject)
+{
+	if (id == StringTable::m_InvalidID) return;
+
+	const auto it{ m_pObjects.find(id) };
+	if (it == m_pObjects.end()) return;
+
+	std::vector<GameObject*>& pObjects{ it->second };
+	const uint32_t slot{ pObject->*m_pSlot };
+	if (slot >= pObjects.size() || pObjects[slot] != pObject) return;
+
+	// Swap the last gameobject into the hole
+	GameObject* pLast{ pObjects.back() };
+	pObjects[slot] = pLast;
+	pLast->*m_pSlot = slot;
+	pObjects.pop_back();
+
+	// The empty list is kept, names and tags tend to be reused
+}
+
+void leap::GameObjectIndex::Replace(StringID id, const GameObject* pOldObject, GameObject* pNewObject)
+{
+	if (id == StringTable::m_InvalidID) return;
+
+	const auto it{ m_pObjects.find(id) };
+	if (it == m_pObjects.end()) return;
+
+	// The new gameobject has the same slot as the old one
+	std::vector<GameObject*>& pObjects{ it->second };
+	const uint32_t slot{ pNewObject->*m_pSlot };
+	if (slot < pObjects.size() && pObjects[slot] == pOldObject) pObjects[slot] = pNewObject;
+}
+
+const std::vector<leap::GameObject*>& leap::GameObjectIndex::Get(StringID id) const
+{
+	const auto it{ m_pObjects.find(id) };
+	return it != m_pObjects.end() ? it->second : m_Empty;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <StringTable.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace leap
+{
+	class GameObject;
+
+	/// <summary>
+	/// Maps a string ID (e.g. a name or a tag) to the gameobjects that use it
+	/// Every gameobject remembers its position in the list of its ID, so it can be removed in constant time
+	/// </summary>
+	class GameObjectIndex final
+	{
+	public:
+		/// <summary>
+		/// pSlot is the member of the gameobjects that stores their position in this index
+		/// </summary>
+		explicit GameObjectIndex(uint32_t GameObject::* pSlot) : m_pSlot{ pSlot } {}
+		~GameObjectIndex() = default;
+
+		GameObjectIndex(const GameObjectIndex& other) = delete;
+		GameObjectIndex(GameObjectIndex&& other) = delete;
+		GameObjectIndex& operator=(const GameObjectIndex& other) = delete;
+		GameObjectIndex& operator=(GameObjectIndex&& other) = delete;
+
+		void Add(StringID id, GameObject* pObject);
+		void Remove(StringID id, GameObject* pObject);
+
+		/// <summary>
+		/// Points the position of pOldObject to pNewObject, used when a gameobject is moved in memory
+		/// </summary>
+		void Replace(StringID id, const GameObject* pOldObject, GameObject* pNewObject);
+
+		/// <summary>
+		/// Returns the gameobjects with the given ID, the list is empty if there are none
+		/// </summary>
+		const std::vector<GameObject*>& Get(StringID id) const;
+
+	private:
+		uint32_t GameObject::* m_pSlot;
+		std::unordered_map<StringID, std::vector<GameObject*>> m_pObjects{};
+
+		inline static const std::vector<GameObject*> m_Empty{};
+	};
+}
\ No newline at end of file
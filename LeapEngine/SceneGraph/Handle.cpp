@@ -0,0 +1,52 @@
+#include "Handle.h"
+
+#include "GameObject.h"
+#include "../Components/Component.h"
+
+uint32_t leap::HandleTable::Add(void* pObject)
+{
+	++m_NrOfUsedSlots;
+
+	// Reuse a released slot, it keeps the generation it got when it was released
+	if (m_FirstFreeIndex != m_InvalidIndex)
+	{
+		const uint32_t index{ m_FirstFreeIndex };
+		Slot& slot{ m_Slots[index] };
+
+		m_FirstFreeIndex = slot.nextFreeIndex;
+		slot.pObject = pObject;
+		slot.nextFreeIndex = m_InvalidIndex;
+
+		return index;
+	}
+
+	m_Slots.emplace_back(Slot{ pObject });
+	return static_cast<uint32_t>(m_Slots.size() - 1);
+}
+
+void leap::HandleTable::Remove(uint32_t index)
+{
+	if (index >= m_Slots.size()) return;
+
+	Slot& slot{ m_Slots[index] };
+	if (slot.pObject == nullptr) return;
+
+	// Every handle to this object becomes stale
+	slot.pObject = nullptr;
+	++slot.generation;
+
+	slot.nextFreeIndex = m_FirstFreeIndex;
+	m_FirstFreeIndex = index;
+
+	--m_NrOfUsedSlots;
+}
+
+uint32_t leap::HandleTables::GetHandleIndex(const GameObject* pObject)
+{
+	return pObject->m_HandleIndex;
+}
+
+uint32_t leap::HandleTables::GetHandleIndex(const Component* pComponent)
+{
+	return pComponent->m_HandleIndex;
+}
\ No newline at end of file
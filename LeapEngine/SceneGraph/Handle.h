@@ -0,0 +1,158 @@
+#pragma once
+
+#include "Singleton.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace leap
+{
+	class GameObject;
+	class Component;
+
+	/// <summary>
+	/// Maps the index of a handle to the current address of a gameobject or component
+	/// A slot gets a new generation when its object is destroyed, so a handle to a destroyed object resolves to nullptr even after the slot is reused
+	/// The table is only changed from the main thread, resolving a handle is safe from a parallel Update
+	/// </summary>
+	class HandleTable final
+	{
+	public:
+		HandleTable() = default;
+		~HandleTable() = default;
+
+		HandleTable(const HandleTable& other) = delete;
+		HandleTable(HandleTable&& other) = delete;
+		HandleTable& operator=(const HandleTable& other) = delete;
+		HandleTable& operator=(HandleTable&& other) = delete;
+
+		static constexpr uint32_t m_InvalidIndex{ 0xFFFFFFFF };
+
+		uint32_t Add(void* pObject);
+		void Remove(uint32_t index);
+
+		/// <summary>
+		/// Changes the address a slot resolves to, used when an object gets moved in memory
+		/// </summary>
+		void Relocate(uint32_t index, void* pObject) { m_Slots[index].pObject = pObject; }
+
+		/// <summary>
+		/// Returns the object in the slot, or nullptr if the index is invalid or the generation doesn't match (the object was destroyed)
+		/// </summary>
+		void* Resolve(uint32_t index, uint32_t generation) const;
+		uint32_t GetGeneration(uint32_t index) const { return m_Slots[index].generation; }
+
+		size_t GetNrOfUsedSlots() const { return m_NrOfUsedSlots; }
+
+	private:
+		struct Slot final
+		{
+			void* pObject{};
+			uint32_t generation{};
+			uint32_t nextFreeIndex{ m_InvalidIndex };
+		};
+
+		std::vector<Slot> m_Slots{};
+		uint32_t m_FirstFreeIndex{ m_InvalidIndex };
+		size_t m_NrOfUsedSlots{};
+	};
+
+	inline void* HandleTable::Resolve(uint32_t index, uint32_t generation) const
+	{
+		if (index >= m_Slots.size()) return nullptr;
+
+		const Slot& slot{ m_Slots[index] };
+		return slot.generation == generation ? slot.pObject : nullptr;
+	}
+
+	/// <summary>
+	/// Owns the handle table of the gameobjects and the handle table of the components
+	/// </summary>
+	class HandleTables final : public Singleton<HandleTables>
+	{
+	public:
+		virtual ~HandleTables() = default;
+		HandleTables(const HandleTables& other) = delete;
+		HandleTables(HandleTables&& other) = delete;
+		HandleTables& operator=(const HandleTables& other) = delete;
+		HandleTables& operator=(HandleTables&& other) = delete;
+
+		HandleTable& GetGameObjects() { return m_GameObjects; }
+		HandleTable& GetComponents() { return m_Components; }
+
+		/// <summary>
+		/// Returns the index of the slot of a gameobject or component
+		/// Defined out of line where both classes are complete, so Handle doesn't need them to be complete when it is declared
+		/// </summary>
+		static uint32_t GetHandleIndex(const GameObject* pObject);
+		static uint32_t GetHandleIndex(const Component* pComponent);
+
+	private:
+		friend Singleton;
+		HandleTables() = default;
+
+		HandleTable m_GameObjects{};
+		HandleTable m_Components{};
+	};
+
+	/// <summary>
+	/// A reference to a gameobject or component that stays valid when the object is moved in memory (see Scene::Compact)
+	///		and that resolves to nullptr once the object is destroyed
+	/// Store a handle instead of a raw pointer when the pointer is kept across frames
+	/// </summary>
+	template <class T>
+	class Handle final
+	{
+	public:
+		Handle() = default;
+		Handle(const T* pObject);
+
+		T* Get() const;
+		T* operator->() const { return Get(); }
+		explicit operator bool() const { return Get() != nullptr; }
+
+		bool operator==(const Handle& other) const = default;
+
+	private:
+		static HandleTable& GetTable();
+
+		uint32_t m_Index{ HandleTable::m_InvalidIndex };
+		uint32_t m_Generation{};
+	};
+
+	using GameObjectHandle = Handle<GameObject>;
+	template <class T>
+	using ComponentHandle = Handle<T>;
+
+	template <class T>
+	inline Handle<T>::Handle(const T* pObject)
+	{
+		if (pObject == nullptr) return;
+
+		m_Index = HandleTables::GetHandleIndex(pObject);
+		m_Generation = GetTable().GetGeneration(m_Index);
+	}
+
+	template <class T>
+	inline T* Handle<T>::Get() const
+	{
+		void* pObject{ GetTable().Resolve(m_Index, m_Generation) };
+
+		// The component table stores the address of the Component base
+		if constexpr (std::is_same_v<T, GameObject>) return static_cast<T*>(pObject);
+		else return static_cast<T*>(static_cast<Component*>(pObject));
+	}
+
+	template <class T>
+	inline HandleTable& Handle<T>::GetTable()
+	{
+		if constexpr (std::is_same_v<T, GameObject>) return HandleTables::GetInstance().GetGameObjects();
+		else
+		{
+			static_assert(std::is_base_of_v<Component, T>, "T needs to be a GameObject or derived from the Component class");
+			return HandleTables::GetInstance().GetComponents();
+		}
+	}
+}
\ No newline at end of file
@@ -1,17 +1,22 @@
 #include "Scene.h"
 
-#include <Interfaces/IPhysics.h>
-#include "../ServiceLocator/ServiceLocator.h"
+#include "../Jobs/JobSystem.h"
+#include "../GameContext/GameContext.h"
+#include "../GameContext/Timer.h"
+
+#include <algorithm>
 
 leap::Scene::Scene(const char* name)
 {
-	m_pRootObject = std::make_unique<GameObject>(name);
-	ServiceLocator::GetPhysics().CreateScene();
+	m_pRootObject = ObjectPools::GetInstance().Create<GameObject>(name, this);
 }
 
 leap::Scene::~Scene()
 {
 	m_pRootObject->OnDestroy();
+
+	// Nothing has to be dequeued anymore while the gameobjects get destroyed
+	m_PendingChanges.Clear();
 }
 
 leap::GameObject* leap::Scene::CreateGameObject(const char* name) const
@@ -22,9 +27,17 @@ leap::GameObject* leap::Scene::CreateGameObject(const char* name) const
 void leap::Scene::RemoveAll()
 {
 	m_pRootObject->OnDestroy();
+	m_ComponentStorage.Clear();
+
+	// RemoveAll can be called from a callback while the queues of this frame are being handled
+	m_PendingChanges.Clear();
+	m_ProcessingChanges.Clear();
+	m_pNewComponents.clear();
+	m_pObjectsToCleanup.clear();
+
 	const char* name = m_pRootObject->GetRawName();
 	m_pRootObject.reset();
-	m_pRootObject = std::make_unique<GameObject>(name);
+	m_pRootObject = ObjectPools::GetInstance().Create<GameObject>(name, this);
 }
 
 leap::GameObject* leap::Scene::GetRootObject() const
@@ -32,32 +45,334 @@ leap::GameObject* leap::Scene::GetRootObject() const
 	return m_pRootObject.get();
 }
 
-void leap::Scene::OnFrameStart() const
+leap::GameObject* leap::Scene::FindByName(const char* name) const
+{
+	const std::vector<GameObject*>& pObjects{ FindAllByName(name) };
+	return pObjects.empty() ? nullptr : pObjects.front();
+}
+
+leap::GameObject* leap::Scene::FindWithTag(const char* tag) const
+{
+	const std::vector<GameObject*>& pObjects{ FindAllWithTag(tag) };
+	return pObjects.empty() ? nullptr : pObjects.front();
+}
+
+const std::vector<leap::GameObject*>& leap::Scene::FindAllByName(const char* name) const
+{
+	// A string that isn't interned can't be the name of a gameobject
+	return m_ObjectsByName.Get(StringTable::GetInstance().Find(name));
+}
+
+const std::vector<leap::GameObject*>& leap::Scene::FindAllWithTag(const char* tag) const
+{
+	return m_ObjectsByTag.Get(StringTable::GetInstance().Find(tag));
+}
+
+void leap::Scene::SetComponentsGroupedByType(bool isGroupedByType)
+{
+	if (isGroupedByType == m_ComponentStorage.IsGroupedByType()) return;
+
+	// Add all the components again in their new grouping, new components are added when they get moved into their gameobject
+	m_ComponentStorage.SetGroupedByType(isGroupedByType);
+	m_pRootObject->RegisterComponents(m_ComponentStorage);
+}
+
+void leap::Scene::OnFrameStart()
+{
+	// Only the queued changes are handled, changes made by the callbacks below get queued for the next frame
+	std::vector<GameObject*>& pObjectsToAdd{ m_ProcessingChanges.pObjectsToAdd };
+	pObjectsToAdd.swap(m_PendingChanges.pObjectsToAdd);
+
+	// Move the new children and components into their gameobject and add the components to the tick lists
+	for (GameObject* pObject : pObjectsToAdd)
+	{
+		pObject->m_StateFlags &= ~static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForAdd);
+		pObject->MoveNewObjectsAndComponents(m_ComponentStorage, m_pNewComponents);
+	}
+	pObjectsToAdd.clear();
+
+	// Call Awake on the new components
+	for (Component* pComponent : m_pNewComponents)
+	{
+		pComponent->Initialize();
+		pComponent->Awake();
+	}
+
+	// The active state of the new components still needs to be applied
+	for (Component* pComponent : m_pNewComponents) QueueActiveStateChange(pComponent);
+	m_pNewComponents.clear();
+
+	// Update the local and world active states, this includes the changes made in Awake
+	std::vector<GameObject*>& pObjectStateChanges{ m_ProcessingChanges.pObjectStateChanges };
+	std::vector<Component*>& pChangedComponents{ m_ProcessingChanges.pComponentStateChanges };
+	pObjectStateChanges.swap(m_PendingChanges.pObjectStateChanges);
+	pChangedComponents.swap(m_PendingChanges.pComponentStateChanges);
+
+	for (Component* pComponent : pChangedComponents)
+	{
+		pComponent->m_StateFlags &= ~static_cast<unsigned short>(Component::StateFlags::IsQueuedForStateChange);
+	}
+	for (GameObject* pObject : pObjectStateChanges)
+	{
+		pObject->m_StateFlags &= ~static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForStateChange);
+		pObject->ChangeActiveState(pChangedComponents);
+	}
+	pObjectStateChanges.clear();
+
+	// A component is queued more than once if both the component and its gameobject changed, only keep the first one
+	size_t nrOfChangedComponents{};
+	for (Component* pComponent : pChangedComponents)
+	{
+		constexpr unsigned short isBeingProcessed{ static_cast<unsigned short>(Component::StateFlags::IsBeingProcessed) };
+		if (pComponent->m_StateFlags & isBeingProcessed) continue;
+
+		pComponent->m_StateFlags |= isBeingProcessed;
+		pChangedComponents[nrOfChangedComponents++] = pComponent;
+	}
+	pChangedComponents.resize(nrOfChangedComponents);
+
+	for (Component* pComponent : pChangedComponents)
+	{
+		pComponent->ChangeActiveState();
+		m_ComponentRegistry.SetActive(pComponent, pComponent->IsActiveWorld());
+	}
+
+	// Call the start when needed
+	for (Component* pComponent : pChangedComponents) pComponent->TryCallStart();
+
+	// Call OnEnable and OnDisable when needed
+	for (Component* pComponent : pChangedComponents)
+	{
+		pComponent->TryCallEnableAndDisable();
+		pComponent->m_StateFlags &= ~static_cast<unsigned short>(Component::StateFlags::IsBeingProcessed);
+	}
+	pChangedComponents.clear();
+}
+
+void leap::Scene::FixedUpdate()
+{
+	m_TransformHierarchy.NotifyChanges();
+	m_TransformHierarchy.StorePreviousPoses();
+	m_ComponentStorage.FixedUpdate();
+}
+
+void leap::Scene::Update()
+{
+	m_TransformHierarchy.NotifyChanges();
+	m_ComponentStorage.Update();
+}
+
+void leap::Scene::LateUpdate()
+{
+	// Everything that moved during FixedUpdate and Update gets its world matrix recalculated before the renderers read it
+	m_TransformHierarchy.NotifyChanges();
+	m_TransformHierarchy.UpdateWorldTransforms(GameContext::GetInstance().GetTimer()->GetFixedTimeAlpha());
+
+	m_ComponentStorage.LateUpdate();
+}
+
+void leap::Scene::OnGUI()
 {
-	m_pRootObject->OnFrameStart();
+	// The last changes of this frame reach the listeners before the scene gets drawn
+	m_TransformHierarchy.NotifyChanges();
+	m_ComponentStorage.OnGUI();
 }
 
-void leap::Scene::FixedUpdate() const
+void leap::Scene::OnFrameEnd()
 {
-	m_pRootObject->FixedUpdate();
+	// Only the queued changes are handled, changes made by the callbacks below get queued for the next frame
+	std::vector<GameObject*>& pObjectsToDestroy{ m_ProcessingChanges.pObjectsToDestroy };
+	std::vector<Component*>& pComponentsToDestroy{ m_ProcessingChanges.pComponentsToDestroy };
+	pObjectsToDestroy.swap(m_PendingChanges.pObjectsToDestroy);
+	pComponentsToDestroy.swap(m_PendingChanges.pComponentsToDestroy);
+
+	// Gameobjects and components that are not moved into their parent yet are destroyed next frame, once they are
+	// Children and components of a destroyed gameobject are handled by that gameobject
+	std::erase_if(pObjectsToDestroy, [this](GameObject* pObject)
+		{
+			if (!pObject->IsWaitingToBeAdded()) return pObject->HasDeadAncestor();
+
+			m_PendingChanges.pObjectsToDestroy.push_back(pObject);
+			return true;
+		});
+	std::erase_if(pComponentsToDestroy, [this](Component* pComponent)
+		{
+			const GameObject* pOwner{ pComponent->GetGameObject() };
+			if (pComponent->IsInitialized()) return pOwner->IsMarkedAsDead() || pOwner->HasDeadAncestor();
+
+			m_PendingChanges.pComponentsToDestroy.push_back(pComponent);
+			return true;
+		});
+
+	// Call OnDestroy on the destroyed gameobjects (and their children) and components
+	for (const GameObject* pObject : pObjectsToDestroy) pObject->OnDestroy();
+	for (Component* pComponent : pComponentsToDestroy) pComponent->OnDestroy();
+
+	// Remove the destroyed components, every gameobject is only cleaned up once
+	for (Component* pComponent : pComponentsToDestroy) m_pObjectsToCleanup.push_back(pComponent->GetGameObject());
+	std::sort(begin(m_pObjectsToCleanup), end(m_pObjectsToCleanup));
+	m_pObjectsToCleanup.erase(std::unique(begin(m_pObjectsToCleanup), end(m_pObjectsToCleanup)), end(m_pObjectsToCleanup));
+
+	for (GameObject* pObject : m_pObjectsToCleanup) pObject->RemoveDeadComponents(m_ComponentStorage);
+	m_pObjectsToCleanup.clear();
+
+	// Remove the destroyed gameobjects, every parent is only cleaned up once
+	for (const GameObject* pObject : pObjectsToDestroy) m_pObjectsToCleanup.push_back(pObject->GetParent());
+	std::sort(begin(m_pObjectsToCleanup), end(m_pObjectsToCleanup));
+	m_pObjectsToCleanup.erase(std::unique(begin(m_pObjectsToCleanup), end(m_pObjectsToCleanup)), end(m_pObjectsToCleanup));
+
+	for (GameObject* pObject : m_pObjectsToCleanup) pObject->RemoveDeadChildren(m_ComponentStorage);
+	m_pObjectsToCleanup.clear();
+
+	pObjectsToDestroy.clear();
+	pComponentsToDestroy.clear();
+
+	if (m_IsCompactionRequested)
+	{
+		m_IsCompactionRequested = false;
+		CompactGameObjects();
+	}
 }
 
-void leap::Scene::Update() const
+void leap::Scene::CompactGameObjects()
 {
-	m_pRootObject->Update();
+	ObjectPool& pool{ ObjectPools::GetInstance().GetPool<GameObject>() };
+
+	// Every gameobject needs a new slot before the old slots are released
+	m_pObjectsToCompact.push_back(m_pRootObject.get());
+	for (size_t i{}; i < m_pObjectsToCompact.size(); ++i)
+	{
+		for (const auto& pChild : m_pObjectsToCompact[i]->m_pChildren) m_pObjectsToCompact.push_back(pChild.get());
+	}
+	pool.Reserve(m_pObjectsToCompact.size() - 1);
+	pool.SortFreeList();
+	m_pObjectsToCompact.clear();
+
+	// Breadth first, so the parents are moved before their children and every depth ends up after the previous one
+	m_pObjectsToCompact.push_back(m_pRootObject.get());
+	for (size_t i{}; i < m_pObjectsToCompact.size(); ++i)
+	{
+		for (auto& pChild : m_pObjectsToCompact[i]->m_pChildren)
+		{
+			GameObject* pOldObject{ pChild.get() };
+			GameObject* pNewObject{ new (pool.Allocate()) GameObject{ pOldObject } };
+
+			// The old slot is only released after all gameobjects are moved, otherwise the next gameobject would be moved into it
+			pChild.release();
+			pChild.reset(pNewObject);
+
+			m_pRelocatedObjects.push_back(pOldObject);
+			m_pObjectsToCompact.push_back(pNewObject);
+		}
+	}
+	m_pObjectsToCompact.clear();
+
+	for (GameObject* pOldObject : m_pRelocatedObjects)
+	{
+		pOldObject->~GameObject();
+		pool.Deallocate(pOldObject);
+	}
+	m_pRelocatedObjects.clear();
+
+	// New gameobjects fill the holes in memory order as well
+	pool.SortFreeList();
 }
 
-void leap::Scene::LateUpdate() const
+bool leap::Scene::CanChangeStructure()
 {
-	m_pRootObject->LateUpdate();
+	// The queues, pools and children aren't thread safe, parallel Updates can only change their own gameobject
+	if (!JobSystem::IsExecutingJob()) return true;
+
+	// Reported as a warning, an exception thrown on a worker thread would take down the whole engine
+	Debug::LogWarning("LeapEngine Warning: Gameobjects and components can't be created, destroyed, reparented or (de)activated from a job, the change is ignored. Record it in the CommandBuffer instead");
+	return false;
 }
 
-void leap::Scene::OnGUI() const
+void leap::Scene::QueueNewContent(GameObject* pObject)
 {
-	m_pRootObject->OnGUI();
+	constexpr unsigned char isQueued{ static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForAdd) };
+	if (pObject->m_StateFlags & isQueued) return;
+
+	pObject->m_StateFlags |= isQueued;
+	m_PendingChanges.pObjectsToAdd.push_back(pObject);
 }
 
-void leap::Scene::OnFrameEnd() const
+void leap::Scene::QueueActiveStateChange(GameObject* pObject)
 {
-	m_pRootObject->OnFrameEnd();
+	constexpr unsigned char isQueued{ static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForStateChange) };
+	if (pObject->m_StateFlags & isQueued) return;
+
+	pObject->m_StateFlags |= isQueued;
+	m_PendingChanges.pObjectStateChanges.push_back(pObject);
 }
+
+void leap::Scene::QueueActiveStateChange(Component* pComponent)
+{
+	constexpr unsigned short isQueued{ static_cast<unsigned short>(Component::StateFlags::IsQueuedForStateChange) };
+	if (pComponent->m_StateFlags & isQueued) return;
+
+	pComponent->m_StateFlags |= isQueued;
+	m_PendingChanges.pComponentStateChanges.push_back(pComponent);
+}
+
+void leap::Scene::QueueDestroy(GameObject* pObject)
+{
+	m_PendingChanges.pObjectsToDestroy.push_back(pObject);
+}
+
+void leap::Scene::QueueDestroy(Component* pComponent)
+{
+	m_PendingChanges.pComponentsToDestroy.push_back(pComponent);
+}
+
+void leap::Scene::Dequeue(GameObject* pObject)
+{
+	constexpr unsigned char queuedFlags
+	{
+		static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForAdd) 
+		| static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForStateChange) 
+		| static_cast<unsigned char>(GameObject::StateFlags::IsMarkedAsDead)
+	};
+	if ((pObject->m_StateFlags & queuedFlags) == 0) return;
+
+	std::erase(m_PendingChanges.pObjectsToAdd, pObject);
+	std::erase(m_PendingChanges.pObjectStateChanges, pObject);
+	std::erase(m_PendingChanges.pObjectsToDestroy, pObject);
+}
+
+void leap::Scene::Dequeue(Component* pComponent)
+{
+	constexpr unsigned short queuedFlags
+	{
+		static_cast<unsigned short>(Component::StateFlags::IsQueuedForStateChange) 
+		| static_cast<unsigned short>(Component::StateFlags::IsMarkedAsDead)
+	};
+	if ((pComponent->m_StateFlags & queuedFlags) == 0) return;
+
+	std::erase(m_PendingChanges.pComponentStateChanges, pComponent);
+	std::erase(m_PendingChanges.pComponentsToDestroy, pComponent);
+}
+
+void leap::Scene::Requeue(GameObject* pOldObject, GameObject* pNewObject)
+{
+	constexpr unsigned char queuedFlags
+	{
+		static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForAdd) 
+		| static_cast<unsigned char>(GameObject::StateFlags::IsQueuedForStateChange) 
+		| static_cast<unsigned char>(GameObject::StateFlags::IsMarkedAsDead)
+	};
+	if ((pNewObject->m_StateFlags & queuedFlags) == 0) return;
+
+	std::replace(begin(m_PendingChanges.pObjectsToAdd), end(m_PendingChanges.pObjectsToAdd), pOldObject, pNewObject);
+	std::replace(begin(m_PendingChanges.pObjectStateChanges), end(m_PendingChanges.pObjectStateChanges), pOldObject, pNewObject);
+	std::replace(begin(m_PendingChanges.pObjectsToDestroy), end(m_PendingChanges.pObjectsToDestroy), pOldObject, pNewObject);
+}
+
+void leap::Scene::ChangeQueues::Clear()
+{
+	pObjectsToAdd.clear();
+	pObjectStateChanges.clear();
+	pComponentStateChanges.clear();
+	pObjectsToDestroy.clear();
+	pComponentsToDestroy.clear();
+}
\ No newline at end of file
@@ -1,8 +1,13 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "GameObject.h"
+#include "ComponentStorage.h"
+#include "ComponentRegistry.h"
+#include "GameObjectIndex.h"
+#include "TransformHierarchy.h"
 
 namespace leap
 {
@@ -22,15 +27,131 @@ namespace leap
 		void RemoveAll();
 		GameObject* GetRootObject() const;
 
+		/// <summary>
+		/// Groups the tick lists of this scene per component type,
+		///		FixedUpdate, Update, LateUpdate and OnGUI are then called type by type instead of in the order the components were added
+		/// </summary>
+		void SetComponentsGroupedByType(bool isGroupedByType);
+		bool AreComponentsGroupedByType() const { return m_ComponentStorage.IsGroupedByType(); }
+
+		TransformHierarchy& GetTransformHierarchy() { return m_TransformHierarchy; }
+
+		/// <summary>
+		/// Returns one of the gameobjects with the given name or tag, or nullptr if there is none
+		/// The lookups are hashed and don't walk the scene, destroyed gameobjects are found until the end of the frame
+		/// </summary>
+		GameObject* FindByName(const char* name) const;
+		GameObject* FindWithTag(const char* tag) const;
+
+		/// <summary>
+		/// Returns all gameobjects with the given name or tag, the list is only valid until a name or tag changes or a gameobject gets created or destroyed
+		/// </summary>
+		const std::vector<GameObject*>& FindAllByName(const char* name) const;
+		const std::vector<GameObject*>& FindAllWithTag(const char* tag) const;
+
+		/// <summary>
+		/// Returns every component of type T in this scene without walking the scene, this doesn't allocate
+		/// Only components of exactly type T are returned (like GetComponent), inactive components are skipped unless requested
+		/// The components are added at the start of the frame after they were created, the range stays valid until the end of the frame
+		/// </summary>
+		template <class T>
+		ComponentRange<T> FindObjectsOfType(bool includeInactive = false) const;
+
+		/// <summary>
+		/// Calls function(T*) for every component of type T in this scene, see FindObjectsOfType
+		/// </summary>
+		template <class T, class Function>
+		void ForEach(const Function& function, bool includeInactive = false) const;
+
+		/// <summary>
+		/// Moves the gameobjects of this scene to the lowest free memory of their pool at the end of this frame, in breadth first order,
+		///		so iterating the hierarchy walks memory forward again after many gameobjects were created and destroyed
+		/// This invalidates every GameObject* that is kept across frames, keep a GameObjectHandle instead
+		/// Components are not moved, gameobjects that are not added to their parent yet are moved by a later compaction
+		/// </summary>
+		void Compact() { m_IsCompactionRequested = true; }
+
 	private:
+		/// <summary>
+		/// The gameobjects and components with changes that need to be handled at the start or the end of a frame
+		/// </summary>
+		struct ChangeQueues final
+		{
+			// Gameobjects with new children or components
+			std::vector<GameObject*> pObjectsToAdd{};
+			std::vector<GameObject*> pObjectStateChanges{};
+			std::vector<Component*> pComponentStateChanges{};
+			std::vector<GameObject*> pObjectsToDestroy{};
+			std::vector<Component*> pComponentsToDestroy{};
+
+			void Clear();
+		};
+
 		friend SceneManager;
-		void OnFrameStart() const;
-		void FixedUpdate() const;
-		void Update() const;
-		void LateUpdate() const;
-		void OnGUI() const;
-		void OnFrameEnd() const;
-
-		std::unique_ptr<GameObject> m_pRootObject{};
+		friend GameObject;
+		friend Component;
+
+		void OnFrameStart();
+		void FixedUpdate();
+		void Update();
+		void LateUpdate();
+		void OnGUI();
+		void OnFrameEnd();
+
+		/// <summary>
+		/// Internally used by gameobjects and components to queue their changes,
+		///		so the start and the end of a frame only visit what changed instead of the whole scene
+		/// Dequeue is used when a gameobject/component gets destroyed before its changes are handled
+		/// </summary>
+		void QueueNewContent(GameObject* pObject);
+		void QueueActiveStateChange(GameObject* pObject);
+		void QueueActiveStateChange(Component* pComponent);
+		void QueueDestroy(GameObject* pObject);
+		void QueueDestroy(Component* pComponent);
+		void Dequeue(GameObject* pObject);
+		void Dequeue(Component* pComponent);
+		void Requeue(GameObject* pOldObject, GameObject* pNewObject);
+
+		/// <summary>
+		/// Gameobjects and components can't be created, destroyed, reparented or (de)activated from a job
+		/// Such a change is reported and rejected before anything is modified, jobs record these changes in the CommandBuffer instead
+		/// </summary>
+		static bool CanChangeStructure();
+
+		void CompactGameObjects();
+
+		// The tick lists, queues and transform hierarchy are declared first, so they still exist while the gameobjects get destroyed
+		ComponentStorage m_ComponentStorage{};
+		ComponentRegistry m_ComponentRegistry{};
+		GameObjectIndex m_ObjectsByName{ &GameObject::m_NameSlot };
+		GameObjectIndex m_ObjectsByTag{ &GameObject::m_TagSlot };
+
+		// New changes get queued in m_PendingChanges while the changes of the previous frame are handled from m_ProcessingChanges
+		ChangeQueues m_PendingChanges{};
+		ChangeQueues m_ProcessingChanges{};
+		std::vector<Component*> m_pNewComponents{};
+		std::vector<GameObject*> m_pObjectsToCleanup{};
+
+		TransformHierarchy m_TransformHierarchy{};
+
+		bool m_IsCompactionRequested{};
+		std::vector<GameObject*> m_pObjectsToCompact{};
+		std::vector<GameObject*> m_pRelocatedObjects{};
+
+		PooledPtr<GameObject> m_pRootObject{};
 	};
+
+	template <class T>
+	inline ComponentRange<T> Scene::FindObjectsOfType(bool includeInactive) const
+	{
+		static_assert(std::is_base_of_v<Component, T>, "T needs to be derived from the Component class");
+
+		return m_ComponentRegistry.Get<T>(ComponentType::GetID<T>(), includeInactive);
+	}
+
+	template <class T, class Function>
+	inline void Scene::ForEach(const Function& function, bool includeInactive) const
+	{
+		for (T* pComponent : FindObjectsOfType<T>(includeInactive)) function(pComponent);
+	}
 }
\ No newline at end of file
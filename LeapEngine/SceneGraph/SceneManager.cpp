@@ -4,23 +4,105 @@
 
 #include "Debug.h"
 #include "Scene.h"
+#include "CommandBuffer.h"
+
+#include "../Memory/ObjectPool.h"
+#include "../ServiceLocator/ServiceLocator.h"
+
+#include <Interfaces/IRenderer.h>
+#include <Interfaces/IPhysics.h>
+
+leap::SceneManager::SceneManager()
+{
+	// The pools and handle tables need to outlive the active scene, so make sure they are constructed (and thus destroyed) first
+	ObjectPools::GetInstance();
+	HandleTables::GetInstance();
+}
+
+leap::SceneManager::~SceneManager()
+{
+	if (m_LoadingThread.joinable()) m_LoadingThread.join();
+}
 
 leap::Scene* leap::SceneManager::GetActiveScene() const
 {
 	return m_Scene.get();
 }
 
-void leap::SceneManager::AddScene(const char* name, const std::function<void(Scene&)>& load)
+void leap::SceneManager::AddScene(const char* name, const std::function<void(Scene&)>& load, const SceneAssets& assets)
 {
-	m_Scenes.emplace_back(SceneData{ name, load });
+	m_Scenes.emplace_back(SceneData{ name, load, assets });
 }
 
 void leap::SceneManager::LoadScene(unsigned index)
 {
 	m_LoadScene = static_cast<int>(index);
+
+	// The scene that is loaded asynchronously doesn't replace this one anymore
+	m_AsyncLoadScene = -1;
 }
 
 void leap::SceneManager::LoadScene(const std::string& name)
+{
+	const int index{ FindScene(name) };
+	if (index >= 0) LoadScene(static_cast<unsigned>(index));
+}
+
+void leap::SceneManager::LoadSceneAsync(unsigned index)
+{
+	if (index >= m_Scenes.size())
+	{
+		Debug::LogError("LeapEngine Error: LoadSceneAsync > The scene doesn't exist");
+		return;
+	}
+
+	if (IsLoadingAsync())
+	{
+		Debug::LogError("LeapEngine Error: LoadSceneAsync > Another scene is still loading");
+		return;
+	}
+
+	m_AsyncLoadScene = static_cast<int>(index);
+
+	// The loading thread gets its own copy of the paths, scenes can still be added while it runs
+	const SceneAssets& assets{ m_Scenes[index].assets };
+	m_NrOfAssetsToLoad = static_cast<uint32_t>(assets.meshes.size() + assets.textures.size());
+	m_NrOfLoadedAssets.store(0, std::memory_order_relaxed);
+	m_IsAssetLoadingDone.store(false, std::memory_order_relaxed);
+
+	m_LoadingThread = std::thread{ [this, assets]()
+		{
+			graphics::IRenderer& renderer{ ServiceLocator::GetRenderer() };
+
+			for (const std::string& mesh : assets.meshes)
+			{
+				renderer.PreloadMesh(mesh);
+				m_NrOfLoadedAssets.fetch_add(1, std::memory_order_relaxed);
+			}
+			for (const std::string& texture : assets.textures)
+			{
+				renderer.PreloadTexture(texture);
+				m_NrOfLoadedAssets.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			m_IsAssetLoadingDone.store(true, std::memory_order_release);
+		} };
+}
+
+void leap::SceneManager::LoadSceneAsync(const std::string& name)
+{
+	const int index{ FindScene(name) };
+	if (index >= 0) LoadSceneAsync(static_cast<unsigned>(index));
+}
+
+float leap::SceneManager::GetLoadProgress() const
+{
+	if (!IsLoadingAsync() || m_NrOfAssetsToLoad == 0) return 1.0f;
+
+	return static_cast<float>(m_NrOfLoadedAssets.load(std::memory_order_relaxed)) / static_cast<float>(m_NrOfAssetsToLoad);
+}
+
+int leap::SceneManager::FindScene(const std::string& name) const
 {
 	if (
 		const auto it = std::ranges::find_if(m_Scenes, [&](const auto& scene)
@@ -29,17 +111,29 @@ void leap::SceneManager::LoadScene(const std::string& name)
 			}); it != m_Scenes.end()
 		)
 	{
-		m_LoadScene = static_cast<int>(std::distance(m_Scenes.begin(), it));
-		return;
+		return static_cast<int>(std::distance(m_Scenes.begin(), it));
 	}
 
 	std::stringstream ss{};
 	ss << "LeapEngine Error: LoadScene failed to find a scene with name: " << name;
 	Debug::LogError(ss.str());
+	return -1;
+}
+
+void leap::SceneManager::FinishAsyncLoad()
+{
+	m_LoadingThread.join();
+
+	// Swap to the new scene, unless a LoadScene call replaced it
+	if (m_AsyncLoadScene >= 0) m_LoadScene = m_AsyncLoadScene;
+	m_AsyncLoadScene = -1;
 }
 
 void leap::SceneManager::OnFrameStart()
 {
+	// The scenes are only swapped at the start of a frame
+	if (IsLoadingAsync() && m_IsAssetLoadingDone.load(std::memory_order_acquire)) FinishAsyncLoad();
+
 	if (m_LoadScene >= 0) { LoadInternalScene(); }
 	m_Scene->OnFrameStart();
 }
@@ -79,11 +173,29 @@ void leap::SceneManager::LoadInternalScene()
 
 	const auto& sceneData = m_Scenes[m_LoadScene];
 	m_LoadScene = -1;
-	m_Scene = std::make_unique<Scene>(sceneData.name.c_str());
-	sceneData.load(*m_Scene);
+
+	// Recorded commands refer to the gameobjects of the previous scene
+	CommandBuffer::GetInstance().Clear();
+
+	// The running physics step belongs to the old scene, it has to finish before the new scene creates its physics objects
+	physics::IPhysics& physics{ ServiceLocator::GetPhysics() };
+	physics.FetchResults();
+
+	// The new scene is built while the old one still exists, the old one is only released once the new one is complete
+	// Building it doesn't touch the physics scene, the colliders only get their actors in the first physics step
+	std::unique_ptr<Scene> pNewScene{ std::make_unique<Scene>(sceneData.name.c_str()) };
+	sceneData.load(*pNewScene);
+
+	// The physics scene is replaced together with the scene
+	physics.CreateScene();
+
+	m_Scene.swap(pNewScene);
 }
 
 void leap::SceneManager::UnloadScene()
 {
+	// The loading thread uses the renderer, which gets destroyed after the scene
+	if (IsLoadingAsync()) m_LoadingThread.join();
+
 	m_Scene = nullptr;
 }
\ No newline at end of file
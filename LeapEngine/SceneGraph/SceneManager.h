@@ -1,29 +1,56 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <vector>
 #include <functional>
 #include <string>
+#include <thread>
 #include "Scene.h"
 #include "Singleton.h"
 
 namespace leap
 {
 	class LeapEngine;
+
+	/// <summary>
+	/// The assets of a scene that LoadSceneAsync decodes on a loading thread, before the load function of the scene is called
+	/// </summary>
+	struct SceneAssets final
+	{
+		std::vector<std::string> meshes{};
+		std::vector<std::string> textures{};
+	};
+
 	class SceneManager final : public Singleton<SceneManager>
 	{
 	public:
-		SceneManager() = default;
-		~SceneManager() override = default;
+		SceneManager();
+		~SceneManager() override;
 		SceneManager(const SceneManager& other) = delete;
 		SceneManager(SceneManager&& other) = delete;
 		SceneManager& operator=(const SceneManager& other) = delete;
 		SceneManager& operator=(SceneManager&& other) = delete;
 
 		Scene* GetActiveScene() const;
-		void AddScene(const char* name, const std::function<void(Scene&)>& load);
+		void AddScene(const char* name, const std::function<void(Scene&)>& load, const SceneAssets& assets = {});
 		void LoadScene(unsigned index);
 		void LoadScene(const std::string& name);
 
+		/// <summary>
+		/// Loads a scene without a hitch: the assets of the scene are decoded on a loading thread while the active scene keeps running,
+		///		the scenes are swapped at the start of the first frame after the assets are ready
+		/// The load function still builds the scene on the main thread, but the meshes and textures it loads are already in the renderer
+		/// Only one scene is loaded asynchronously at a time, a LoadScene call cancels the swap of a running asynchronous load
+		/// </summary>
+		void LoadSceneAsync(unsigned index);
+		void LoadSceneAsync(const std::string& name);
+		bool IsLoadingAsync() const { return m_LoadingThread.joinable(); }
+
+		/// <summary>
+		/// Returns the part of the assets that is loaded by the running asynchronous load, between 0 and 1 (1 when no scene is loading)
+		/// </summary>
+		float GetLoadProgress() const;
+
 	private:
 		friend LeapEngine;
 		void OnFrameStart();
@@ -35,14 +62,24 @@ namespace leap
 
 		void LoadInternalScene();
 		void UnloadScene();
+		int FindScene(const std::string& name) const;
+		void FinishAsyncLoad();
 
 		struct SceneData final
 		{
 			const std::string name;
 			std::function<void(Scene&)> load;
+			SceneAssets assets;
 		};
 		std::vector<SceneData> m_Scenes{};
 		std::unique_ptr<Scene> m_Scene{};
 		int m_LoadScene{ -1 };
+
+		// The loading thread of LoadSceneAsync, it only touches the renderer and the progress counters
+		std::thread m_LoadingThread{};
+		int m_AsyncLoadScene{ -1 };
+		uint32_t m_NrOfAssetsToLoad{};
+		std::atomic<uint32_t> m_NrOfLoadedAssets{};
+		std::atomic<bool> m_IsAssetLoadingDone{};
 	};
 }
\ No newline at end of file
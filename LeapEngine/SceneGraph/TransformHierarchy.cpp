@@ -0,0 +1,477 @@
+#include "TransformHierarchy.h"
+
+#include "GameObject.h"
+#include "../Components/Transform/Transform.h"
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEAP_TRANSFORM_SSE
+#include <emmintrin.h>
+#endif
+
+namespace leap
+{
+	template <class T>
+	static void ReorderValues(std::vector<T>& values, const std::vector<uint32_t>& sortedIndices)
+	{
+		std::vector<T> sortedValues{};
+		sortedValues.reserve(sortedIndices.size());
+
+		for (const uint32_t index : sortedIndices) sortedValues.push_back(values[index]);
+
+		values.swap(sortedValues);
+	}
+}
+
+void leap::TransformHierarchy::Add(Transform* pTransform)
+{
+	pTransform->m_pHierarchy = this;
+	pTransform->m_HierarchyIndex = static_cast<uint32_t>(m_pTransforms.size());
+
+	m_LocalPositions.emplace_back(0.0f);
+	m_LocalRotations.emplace_back(Quaternion::Identity());
+	m_LocalScales.emplace_back(1.0f);
+
+	m_WorldPositions.emplace_back(0.0f);
+	m_WorldRotations.emplace_back(Quaternion::Identity());
+	m_WorldScales.emplace_back(1.0f);
+	m_WorldMatrices.emplace_back(1.0f);
+
+	m_PreviousPositions.emplace_back(0.0f);
+	m_PreviousRotations.emplace_back(Quaternion::Identity());
+	m_RenderPositions.emplace_back(0.0f);
+	m_RenderRotations.emplace_back(Quaternion::Identity());
+	m_RenderMatrices.emplace_back(1.0f);
+	m_InterpolationFlags.push_back(0);
+
+	m_ParentIndices.push_back(m_InvalidIndex);
+	m_DirtyFlags.push_back(static_cast<uint8_t>(DirtyFlags::WorldTransform));
+	m_ChangeFlags.push_back(0);
+	m_pTransforms.push_back(pTransform);
+}
+
+void leap::TransformHierarchy::Remove(Transform* pTransform)
+{
+	const uint32_t index{ pTransform->m_HierarchyIndex };
+
+	if (m_ChangeFlags[index] & static_cast<uint8_t>(ChangeFlags::IsQueued))
+	{
+		m_pQueuedTransforms.erase(std::find(begin(m_pQueuedTransforms), end(m_pQueuedTransforms), pTransform));
+	}
+	m_ChangeFlags[index] = 0;
+
+	if (m_InterpolationFlags[index] & static_cast<uint8_t>(InterpolationFlags::IsInterpolated)) --m_NrOfInterpolatedTransforms;
+	m_InterpolationFlags[index] = 0;
+
+	// The slot is skipped until the next rebuild removes it
+	m_ParentIndices[index] = m_InvalidIndex;
+	StoreDirtyFlags(index, static_cast<uint8_t>(DirtyFlags::Unused));
+	m_pTransforms[index] = nullptr;
+	++m_NrOfUnusedSlots;
+
+	pTransform->m_pHierarchy = nullptr;
+}
+
+void leap::TransformHierarchy::SetParent(Transform* pTransform, Transform* pParent)
+{
+	const uint32_t index{ pTransform->m_HierarchyIndex };
+	const uint32_t parentIndex{ pParent ? pParent->m_HierarchyIndex : m_InvalidIndex };
+
+	m_ParentIndices[index] = parentIndex;
+
+	// The parent needs to be calculated first, so the arrays have to be sorted again before the next update
+	if (parentIndex != m_InvalidIndex && parentIndex > index) m_IsOrderInvalid = true;
+}
+
+void leap::TransformHierarchy::SetDescendantsDirty(Transform* pTransform)
+{
+	// Most transforms that move don't have children
+	if (pTransform->GetGameObject()->GetChildCount() == 0) return;
+
+	constexpr uint8_t allFlags{ static_cast<uint8_t>(DirtyFlags::All) };
+
+	// Jobs that modify their own gameobject dirty their descendants in parallel, so every thread walks with its own stack
+	// It keeps its capacity, so a steady state doesn't allocate
+	thread_local std::vector<Transform*> pTransformsToVisit{};
+	pTransformsToVisit.clear();
+	pTransformsToVisit.push_back(pTransform);
+
+	while (!pTransformsToVisit.empty())
+	{
+		GameObject* pObject{ pTransformsToVisit.back()->GetGameObject() };
+		pTransformsToVisit.pop_back();
+
+		for (int i{}; i < static_cast<int>(pObject->GetChildCount()); ++i)
+		{
+			Transform* pChild{ pObject->GetChild(i)->GetTransform() };
+
+			// Calculating a world transform cleans its parents first, so a fully dirty child only has fully dirty descendants
+			// The flags of a child are shared with the job of the child itself
+			const uint8_t previousFlags{ std::atomic_ref<uint8_t>{ m_DirtyFlags[pChild->m_HierarchyIndex] }.fetch_or(allFlags, std::memory_order_relaxed) };
+			if ((previousFlags & allFlags) == allFlags) continue;
+
+			pTransformsToVisit.push_back(pChild);
+		}
+	}
+}
+
+void leap::TransformHierarchy::QueueChange(Transform* pTransform, ChangeFlags change)
+{
+	constexpr uint8_t isQueued{ static_cast<uint8_t>(ChangeFlags::IsQueued) };
+
+	// Jobs that modify their own gameobject queue their changes in parallel, the flags of a transform are shared with the jobs of its parents
+	std::atomic_ref<uint8_t> flags{ m_ChangeFlags[pTransform->m_HierarchyIndex] };
+	const uint8_t previousFlags{ flags.fetch_or(static_cast<uint8_t>(change) | isQueued, std::memory_order_relaxed) };
+	if (previousFlags & isQueued) return;
+
+	const std::lock_guard lock{ m_QueueMutex };
+	m_pQueuedTransforms.push_back(pTransform);
+}
+
+void leap::TransformHierarchy::SetInterpolated(Transform* pTransform)
+{
+	const uint32_t index{ pTransform->m_HierarchyIndex };
+
+	uint8_t& flags{ m_InterpolationFlags[index] };
+	if (flags & static_cast<uint8_t>(InterpolationFlags::IsInterpolated)) return;
+
+	// Start without interpolating
+	m_PreviousPositions[index] = pTransform->GetWorldPosition();
+	m_PreviousRotations[index] = pTransform->GetWorldRotation();
+
+	flags |= static_cast<uint8_t>(InterpolationFlags::IsInterpolated);
+	++m_NrOfInterpolatedTransforms;
+}
+
+void leap::TransformHierarchy::StorePreviousPoses()
+{
+	if (m_NrOfInterpolatedTransforms == 0) return;
+
+	const size_t nrOfTransforms{ m_pTransforms.size() };
+	for (size_t i{}; i < nrOfTransforms; ++i)
+	{
+		if ((m_InterpolationFlags[i] & static_cast<uint8_t>(InterpolationFlags::IsInterpolated)) == 0) continue;
+
+		Transform* pTransform{ m_pTransforms[i] };
+		m_PreviousPositions[i] = pTransform->GetWorldPosition();
+		m_PreviousRotations[i] = pTransform->GetWorldRotation();
+	}
+}
+
+void leap::TransformHierarchy::NotifyChanges()
+{
+	if (m_pQueuedTransforms.empty()) return;
+
+	// Changes made by the listeners get notified after the next phase
+	m_pNotifyingTransforms.swap(m_pQueuedTransforms);
+	m_pChangedTransforms.clear();
+
+	constexpr uint8_t changes{ static_cast<uint8_t>(ChangeFlags::Changes) };
+	constexpr uint8_t notificationShift{ 4 };
+
+	// Collect the changed transforms and their descendants, every transform is visited once for every kind of change
+	for (Transform* pTransform : m_pNotifyingTransforms)
+	{
+		uint8_t& flags{ m_ChangeFlags[pTransform->m_HierarchyIndex] };
+		m_ChangesToVisit.emplace_back(pTransform, static_cast<uint8_t>(flags & changes));
+		flags &= ~(changes | static_cast<uint8_t>(ChangeFlags::IsQueued));
+
+		while (!m_ChangesToVisit.empty())
+		{
+			const auto [pVisited, change] { m_ChangesToVisit.back() };
+			m_ChangesToVisit.pop_back();
+
+			uint8_t& visitedFlags{ m_ChangeFlags[pVisited->m_HierarchyIndex] };
+			const uint8_t notifications{ static_cast<uint8_t>(change << notificationShift) };
+
+			const bool isInChangedList{ static_cast<bool>(visitedFlags & static_cast<uint8_t>(ChangeFlags::IsInChangedList)) };
+			if (isInChangedList && (visitedFlags & notifications) == notifications) continue;
+
+			visitedFlags |= notifications | static_cast<uint8_t>(ChangeFlags::IsInChangedList);
+			if (!isInChangedList) m_pChangedTransforms.push_back(pVisited);
+
+			// Every change of a parent moves its children, rotations and scales are passed on as well
+			const uint8_t childChange{ static_cast<uint8_t>(static_cast<uint8_t>(ChangeFlags::Position) | change) };
+
+			GameObject* pObject{ pVisited->GetGameObject() };
+			for (int i{}; i < static_cast<int>(pObject->GetChildCount()); ++i)
+			{
+				m_ChangesToVisit.emplace_back(pObject->GetChild(i)->GetTransform(), childChange);
+			}
+		}
+	}
+	m_pNotifyingTransforms.clear();
+
+	for (Transform* pTransform : m_pChangedTransforms)
+	{
+		uint8_t& flags{ m_ChangeFlags[pTransform->m_HierarchyIndex] };
+		const uint8_t notifications{ flags };
+		flags &= ~static_cast<uint8_t>(ChangeFlags::Notifications) & ~static_cast<uint8_t>(ChangeFlags::IsInChangedList);
+
+		if (notifications & static_cast<uint8_t>(ChangeFlags::NotifyPosition)) pTransform->OnPositionChanged.Notify();
+		if (notifications & static_cast<uint8_t>(ChangeFlags::NotifyRotation)) pTransform->OnRotationChanged.Notify();
+		if (notifications & static_cast<uint8_t>(ChangeFlags::NotifyScale)) pTransform->OnScaleChanged.Notify();
+	}
+
+	OnTransformsChanged.Notify(m_pChangedTransforms);
+}
+
+void leap::TransformHierarchy::UpdateWorldTransforms(float interpolationAlpha)
+{
+	if (m_IsOrderInvalid || m_NrOfUnusedSlots > std::max<size_t>(m_MinNrOfUnusedSlotsToCompact, m_pTransforms.size() / 4))
+	{
+		Rebuild();
+	}
+
+	constexpr uint8_t unusedFlag{ static_cast<uint8_t>(DirtyFlags::Unused) };
+	constexpr uint8_t changedFlag{ static_cast<uint8_t>(DirtyFlags::ChangedThisUpdate) };
+	constexpr uint8_t worldTransformFlags{ static_cast<uint8_t>(DirtyFlags::WorldTransform) };
+	constexpr uint8_t parentChangedFlags{ static_cast<uint8_t>(DirtyFlags::DirectionVectors) | static_cast<uint8_t>(DirtyFlags::EulerRotation) };
+
+	const size_t nrOfTransforms{ m_pTransforms.size() };
+	for (size_t i{}; i < nrOfTransforms; ++i)
+	{
+		const uint32_t index{ static_cast<uint32_t>(i) };
+		uint8_t flags{ LoadDirtyFlags(index) };
+		if (flags & unusedFlag) continue;
+
+		// Every parent is stored before its children, so it is already up to date
+		const uint32_t parentIndex{ m_ParentIndices[i] };
+		const bool hasParentChanged{ parentIndex != m_InvalidIndex && (LoadDirtyFlags(parentIndex) & changedFlag) };
+
+		if (!hasParentChanged && (flags & worldTransformFlags) == 0)
+		{
+			StoreDirtyFlags(index, flags & ~changedFlag);
+			continue;
+		}
+
+		if (parentIndex == m_InvalidIndex)
+		{
+			m_WorldPositions[i] = m_LocalPositions[i];
+			m_WorldRotations[i] = m_LocalRotations[i];
+			m_WorldScales[i] = m_LocalScales[i];
+		}
+		else
+		{
+			const glm::vec3& parentWorldPosition{ m_WorldPositions[parentIndex] };
+			const glm::quat& parentWorldRotation{ m_WorldRotations[parentIndex] };
+			const glm::vec3& parentWorldScale{ m_WorldScales[parentIndex] };
+
+			m_WorldPositions[i] = parentWorldPosition + (parentWorldRotation * (parentWorldScale * m_LocalPositions[i]));
+			m_WorldRotations[i] = parentWorldRotation * m_LocalRotations[i];
+			m_WorldScales[i] = parentWorldScale * m_LocalScales[i];
+		}
+
+		CalculateWorldMatrix(m_WorldPositions[i], m_WorldRotations[i], m_WorldScales[i], m_WorldMatrices[i]);
+
+		if (hasParentChanged) flags |= parentChangedFlags;
+		StoreDirtyFlags(index, (flags & ~worldTransformFlags) | changedFlag);
+	}
+
+	if (m_NrOfInterpolatedTransforms > 0) UpdateRenderTransforms(interpolationAlpha);
+}
+
+void leap::TransformHierarchy::UpdateRenderTransforms(float interpolationAlpha)
+{
+	constexpr uint8_t interpolatedFlag{ static_cast<uint8_t>(InterpolationFlags::IsInterpolated) };
+	constexpr uint8_t hasInterpolatedParentFlag{ static_cast<uint8_t>(InterpolationFlags::HasInterpolatedParent) };
+	constexpr uint8_t usesRenderTransformFlags{ static_cast<uint8_t>(InterpolationFlags::UsesRenderTransform) };
+
+	const size_t nrOfTransforms{ m_pTransforms.size() };
+	for (size_t i{}; i < nrOfTransforms; ++i)
+	{
+		if (m_pTransforms[i] == nullptr) continue;
+
+		// A parent can be reassigned, so the flag is refreshed every update
+		const uint32_t parentIndex{ m_ParentIndices[i] };
+		const bool hasInterpolatedParent{ parentIndex != m_InvalidIndex && (m_InterpolationFlags[parentIndex] & usesRenderTransformFlags) };
+
+		uint8_t& flags{ m_InterpolationFlags[i] };
+		flags = hasInterpolatedParent ? flags | hasInterpolatedParentFlag : flags & ~hasInterpolatedParentFlag;
+
+		if (flags & interpolatedFlag)
+		{
+			m_RenderPositions[i] = glm::mix(m_PreviousPositions[i], m_WorldPositions[i], interpolationAlpha);
+			m_RenderRotations[i] = glm::slerp(m_PreviousRotations[i], m_WorldRotations[i], interpolationAlpha);
+		}
+		else if (hasInterpolatedParent)
+		{
+			// Follow the interpolated pose of the parent
+			const glm::quat& parentRenderRotation{ m_RenderRotations[parentIndex] };
+
+			m_RenderPositions[i] = m_RenderPositions[parentIndex] + (parentRenderRotation * (m_WorldScales[parentIndex] * m_LocalPositions[i]));
+			m_RenderRotations[i] = parentRenderRotation * m_LocalRotations[i];
+		}
+		else continue;
+
+		CalculateWorldMatrix(m_RenderPositions[i], m_RenderRotations[i], m_WorldScales[i], m_RenderMatrices[i]);
+	}
+}
+
+void leap::TransformHierarchy::Rebuild()
+{
+	const uint32_t nrOfSlots{ static_cast<uint32_t>(m_pTransforms.size()) };
+
+	// Calculate the depth of every transform, walking up until a parent with a known depth is found
+	m_Depths.assign(nrOfSlots, m_InvalidIndex);
+	uint32_t maxDepth{};
+
+	for (uint32_t i{}; i < nrOfSlots; ++i)
+	{
+		if (m_pTransforms[i] == nullptr || m_Depths[i] != m_InvalidIndex) continue;
+
+		m_SortedIndices.clear();
+
+		uint32_t index{ i };
+		while (index != m_InvalidIndex && m_Depths[index] == m_InvalidIndex)
+		{
+			m_SortedIndices.push_back(index);
+			index = m_ParentIndices[index];
+		}
+
+		uint32_t depth{ index == m_InvalidIndex ? 0 : m_Depths[index] + 1 };
+		for (auto it{ m_SortedIndices.rbegin() }; it != m_SortedIndices.rend(); ++it)
+		{
+			m_Depths[*it] = depth++;
+		}
+
+		maxDepth = std::max(maxDepth, depth - 1);
+	}
+
+	// Counting sort on depth, transforms with the same depth keep their order
+	m_NewIndices.assign(maxDepth + 2, 0);
+	for (uint32_t i{}; i < nrOfSlots; ++i)
+	{
+		if (m_pTransforms[i]) ++m_NewIndices[m_Depths[i] + 1];
+	}
+	for (uint32_t depth{ 1 }; depth < m_NewIndices.size(); ++depth)
+	{
+		m_NewIndices[depth] += m_NewIndices[depth - 1];
+	}
+
+	m_SortedIndices.assign(nrOfSlots - m_NrOfUnusedSlots, 0);
+	for (uint32_t i{}; i < nrOfSlots; ++i)
+	{
+		if (m_pTransforms[i]) m_SortedIndices[m_NewIndices[m_Depths[i]]++] = i;
+	}
+
+	// Map the old indices to the new ones
+	m_NewIndices.assign(nrOfSlots, m_InvalidIndex);
+	for (uint32_t i{}; i < m_SortedIndices.size(); ++i)
+	{
+		m_NewIndices[m_SortedIndices[i]] = i;
+	}
+
+	ReorderValues(m_LocalPositions, m_SortedIndices);
+	ReorderValues(m_LocalRotations, m_SortedIndices);
+	ReorderValues(m_LocalScales, m_SortedIndices);
+	ReorderValues(m_WorldPositions, m_SortedIndices);
+	ReorderValues(m_WorldRotations, m_SortedIndices);
+	ReorderValues(m_WorldScales, m_SortedIndices);
+	ReorderValues(m_WorldMatrices, m_SortedIndices);
+	ReorderValues(m_PreviousPositions, m_SortedIndices);
+	ReorderValues(m_PreviousRotations, m_SortedIndices);
+	ReorderValues(m_RenderPositions, m_SortedIndices);
+	ReorderValues(m_RenderRotations, m_SortedIndices);
+	ReorderValues(m_RenderMatrices, m_SortedIndices);
+	ReorderValues(m_InterpolationFlags, m_SortedIndices);
+	ReorderValues(m_ParentIndices, m_SortedIndices);
+	ReorderValues(m_DirtyFlags, m_SortedIndices);
+	ReorderValues(m_ChangeFlags, m_SortedIndices);
+	ReorderValues(m_pTransforms, m_SortedIndices);
+
+	for (uint32_t i{}; i < m_pTransforms.size(); ++i)
+	{
+		uint32_t& parentIndex{ m_ParentIndices[i] };
+		if (parentIndex != m_InvalidIndex) parentIndex = m_NewIndices[parentIndex];
+
+		m_pTransforms[i]->m_HierarchyIndex = i;
+	}
+
+	m_NrOfUnusedSlots = 0;
+	m_IsOrderInvalid = false;
+}
+
+bool leap::TransformHierarchy::IsDirty(uint32_t index, DirtyFlags flag) const
+{
+	return LoadDirtyFlags(index) & static_cast<uint8_t>(flag);
+}
+
+void leap::TransformHierarchy::SetDirty(uint32_t index, DirtyFlags flag)
+{
+	std::atomic_ref<uint8_t>{ m_DirtyFlags[index] }.fetch_or(static_cast<uint8_t>(flag), std::memory_order_relaxed);
+}
+
+void leap::TransformHierarchy::ClearDirty(uint32_t index, DirtyFlags flag)
+{
+	// Only clears this flag, a flag that the job of a parent sets at the same time is kept
+	std::atomic_ref<uint8_t>{ m_DirtyFlags[index] }.fetch_and(static_cast<uint8_t>(~static_cast<uint8_t>(flag)), std::memory_order_relaxed);
+}
+
+uint8_t leap::TransformHierarchy::LoadDirtyFlags(uint32_t index) const
+{
+	return std::atomic_ref<uint8_t>{ const_cast<uint8_t&>(m_DirtyFlags[index]) }.load(std::memory_order_relaxed);
+}
+
+void leap::TransformHierarchy::StoreDirtyFlags(uint32_t index, uint8_t flags)
+{
+	std::atomic_ref<uint8_t>{ m_DirtyFlags[index] }.store(flags, std::memory_order_relaxed);
+}
+
+void leap::TransformHierarchy::CalculateWorldMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4x4& matrix)
+{
+	// Same result as translate(position) * mat4_cast(rotation) * scale(scale)
+#ifdef LEAP_TRANSFORM_SSE
+	const __m128 q{ _mm_set_ps(rotation.w, rotation.z, rotation.y, rotation.x) };
+	const __m128 q2{ _mm_add_ps(q, q) };
+
+	// Every column is (identity column) + a1 * b1 * signs1 + a2 * b2 * signs2, the w component gets masked out
+	const auto column
+	{
+		[&](__m128 identity, __m128 a1, __m128 b1, __m128 signs1, __m128 a2, __m128 b2, __m128 signs2, float columnScale)
+		{
+			__m128 result{ _mm_add_ps(identity, _mm_mul_ps(_mm_mul_ps(a1, b1), signs1)) };
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_mul_ps(a2, b2), signs2));
+			return _mm_mul_ps(result, _mm_set_ps(0.0f, columnScale, columnScale, columnScale));
+		}
+	};
+
+	// Shuffle indices: x = 0, y = 1, z = 2, w = 3
+	const __m128 column0
+	{
+		column(_mm_set_ps(0.0f, 0.0f, 0.0f, 1.0f),
+			_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 0, 0, 1)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 2, 1, 1)), _mm_set_ps(0.0f, 1.0f, 1.0f, -1.0f),
+			_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 3, 3, 2)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 1, 2, 2)), _mm_set_ps(0.0f, -1.0f, 1.0f, -1.0f),
+			scale.x)
+	};
+	const __m128 column1
+	{
+		column(_mm_set_ps(0.0f, 0.0f, 1.0f, 0.0f),
+			_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 1, 0, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 2, 0, 1)), _mm_set_ps(0.0f, 1.0f, -1.0f, 1.0f),
+			_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 3, 2, 3)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 0, 2, 2)), _mm_set_ps(0.0f, 1.0f, -1.0f, -1.0f),
+			scale.y)
+	};
+	const __m128 column2
+	{
+		column(_mm_set_ps(0.0f, 1.0f, 0.0f, 0.0f),
+			_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 0, 1, 0)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 0, 2, 2)), _mm_set_ps(0.0f, -1.0f, 1.0f, 1.0f),
+			_mm_shuffle_ps(q, q, _MM_SHUFFLE(0, 1, 3, 3)), _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 1, 0, 1)), _mm_set_ps(0.0f, -1.0f, -1.0f, 1.0f),
+			scale.z)
+	};
+
+	float* pMatrix{ &matrix[0][0] };
+	_mm_storeu_ps(pMatrix, column0);
+	_mm_storeu_ps(pMatrix + 4, column1);
+	_mm_storeu_ps(pMatrix + 8, column2);
+	_mm_storeu_ps(pMatrix + 12, _mm_set_ps(1.0f, position.z, position.y, position.x));
+#else
+	const glm::mat3x3 rotationMatrix{ glm::mat3_cast(rotation) };
+
+	matrix[0] = glm::vec4{ rotationMatrix[0] * scale.x, 0.0f };
+	matrix[1] = glm::vec4{ rotationMatrix[1] * scale.y, 0.0f };
+	matrix[2] = glm::vec4{ rotationMatrix[2] * scale.z, 0.0f };
+	matrix[3] = glm::vec4{ position, 1.0f };
+#endif
+}
\ No newline at end of file
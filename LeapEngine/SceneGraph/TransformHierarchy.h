@@ -0,0 +1,197 @@
+#pragma once
+
+#include "vec3.hpp"
+#include "mat4x4.hpp"
+#pragma warning(disable: 4201)
+#include "gtc/quaternion.hpp"
+#pragma warning(default: 4201)
+
+#include <Subject.h>
+
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace leap
+{
+	class Transform;
+	class Scene;
+
+	/// <summary>
+	/// TransformHierarchy stores the transforms of a scene as a structure of arrays
+	/// The arrays are sorted on depth, a parent is always stored before its children
+	/// UpdateWorldTransforms walks the arrays once from front to back and only recalculates the world transforms that are dirty,
+	///		every parent is done before its children so nothing has to be resolved recursively
+	/// The world matrices stay cached until the transform or one of its parents changes
+	/// Changes are collected and notified in one batch per phase, a transform that changes multiple times in a phase is only notified once
+	/// Transforms moved by fixed steps keep their previous pose, their render transform (and the one of their children)
+	///		is interpolated between the previous and the current pose
+	/// </summary>
+	class TransformHierarchy final
+	{
+	public:
+		TransformHierarchy() = default;
+		~TransformHierarchy() = default;
+
+		TransformHierarchy(const TransformHierarchy& other) = delete;
+		TransformHierarchy(TransformHierarchy&& other) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy& other) = delete;
+		TransformHierarchy& operator=(TransformHierarchy&& other) = delete;
+
+		size_t GetNrOfTransforms() const { return m_pTransforms.size() - m_NrOfUnusedSlots; }
+
+		/// <summary>
+		/// Notified once per phase with every transform that moved, rotated or scaled in world space during that phase,
+		///		this includes the children of the transforms that were changed
+		/// </summary>
+		TSubject<std::vector<Transform*>> OnTransformsChanged{};
+
+	private:
+		friend Transform;
+		friend Scene;
+		friend class GameObject;
+
+		static constexpr uint32_t m_InvalidIndex{ 0xFFFFFFFF };
+
+		// Rebuild the arrays once this many slots are unused
+		static constexpr uint32_t m_MinNrOfUnusedSlotsToCompact{ 64 };
+
+		enum class DirtyFlags : uint8_t
+		{
+			None				= 0,
+			Translation			= 1 << 0,
+			Rotation			= 1 << 1,
+			Scale				= 1 << 2,
+			DirectionVectors	= 1 << 3,
+			EulerRotation		= 1 << 4,
+			WorldMatrix			= 1 << 5,
+			// Set by UpdateWorldTransforms on the transforms it recalculated, so their children follow
+			ChangedThisUpdate	= 1 << 6,
+			Unused				= 1 << 7,
+
+			WorldTransform = Translation | Rotation | Scale | WorldMatrix,
+			All = Translation | Rotation | Scale | DirectionVectors | EulerRotation | WorldMatrix
+		};
+
+		enum class ChangeFlags : uint8_t
+		{
+			None				= 0,
+			// The changes made to the transform itself
+			Position			= 1 << 0,
+			Rotation			= 1 << 1,
+			Scale				= 1 << 2,
+			IsQueued			= 1 << 3,
+			// The changes that get notified, including the changes of the parents
+			NotifyPosition		= 1 << 4,
+			NotifyRotation		= 1 << 5,
+			NotifyScale			= 1 << 6,
+			IsInChangedList		= 1 << 7,
+
+			Changes = Position | Rotation | Scale,
+			Notifications = NotifyPosition | NotifyRotation | NotifyScale
+		};
+
+		enum class InterpolationFlags : uint8_t
+		{
+			None					= 0,
+			IsInterpolated			= 1 << 0,
+			HasInterpolatedParent	= 1 << 1,
+
+			UsesRenderTransform = IsInterpolated | HasInterpolatedParent
+		};
+
+		/// <summary>
+		/// Internally used by gameobjects to add/remove their transform and to keep the parent indices up to date
+		/// </summary>
+		void Add(Transform* pTransform);
+		void Remove(Transform* pTransform);
+		void SetParent(Transform* pTransform, Transform* pParent);
+
+		/// <summary>
+		/// Internally used by transforms
+		/// SetDescendantsDirty invalidates the world transform of every descendant,
+		///		it stops at descendants that are already dirty because their own descendants are dirty too
+		/// QueueChange remembers the change until the next NotifyChanges, this can be called from jobs that modify their own gameobject
+		/// </summary>
+		void SetDescendantsDirty(Transform* pTransform);
+		void QueueChange(Transform* pTransform, ChangeFlags change);
+
+		/// <summary>
+		/// SetInterpolated is internally used by transforms that get moved by fixed steps
+		/// StorePreviousPoses is internally used by the scene before every fixed step,
+		///		it keeps the current world pose of the interpolated transforms as the pose to interpolate from
+		/// </summary>
+		void SetInterpolated(Transform* pTransform);
+		void StorePreviousPoses();
+
+		/// <summary>
+		/// Internally used by the scene after every phase, notifies the listeners of every transform that changed and OnTransformsChanged
+		/// </summary>
+		void NotifyChanges();
+
+		/// <summary>
+		/// Internally used by the scene, recalculates every dirty world transform in one linear pass
+		/// The render transforms of the interpolated transforms are recalculated every time, interpolationAlpha is how far the
+		///		current frame is between the last fixed step and the next one
+		/// </summary>
+		void UpdateWorldTransforms(float interpolationAlpha);
+		void UpdateRenderTransforms(float interpolationAlpha);
+
+		/// <summary>
+		/// Removes the unused slots and sorts the transforms on depth again
+		/// </summary>
+		void Rebuild();
+
+		static void CalculateWorldMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale, glm::mat4x4& matrix);
+
+		/// <summary>
+		/// The dirty flags of a transform are set by the jobs of its parents while its own job reads and clears them,
+		///		so every access goes through an atomic_ref
+		/// </summary>
+		bool IsDirty(uint32_t index, DirtyFlags flag) const;
+		void SetDirty(uint32_t index, DirtyFlags flag);
+		void ClearDirty(uint32_t index, DirtyFlags flag);
+		uint8_t LoadDirtyFlags(uint32_t index) const;
+		void StoreDirtyFlags(uint32_t index, uint8_t flags);
+
+		std::vector<glm::vec3> m_LocalPositions{};
+		std::vector<glm::quat> m_LocalRotations{};
+		std::vector<glm::vec3> m_LocalScales{};
+
+		std::vector<glm::vec3> m_WorldPositions{};
+		std::vector<glm::quat> m_WorldRotations{};
+		std::vector<glm::vec3> m_WorldScales{};
+		std::vector<glm::mat4x4> m_WorldMatrices{};
+
+		// Only used by interpolated transforms and their children
+		std::vector<glm::vec3> m_PreviousPositions{};
+		std::vector<glm::quat> m_PreviousRotations{};
+		std::vector<glm::vec3> m_RenderPositions{};
+		std::vector<glm::quat> m_RenderRotations{};
+		std::vector<glm::mat4x4> m_RenderMatrices{};
+		std::vector<uint8_t> m_InterpolationFlags{};
+		uint32_t m_NrOfInterpolatedTransforms{};
+
+		std::vector<uint32_t> m_ParentIndices{};
+		std::vector<uint8_t> m_DirtyFlags{};
+		std::vector<uint8_t> m_ChangeFlags{};
+		std::vector<Transform*> m_pTransforms{};
+
+		uint32_t m_NrOfUnusedSlots{};
+		// A transform got a parent that is stored after it
+		bool m_IsOrderInvalid{};
+
+		// Transforms get queued in m_pQueuedTransforms while the changes of the previous phase are notified
+		std::mutex m_QueueMutex{};
+		std::vector<Transform*> m_pQueuedTransforms{};
+		std::vector<Transform*> m_pNotifyingTransforms{};
+		std::vector<Transform*> m_pChangedTransforms{};
+		std::vector<std::pair<Transform*, uint8_t>> m_ChangesToVisit{};
+
+		// Reused every rebuild
+		std::vector<uint32_t> m_Depths{};
+		std::vector<uint32_t> m_NewIndices{};
+		std::vector<uint32_t> m_SortedIndices{};
+	};
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Interfaces/IAudioSystem.h"
 #include "Interfaces/IRenderer.h"
 #include "Interfaces/IPhysics.h"
+#include "../Jobs/JobSystem.h"
 
 std::unique_ptr<leap::audio::DefaultAudioSystem> leap::ServiceLocator::m_pDefaultAudioSystem{ std::make_unique<leap::audio::DefaultAudioSystem>() };
 std::unique_ptr<leap::audio::IAudioSystem> leap::ServiceLocator::m_pAudioSystem{};
@@ -10,6 +11,7 @@ std::unique_ptr<leap::graphics::DefaultRenderer> leap::ServiceLocator::m_pDefaul
 std::unique_ptr<leap::graphics::IRenderer> leap::ServiceLocator::m_pRenderer{};
 std::unique_ptr<leap::physics::DefaultPhysics> leap::ServiceLocator::m_pDefaultPhysics{ std::make_unique<leap::physics::DefaultPhysics>() };
 std::unique_ptr<leap::physics::IPhysics> leap::ServiceLocator::m_pPhysics{};
+std::unique_ptr<leap::JobSystem> leap::ServiceLocator::m_pJobSystem{};
 
 leap::audio::IAudioSystem& leap::ServiceLocator::GetAudio()
 {
@@ -25,3 +27,23 @@ leap::physics::IPhysics& leap::ServiceLocator::GetPhysics()
 {
 	return m_pPhysics.get() == nullptr ? *m_pDefaultPhysics : *m_pPhysics;
 }
+
+
+leap::JobSystem& leap::ServiceLocator::GetJobSystem()
+{
+	// The worker threads are only started once the job system is needed
+	if (m_pJobSystem.get() == nullptr) m_pJobSystem = std::make_unique<JobSystem>();
+	return *m_pJobSystem;
+}
+
+void leap::ServiceLocator::RegisterJobSystem(unsigned int nrOfWorkerThreads)
+{
+	RegisterJobSystem(nrOfWorkerThreads, JobWorkerSettings{});
+}
+
+void leap::ServiceLocator::RegisterJobSystem(unsigned int nrOfWorkerThreads, const JobWorkerSettings& settings)
+{
+	// Stop the old workers first
+	m_pJobSystem.reset();
+	m_pJobSystem = std::make_unique<JobSystem>(nrOfWorkerThreads, settings);
+}
\ No newline at end of file
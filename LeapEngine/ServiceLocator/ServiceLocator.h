@@ -21,18 +21,29 @@ namespace leap
 		class DefaultPhysics;
 	}
 
+	class JobSystem;
+	struct JobWorkerSettings;
+
 	class ServiceLocator final
 	{
 	public:
 		static audio::IAudioSystem& GetAudio();
 		static graphics::IRenderer& GetRenderer();
 		static physics::IPhysics& GetPhysics();
+		static JobSystem& GetJobSystem();
 		template <typename T>
 		static void RegisterAudioSystem();
 		template <typename T>
 		static void RegisterRenderer(GLFWwindow* pWindow);
 		template <typename T>
 		static void RegisterPhysics();
+		/// <summary>
+		/// Replaces the job system with one that has nrOfWorkerThreads worker threads, 0 uses one per hardware thread except for the main thread
+		/// The settings pin the workers to hardware threads and set their priority, the physics engine runs its tasks on the same workers
+		/// Don't call this while jobs are running
+		/// </summary>
+		static void RegisterJobSystem(unsigned int nrOfWorkerThreads);
+		static void RegisterJobSystem(unsigned int nrOfWorkerThreads, const JobWorkerSettings& settings);
 	private:
 		static std::unique_ptr<audio::IAudioSystem> m_pAudioSystem;
 		static std::unique_ptr<audio::DefaultAudioSystem> m_pDefaultAudioSystem;
@@ -40,6 +51,7 @@ namespace leap
 		static std::unique_ptr<graphics::DefaultRenderer> m_pDefaultRenderer;
 		static std::unique_ptr<physics::IPhysics> m_pPhysics;
 		static std::unique_ptr<physics::DefaultPhysics> m_pDefaultPhysics;
+		static std::unique_ptr<JobSystem> m_pJobSystem;
 	};
 
 	template<typename T>
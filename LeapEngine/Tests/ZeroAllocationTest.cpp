@@ -0,0 +1,90 @@
+#include "../Leap.h"
+#include "../SceneGraph/SceneManager.h"
+#include "../SceneGraph/Scene.h"
+#include "../SceneGraph/GameObject.h"
+#include "../Components/Component.h"
+#include "../Components/Transform/Transform.h"
+#include "../Components/Physics/BoxCollider.h"
+#include "../Components/Physics/SphereCollider.h"
+#include "../Components/Physics/Rigidbody.h"
+#include "../GameContext/GameContext.h"
+#include "../GameContext/Timer.h"
+#include "../ServiceLocator/ServiceLocator.h"
+
+#include <Interfaces/IPhysics.h>
+#include <Interfaces/IPhysicsMaterial.h>
+
+#include <cstdio>
+
+// Runs a headless scene with physics, triggers and components that update on the worker threads for a fixed amount of frames
+// The test fails when a frame after the warm-up allocates on the heap
+
+namespace
+{
+	constexpr int g_NrOfBodies{ 50 };
+	constexpr unsigned int g_NrOfWarmupFrames{ 60 };
+	constexpr unsigned int g_NrOfFrames{ 300 };
+	constexpr int g_DesiredFPS{ 120 };
+
+	class Spinner final : public leap::Component
+	{
+	public:
+		// Only rotates its own transform, so it can be updated on the worker threads
+		static constexpr leap::UpdateAccess m_UpdateAccess{ leap::UpdateAccess::OwnGameObject };
+
+		Spinner() = default;
+		~Spinner() = default;
+
+		Spinner(const Spinner& other) = delete;
+		Spinner(Spinner&& other) = delete;
+		Spinner& operator=(const Spinner& other) = delete;
+		Spinner& operator=(Spinner&& other) = delete;
+
+	protected:
+		virtual void Update() override
+		{
+			GetTransform()->Rotate(0.0f, 90.0f * leap::GameContext::GetInstance().GetTimer()->GetDeltaTime(), 0.0f);
+		}
+	};
+
+	void LoadScene(leap::Scene& scene)
+	{
+		auto pBounceMaterial{ leap::ServiceLocator::GetPhysics().CreateMaterial() };
+		pBounceMaterial->SetBounciness(0.8f);
+
+		leap::GameObject* pGround{ scene.CreateGameObject("Ground") };
+		pGround->AddComponent<leap::BoxCollider>();
+		pGround->GetTransform()->Translate(0.0f, -1.5f, 0.0f);
+		pGround->GetTransform()->Scale(50.0f, 1.0f, 50.0f);
+
+		leap::GameObject* pTrigger{ scene.CreateGameObject("Trigger") };
+		leap::BoxCollider* pTriggerCollider{ pTrigger->AddComponent<leap::BoxCollider>() };
+		pTriggerCollider->SetSize(10.0f);
+		pTriggerCollider->SetTrigger(true);
+
+		for (int bodyIdx{}; bodyIdx < g_NrOfBodies; ++bodyIdx)
+		{
+			leap::GameObject* pBody{ scene.CreateGameObject("Body") };
+			pBody->AddComponent<leap::SphereCollider>()->SetMaterial(pBounceMaterial);
+			pBody->AddComponent<leap::Rigidbody>();
+			pBody->AddComponent<Spinner>();
+			pBody->GetTransform()->Translate(static_cast<float>(bodyIdx % 10) - 5.0f, 2.0f + static_cast<float>(bodyIdx / 10) * 2.0f, 0.0f);
+
+			// Every spinning body carries a child so the hierarchy gets dirtied from the worker threads
+			pBody->CreateChild("Child")->GetTransform()->Translate(0.0f, 1.0f, 0.0f);
+		}
+	}
+}
+
+int main()
+{
+	leap::LeapEngine engine{};
+	engine.SetZeroAllocationMode(true, g_NrOfWarmupFrames);
+
+	engine.Run([]() { leap::SceneManager::GetInstance().AddScene("Zero allocation test", LoadScene); }, g_DesiredFPS, g_NrOfFrames);
+
+	const unsigned int nrOfAllocatingFrames{ engine.GetNrOfAllocatingFrames() };
+	std::printf("%u of %u steady state frames allocated\n", nrOfAllocatingFrames, g_NrOfFrames - g_NrOfWarmupFrames);
+
+	return nrOfAllocatingFrames == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#include "../PhysX/PhysXEngine.h"
+#include "../Interfaces/IPhysicsObject.h"
+#include "../Interfaces/IShape.h"
+#include "../Data/Rigidbody.h"
+
+#include <Benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+// Measures the cost of a fixed step in a scene with 50k static colliders and 500 moving rigidbodies
+// The same 500 rigidbodies are first simulated without any static colliders, the step with the static colliders added
+//		should cost about the same because only the actors that moved are written back and static actors are never visited
+// The rigidbodies get a new velocity every step like a game would drive them, so they never fall asleep
+
+namespace
+{
+	constexpr uint32_t g_NrOfStaticColliders{ 50'000 };
+	constexpr uint32_t g_NrOfDynamicColliders{ 500 };
+	constexpr uint32_t g_NrOfWarmupSteps{ 30 };
+	constexpr uint32_t g_NrOfSteps{ 300 };
+	constexpr float g_FixedDeltaTime{ 1.0f / 50.0f };
+	constexpr float g_Spacing{ 4.0f };
+
+	class PhysicsScene final
+	{
+	public:
+		PhysicsScene(uint32_t nrOfStaticColliders, uint32_t nrOfDynamicColliders)
+			: m_Owners(nrOfStaticColliders + nrOfDynamicColliders)
+		{
+			m_Engine.SetSyncFunc([this](void*, const glm::vec3&, const glm::quat&) { ++m_NrOfWriteBacks; });
+			m_Engine.CreateScene();
+
+			m_pShapes.reserve(m_Owners.size());
+			m_pRigidbodies.reserve(nrOfDynamicColliders);
+
+			// The static colliders are laid out as a grid of floor tiles
+			const uint32_t gridSize{ static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(nrOfStaticColliders)))) };
+			for (uint32_t i{}; i < nrOfStaticColliders; ++i)
+			{
+				const glm::vec3 position{ (i % gridSize) * g_Spacing, 0.0f, (i / gridSize) * g_Spacing };
+				AddCollider(&m_Owners[i], position, leap::physics::EShape::Box);
+			}
+
+			// The rigidbodies move in a block above the middle of the grid
+			for (uint32_t i{}; i < nrOfDynamicColliders; ++i)
+			{
+				const glm::vec3 position{ (i % 25) * g_Spacing, 2.0f + (i / 25) * 0.1f, (i / 25) * g_Spacing };
+				void* pOwner{ &m_Owners[nrOfStaticColliders + i] };
+
+				AddCollider(pOwner, position, leap::physics::EShape::Sphere);
+				m_pRigidbodies.emplace_back(m_Engine.Get(pOwner)->SetRigidbody(true));
+			}
+		}
+
+		PhysicsScene(const PhysicsScene& other) = delete;
+		PhysicsScene(PhysicsScene&& other) = delete;
+		PhysicsScene& operator=(const PhysicsScene& other) = delete;
+		PhysicsScene& operator=(PhysicsScene&& other) = delete;
+
+		void Step(uint32_t stepIdx)
+		{
+			const float time{ stepIdx * g_FixedDeltaTime };
+			for (size_t i{}; i < m_pRigidbodies.size(); ++i)
+			{
+				const float angle{ time + static_cast<float>(i) };
+				m_pRigidbodies[i]->SetVelocity({ std::cos(angle) * 5.0f, 0.0f, std::sin(angle) * 5.0f });
+			}
+
+			m_Engine.Update(g_FixedDeltaTime);
+		}
+
+		void ResetNrOfWriteBacks() { m_NrOfWriteBacks = 0; }
+		uint64_t GetNrOfWriteBacks() const { return m_NrOfWriteBacks; }
+
+	private:
+		void AddCollider(void* pOwner, const glm::vec3& position, leap::physics::EShape shape)
+		{
+			std::unique_ptr<leap::physics::IShape> pShape{ m_Engine.CreateShape(pOwner, shape) };
+			if (shape == leap::physics::EShape::Box) pShape->SetSize({ g_Spacing * 0.9f, 1.0f, g_Spacing * 0.9f });
+			else pShape->SetRadius(0.5f);
+
+			leap::physics::IPhysicsObject* pObject{ m_Engine.Get(pOwner) };
+			pObject->AddShape(pShape.get());
+			pObject->SetTransform(position, glm::quat{ 1.0f, 0.0f, 0.0f, 0.0f });
+
+			m_pShapes.emplace_back(std::move(pShape));
+		}
+
+		// The engine is declared first so the shapes are released before it
+		leap::physics::PhysXEngine m_Engine{};
+		std::vector<char> m_Owners;
+		std::vector<std::unique_ptr<leap::physics::IShape>> m_pShapes{};
+		std::vector<leap::physics::Rigidbody*> m_pRigidbodies{};
+		uint64_t m_NrOfWriteBacks{};
+	};
+
+	// Returns the average duration of a step in milliseconds
+	double MeasureSteps(const char* pName, uint32_t nrOfStaticColliders)
+	{
+		PhysicsScene scene{ nrOfStaticColliders, g_NrOfDynamicColliders };
+
+		// The first step creates every actor, the steps after it let the broadphase settle
+		uint32_t stepIdx{};
+		for (; stepIdx < g_NrOfWarmupSteps; ++stepIdx) scene.Step(stepIdx);
+
+		scene.ResetNrOfWriteBacks();
+		const double durationMs{ leap::Benchmark::Measure(pName, 1, [&scene, &stepIdx]()
+			{
+				for (uint32_t i{}; i < g_NrOfSteps; ++i) scene.Step(stepIdx++);
+			}) };
+
+		std::printf("    %-48s %10.3f ms, %llu write-backs\n", "per step",
+			durationMs / g_NrOfSteps, static_cast<unsigned long long>(scene.GetNrOfWriteBacks() / g_NrOfSteps));
+
+		return durationMs / g_NrOfSteps;
+	}
+}
+
+int main()
+{
+	std::printf("%u rigidbodies, %u static colliders, %u steps of %.3f s\n", g_NrOfDynamicColliders, g_NrOfStaticColliders, g_NrOfSteps, g_FixedDeltaTime);
+	leap::Benchmark::PrintHeader("Fixed steps");
+
+	const double dynamicOnlyMs{ MeasureSteps("Rigidbodies only", 0) };
+	const double fullSceneMs{ MeasureSteps("Rigidbodies and static colliders", g_NrOfStaticColliders) };
+
+	leap::Benchmark::PrintHeader("Cost of the static colliders");
+	std::printf("    %-48s %8.2fx\n", "step with / step without", dynamicOnlyMs > 0.0 ? fullSceneMs / dynamicOnlyMs : 0.0);
+
+	return 0;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+namespace leap::physics
+{
+	struct PhysicsTaskTiming final
+	{
+		const char* pName{};
+		float durationMs{};
+	};
+}
\ No newline at end of file
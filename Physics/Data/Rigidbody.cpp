@@ -2,8 +2,9 @@
 
 #include <Quaternion.h>
 
-leap::physics::Rigidbody::Rigidbody(const std::function<void()>& rigidbodyRequestFunc)
+leap::physics::Rigidbody::Rigidbody(const std::function<void()>& rigidbodyRequestFunc, const std::function<void()>& dirtyFunc)
 	: m_UpdateRequestFunc{ rigidbodyRequestFunc }
+	, m_DirtyFunc{ dirtyFunc }
 {
 }
 
@@ -22,6 +23,10 @@ leap::physics::Rigidbody& leap::physics::Rigidbody::operator=(Rigidbody&& other)
 	m_Constraints = other.m_Constraints;
 
 	if (other.m_UpdateRequestFunc) m_UpdateRequestFunc = other.m_UpdateRequestFunc;
+	if (other.m_DirtyFunc) m_DirtyFunc = other.m_DirtyFunc;
+
+	// Settings that were made before the rigidbody was attached still need to reach the physics engine
+	if (IsDirty() && m_DirtyFunc) m_DirtyFunc();
 
 	return *this;
 }
@@ -115,11 +120,13 @@ const glm::vec3& leap::physics::Rigidbody::GetAngularVelocityFromEngine()
 void leap::physics::Rigidbody::AddForce(const glm::vec3& force, leap::physics::ForceMode mode)
 {
 	m_Forces.emplace_back(Force{ force, false, mode });
+	if (m_DirtyFunc) m_DirtyFunc();
 }
 
 void leap::physics::Rigidbody::AddTorque(const glm::vec3& torque, ForceMode mode)
 {
 	m_Forces.emplace_back(Force{ torque, true, mode });
+	if (m_DirtyFunc) m_DirtyFunc();
 }
 
 bool leap::physics::Rigidbody::IsDirty() const
@@ -152,4 +159,5 @@ void leap::physics::Rigidbody::SetAngularVelocityFromEngine(const glm::vec3& vel
 void leap::physics::Rigidbody::SetDirty(RigidbodyFlag flag)
 {
 	m_DirtyFlag = static_cast<RigidbodyFlag>(static_cast<unsigned int>(m_DirtyFlag) | static_cast<unsigned int>(flag));
+	if (m_DirtyFunc) m_DirtyFunc();
 }
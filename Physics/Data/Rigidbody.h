@@ -19,7 +19,7 @@ namespace leap::physics
 	{
 	public:
 		Rigidbody() = default;
-		Rigidbody(const std::function<void()>& rigidbodyRequestFunc);
+		Rigidbody(const std::function<void()>& rigidbodyRequestFunc, const std::function<void()>& dirtyFunc);
 
 		Rigidbody& operator=(const Rigidbody& other) = delete;
 		Rigidbody& operator=(Rigidbody&& other) noexcept;
@@ -106,5 +106,6 @@ namespace leap::physics
 		std::vector<Constraint> m_Constraints{};
 
 		std::function<void()> m_UpdateRequestFunc{};
+		std::function<void()> m_DirtyFunc{};
 	};
 }
\ No newline at end of file
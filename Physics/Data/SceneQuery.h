@@ -0,0 +1,80 @@
+#pragma once
+
+#include "RaycastHit.h"
+#include "../Interfaces/IShape.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <vec3.hpp>
+#pragma warning(disable: 4201)
+#include "gtc/quaternion.hpp"
+#pragma warning(default: 4201)
+
+namespace leap::physics
+{
+	struct RaycastQuery final
+	{
+		glm::vec3 start{};
+		// Needs to be normalized, the batch doesn't normalize it
+		glm::vec3 direction{};
+		float distance{};
+	};
+
+	// The geometry that is swept or overlapped, size is the full size of a box, radius and height are used by spheres and capsules
+	// A capsule stands upright along its y axis like a capsule shape
+	struct QueryShape final
+	{
+		EShape shape{ EShape::Sphere };
+		glm::vec3 size{ 1.0f, 1.0f, 1.0f };
+		float radius{ 0.5f };
+		float height{ 1.0f };
+	};
+
+	struct SweepQuery final
+	{
+		QueryShape shape{};
+		glm::vec3 position{};
+		glm::quat rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+		// Needs to be normalized, the batch doesn't normalize it
+		glm::vec3 direction{};
+		float distance{};
+	};
+
+	struct OverlapQuery final
+	{
+		QueryShape shape{};
+		glm::vec3 position{};
+		glm::quat rotation{ 1.0f, 0.0f, 0.0f, 0.0f };
+	};
+
+	// The hits of a query are stored next to each other in the hits of its batch
+	struct QueryResult final
+	{
+		uint32_t firstHit{};
+		uint32_t nrOfHits{};
+	};
+
+	// Queries that are executed together across the worker threads with IPhysics::ExecuteQueries
+	// Keep a batch around and refill it every frame, its vectors keep their capacity so executing it doesn't allocate once they are large enough
+	struct SceneQueryBatch final
+	{
+		static constexpr uint32_t AllLayers{ 0xFFFFFFFF };
+
+		std::vector<RaycastQuery> raycasts{};
+		std::vector<SweepQuery> sweeps{};
+		std::vector<OverlapQuery> overlaps{};
+
+		// A query only hits the shapes on the layers in this mask (bit n is layer n)
+		uint32_t layerMask{ AllLayers };
+		// 1 only returns the closest hit, more returns up to this many of the closest hits sorted by distance
+		// An overlap returns up to this many of the shapes it overlaps, in no particular order
+		uint32_t maxHitsPerQuery{ 1 };
+
+		// Filled when the batch is executed, result i belongs to query i
+		std::vector<QueryResult> raycastResults{};
+		std::vector<QueryResult> sweepResults{};
+		std::vector<QueryResult> overlapResults{};
+		std::vector<RaycastHit> hits{};
+	};
+}
\ No newline at end of file
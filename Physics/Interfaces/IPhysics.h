@@ -2,7 +2,10 @@
 
 #include "IShape.h"
 #include "IPhysicsMaterial.h"
+#include "IPhysicsTaskScheduler.h"
 #include "../Data/CollisionData.h"
+#include "../Data/PhysicsTaskTiming.h"
+#include "../Data/SceneQuery.h"
 
 #include <Subject.h>
 
@@ -24,16 +27,27 @@ namespace leap::physics
 	public:
 		virtual ~IPhysics() = default;
 
-		virtual void SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc, const std::function<std::pair<glm::vec3, glm::quat>(void*)> getFunc) = 0;
+		virtual void SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc) = 0;
 		virtual void Update(float fixedDeltaTime) = 0;
 
+		// In async mode Update starts the step and returns, the step runs while the game keeps going
+		// Its results are fetched at the start of the next Update or when FetchResults is called
+		virtual void SetAsyncSimulation(bool isAsync) = 0;
+		virtual bool IsSimulationAsync() const = 0;
+		virtual void FetchResults() = 0;
+
+		// Without a task scheduler the tasks of a step run on the thread that starts the step
+		virtual void SetTaskScheduler(std::unique_ptr<IPhysicsTaskScheduler> pScheduler) = 0;
+		// The time every task of the last fetched step took
+		virtual const std::vector<PhysicsTaskTiming>& GetTaskTimings() const = 0;
+
 		virtual void CreateScene() = 0;
 		virtual IPhysicsObject* Get(void* pOwner) = 0;
 		virtual std::unique_ptr<IShape> CreateShape(void* pOwner, EShape shape, IPhysicsMaterial* pMaterial = nullptr) = 0;
 		virtual std::shared_ptr<IPhysicsMaterial> CreateMaterial() = 0;
 
 		virtual void SetEnabledDebugDrawing(bool isEnabled) = 0;
-		virtual std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugDrawings() = 0;
+		virtual const std::vector<std::pair<glm::vec3, glm::vec3>>& GetDebugDrawings() = 0;
 
 		virtual TSubject<CollisionData>& OnCollisionEnter() = 0;
 		virtual TSubject<CollisionData>& OnCollisionStay() = 0;
@@ -43,6 +57,10 @@ namespace leap::physics
 		virtual TSubject<CollisionData>& OnTriggerExit() = 0;
 
 		virtual bool Raycast(const glm::vec3& start, const glm::vec3& direction, float distance, RaycastHit& hitInfo) = 0;
+
+		// Executes every query of the batch across the worker threads and fills in its results
+		// Batches can be executed from several threads at once, but not while the results of a step are fetched or objects are added
+		virtual void ExecuteQueries(SceneQueryBatch& batch) = 0;
 	};
 
 	class DefaultPhysics final : public IPhysics
@@ -50,16 +68,23 @@ namespace leap::physics
 	public:
 		virtual ~DefaultPhysics() = default;
 
-		virtual void SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>&, const std::function<std::pair<glm::vec3, glm::quat>(void*)>) override {};
+		virtual void SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>&) override {};
 		virtual void Update(float) override {}
 
+		virtual void SetAsyncSimulation(bool) override {}
+		virtual bool IsSimulationAsync() const override { return false; }
+		virtual void FetchResults() override {}
+
+		virtual void SetTaskScheduler(std::unique_ptr<IPhysicsTaskScheduler>) override {}
+		virtual const std::vector<PhysicsTaskTiming>& GetTaskTimings() const override { return m_EmptyTaskTimings; }
+
 		virtual void CreateScene() override {}
 		virtual IPhysicsObject* Get(void*) override { return nullptr; }
 		virtual std::unique_ptr<IShape> CreateShape(void*, EShape, IPhysicsMaterial*) override { return nullptr; }
 		virtual std::shared_ptr<IPhysicsMaterial> CreateMaterial() override { return nullptr; }
 
 		virtual void SetEnabledDebugDrawing(bool) override {}
-		virtual std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugDrawings() { return {}; }
+		virtual const std::vector<std::pair<glm::vec3, glm::vec3>>& GetDebugDrawings() override { return m_EmptyDebugDrawings; }
 
 		virtual TSubject<CollisionData>& OnCollisionEnter() override { return m_EmptyCollision; }
 		virtual TSubject<CollisionData>& OnCollisionStay() override { return m_EmptyCollision; }
@@ -69,8 +94,17 @@ namespace leap::physics
 		virtual TSubject<CollisionData>& OnTriggerExit() override { return m_EmptyCollision; }
 
 		virtual bool Raycast(const glm::vec3&, const glm::vec3&, float, RaycastHit&) override { return {}; }
+		virtual void ExecuteQueries(SceneQueryBatch& batch) override
+		{
+			batch.raycastResults.assign(batch.raycasts.size(), QueryResult{});
+			batch.sweepResults.assign(batch.sweeps.size(), QueryResult{});
+			batch.overlapResults.assign(batch.overlaps.size(), QueryResult{});
+			batch.hits.clear();
+		}
 
 	private:
 		TSubject<CollisionData> m_EmptyCollision{};
+		std::vector<std::pair<glm::vec3, glm::vec3>> m_EmptyDebugDrawings{};
+		std::vector<PhysicsTaskTiming> m_EmptyTaskTimings{};
 	};
 }
\ No newline at end of file
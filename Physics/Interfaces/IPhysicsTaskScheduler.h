@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace leap::physics
+{
+	// A task of the physics engine, Run is called once on a worker thread and doesn't block
+	class IPhysicsTask
+	{
+	public:
+		virtual void Run() = 0;
+
+	protected:
+		~IPhysicsTask() = default;
+	};
+
+	// Runs the tasks of the physics engine on the worker threads of the game so both share the same threads
+	class IPhysicsTaskScheduler
+	{
+	public:
+		virtual ~IPhysicsTaskScheduler() = default;
+
+		virtual void Schedule(IPhysicsTask* pTask) = 0;
+		virtual unsigned int GetNrOfWorkers() const = 0;
+
+		// Calls pFunction(pData, begin, end) for ranges of at most batchSize elements spread over the workers
+		// Returns once every range is done, the calling thread helps running them while it waits
+		virtual void ParallelFor(uint32_t nrOfElements, uint32_t batchSize, void (*pFunction)(void* pData, uint32_t begin, uint32_t end), void* pData) = 0;
+	};
+}
\ No newline at end of file
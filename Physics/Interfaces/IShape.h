@@ -23,6 +23,8 @@ namespace leap::physics
 		virtual void SetRadius(float radius) = 0;
 		virtual float GetVolume() = 0;
 		virtual void SetTrigger(bool isTrigger) = 0;
+		// Every shape starts on layer 0, scene queries can filter on layers 0 to 31
+		virtual void SetLayer(unsigned int layer) = 0;
 		
 		virtual void SetRelativeTransform(const glm::vec3& position, const glm::quat& rotation) = 0;
 		virtual glm::vec3 GetRelativePosition() = 0;
@@ -0,0 +1,86 @@
+#include "PhysXCpuDispatcher.h"
+
+#include <task/PxTask.h>
+
+#include <chrono>
+
+void leap::physics::PhysXCpuDispatcher::SetScheduler(std::unique_ptr<IPhysicsTaskScheduler> pScheduler)
+{
+	m_pScheduler = std::move(pScheduler);
+}
+
+void leap::physics::PhysXCpuDispatcher::submitTask(physx::PxBaseTask& task)
+{
+	if (getWorkerCount() == 0)
+	{
+		RunTask(task);
+		return;
+	}
+
+	Task* pTask{ AcquireTask() };
+	pTask->pTask = &task;
+
+	m_pScheduler->Schedule(pTask);
+}
+
+uint32_t leap::physics::PhysXCpuDispatcher::getWorkerCount() const
+{
+	return m_pScheduler ? m_pScheduler->GetNrOfWorkers() : 0;
+}
+
+void leap::physics::PhysXCpuDispatcher::CollectTaskTimings(std::vector<PhysicsTaskTiming>& timings)
+{
+	timings.clear();
+
+	const std::scoped_lock lock{ m_TaskTimingsMutex };
+	timings.swap(m_TaskTimings);
+}
+
+void leap::physics::PhysXCpuDispatcher::Task::Run()
+{
+	PhysXCpuDispatcher* pOwner{ pDispatcher };
+	physx::PxBaseTask* pPhysXTask{ pTask };
+
+	// Running a task can submit new tasks, so the wrapper is given back first
+	pOwner->ReleaseTask(this);
+	pOwner->RunTask(*pPhysXTask);
+}
+
+void leap::physics::PhysXCpuDispatcher::RunTask(physx::PxBaseTask& task)
+{
+	// The task can be reused by PhysX once it is released
+	const char* pName{ task.getName() };
+
+	const auto start{ std::chrono::steady_clock::now() };
+	task.run();
+	const auto end{ std::chrono::steady_clock::now() };
+
+	task.release();
+
+	const float durationMs{ std::chrono::duration<float, std::milli>(end - start).count() };
+
+	const std::scoped_lock lock{ m_TaskTimingsMutex };
+	m_TaskTimings.emplace_back(PhysicsTaskTiming{ pName, durationMs });
+}
+
+leap::physics::PhysXCpuDispatcher::Task* leap::physics::PhysXCpuDispatcher::AcquireTask()
+{
+	const std::scoped_lock lock{ m_TasksMutex };
+
+	if (m_pFreeTasks.empty())
+	{
+		Task* pTask{ m_pTasks.emplace_back(std::make_unique<Task>()).get() };
+		pTask->pDispatcher = this;
+		return pTask;
+	}
+
+	Task* pTask{ m_pFreeTasks.back() };
+	m_pFreeTasks.pop_back();
+	return pTask;
+}
+
+void leap::physics::PhysXCpuDispatcher::ReleaseTask(Task* pTask)
+{
+	const std::scoped_lock lock{ m_TasksMutex };
+	m_pFreeTasks.emplace_back(pTask);
+}
\ No newline at end of file
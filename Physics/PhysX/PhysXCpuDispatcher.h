@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../Interfaces/IPhysicsTaskScheduler.h"
+#include "../Data/PhysicsTaskTiming.h"
+
+#include <task/PxCpuDispatcher.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace leap::physics
+{
+	// Hands the tasks of PhysX to the task scheduler of the game
+	// Without a scheduler or without workers the tasks run right away on the thread that submits them
+	class PhysXCpuDispatcher final : public physx::PxCpuDispatcher
+	{
+	public:
+		PhysXCpuDispatcher() = default;
+		virtual ~PhysXCpuDispatcher() = default;
+
+		PhysXCpuDispatcher(const PhysXCpuDispatcher& other) = delete;
+		PhysXCpuDispatcher(PhysXCpuDispatcher&& other) = delete;
+		PhysXCpuDispatcher& operator=(const PhysXCpuDispatcher& other) = delete;
+		PhysXCpuDispatcher& operator=(PhysXCpuDispatcher&& other) = delete;
+
+		// Don't change the scheduler while a step is running
+		void SetScheduler(std::unique_ptr<IPhysicsTaskScheduler> pScheduler);
+
+		virtual void submitTask(physx::PxBaseTask& task) override;
+		virtual uint32_t getWorkerCount() const override;
+
+		// Calls function(begin, end) for ranges of at most batchSize elements spread over the workers of the scheduler
+		// Returns once every range is done, without workers all elements are handled on the calling thread
+		template <class Function>
+		void ParallelFor(uint32_t nrOfElements, uint32_t batchSize, const Function& function);
+
+		// Replaces timings with the timings of the tasks that ran since the last call
+		void CollectTaskTimings(std::vector<PhysicsTaskTiming>& timings);
+
+	private:
+		class Task final : public IPhysicsTask
+		{
+		public:
+			virtual void Run() override;
+
+			PhysXCpuDispatcher* pDispatcher{};
+			physx::PxBaseTask* pTask{};
+		};
+
+		void RunTask(physx::PxBaseTask& task);
+
+		// The wrappers are reused so submitting a task doesn't allocate once enough wrappers exist
+		Task* AcquireTask();
+		void ReleaseTask(Task* pTask);
+
+		std::unique_ptr<IPhysicsTaskScheduler> m_pScheduler{};
+
+		std::mutex m_TasksMutex{};
+		std::vector<std::unique_ptr<Task>> m_pTasks{};
+		std::vector<Task*> m_pFreeTasks{};
+
+		std::mutex m_TaskTimingsMutex{};
+		std::vector<PhysicsTaskTiming> m_TaskTimings{};
+	};
+
+	template <class Function>
+	inline void PhysXCpuDispatcher::ParallelFor(uint32_t nrOfElements, uint32_t batchSize, const Function& function)
+	{
+		if (getWorkerCount() == 0 || nrOfElements <= batchSize)
+		{
+			function(0u, nrOfElements);
+			return;
+		}
+
+		m_pScheduler->ParallelFor(nrOfElements, batchSize,
+			[](void* pData, uint32_t begin, uint32_t end) { (*static_cast<const Function*>(pData))(begin, end); },
+			const_cast<void*>(static_cast<const void*>(&function)));
+	}
+}
\ No newline at end of file
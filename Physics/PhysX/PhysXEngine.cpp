@@ -10,8 +10,9 @@
 #include "PhysXMaterial.h"
 #include "PhysXSimulationCallbacks.h"
 #include "PhysXSimulationFilterShader.h"
-#include "PhysXSimulationCallbacks.h"
+#include "PhysXCpuDispatcher.h"
 #include "../Data/SimulationEventData.h"
+#include "../Data/SceneQuery.h"
 
 #include <algorithm>
 
@@ -20,6 +21,7 @@ leap::physics::PhysXEngine::PhysXEngine()
     , m_pDefaultErrorCallback{ std::make_unique<physx::PxDefaultErrorCallback>() }
     , m_pSimulationCallbacks{ std::make_unique<PhysXSimulationCallbacks>() }
     , m_pSimulationFilterCallback{ std::make_unique<PhysXSimulationFilterCallback>() } 
+    , m_pDispatcher{ std::make_unique<PhysXCpuDispatcher>() }
 {
     m_pSimulationFilterCallback->OnSimulationEvent.AddListener(this);
     m_pSimulationCallbacks->OnSimulationEvent.AddListener(this);
@@ -54,9 +56,6 @@ leap::physics::PhysXEngine::PhysXEngine()
         Debug::LogError("PhysXEngine Error : PxCreateCooking failed");
         return;
     }
-
-    // Create a CPU dispatcher
-    m_pDispatcher = physx::PxDefaultCpuDispatcherCreate(2);
 }
 
 leap::physics::PhysXEngine::~PhysXEngine()
@@ -64,54 +63,115 @@ leap::physics::PhysXEngine::~PhysXEngine()
     m_pSimulationFilterCallback->OnSimulationEvent.RemoveListener(this);
     m_pSimulationCallbacks->OnSimulationEvent.RemoveListener(this);
 
+    // A running step has to finish before its scene and actors can be released
+    if (m_IsSimulating) m_pScene->FetchResults();
+
     m_pScene = nullptr;
     m_pObjects.clear();
 
-    m_pDispatcher->release();
     m_pCooking->release();
     m_pPhysics->release();
     m_pFoundation->release();
 }
 
-void leap::physics::PhysXEngine::SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc, const std::function<std::pair<glm::vec3, glm::quat>(void*)> getFunc)
+void leap::physics::PhysXEngine::SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc)
 {
-    m_SyncGetFunc = getFunc;
     m_SyncSetFunc = setFunc;
 }
 
 void leap::physics::PhysXEngine::Update(float fixedDeltaTime)
 {
-    // Update all the physics objects and apply updates
-    for (auto& pObject : m_pObjects)
+    // In async mode the previous step is still running, its results are applied before anything is pushed to PhysX
+    FetchResults();
+
+    // Only the objects that changed since the last step push their changes to PhysX
+    // Static actors and kinematic bodies are only moved when their owner moved, the owner sets their transform when that happens
+    // Objects that lost all their shapes and their rigidbody are not connected to a game object anymore and are removed
+    m_pUpdatedObjects.swap(m_pDirtyObjects);
+    for (PhysXObject*& pObject : m_pUpdatedObjects)
     {
-        pObject.second->Update(this, m_pScene.get());
+        pObject->Update(m_pScene.get());
+
+        if (!pObject->IsValid())
+        {
+            RemoveObject(pObject);
+            pObject = nullptr;
+        }
     }
 
-    // Erase all objects that are not connected anymore to a game object
-    std::erase_if(m_pObjects, [](const auto& pObject) { return !pObject.second->IsValid(); });
+    // Start simulating the physics scene
+    m_pScene->StartSimulate(fixedDeltaTime);
+    m_IsSimulating = true;
+
+    if (!m_IsSimulationAsync) FetchResults();
+}
+
+void leap::physics::PhysXEngine::SetAsyncSimulation(bool isAsync)
+{
+    if (!isAsync) FetchResults();
+    m_IsSimulationAsync = isAsync;
+}
 
-    // Simulate the physics scene
-    m_pScene->Simulate(fixedDeltaTime);
+void leap::physics::PhysXEngine::SetTaskScheduler(std::unique_ptr<IPhysicsTaskScheduler> pScheduler)
+{
+    FetchResults();
+    m_pDispatcher->SetScheduler(std::move(pScheduler));
+}
 
-    // Apply poses
-    for (auto& pObject : m_pObjects)
+void leap::physics::PhysXEngine::FetchResults()
+{
+    if (!m_IsSimulating) return;
+    m_IsSimulating = false;
+
+    // Waits for the step to finish
+    m_pScene->FetchResults();
+    m_pDispatcher->CollectTaskTimings(m_TaskTimings);
+
+    // All poses are written back at once on this thread, the game never sees a step that is partly applied
+    // Only the actors that moved during the step are written back to their owners
+    unsigned int nrOfActiveActors{};
+    physx::PxActor** ppActiveActors{ static_cast<PhysXScene*>(m_pScene.get())->GetActiveActors(nrOfActiveActors) };
+    for (unsigned int i{}; i < nrOfActiveActors; ++i)
     {
-        pObject.second->Apply(m_SyncSetFunc, m_SyncGetFunc);
+        static_cast<PhysXObject*>(ppActiveActors[i]->userData)->WriteBack(m_SyncSetFunc);
     }
 
+    // A sleeping rigidbody that was moved by its owner is not active, but its owner still needs the new pose
+    for (PhysXObject* pObject : m_pUpdatedObjects)
+    {
+        if (pObject) pObject->WriteBack(m_SyncSetFunc);
+    }
+    m_pUpdatedObjects.clear();
+
+    {
+        const std::scoped_lock lock{ m_SimulationEventsMutex };
+        m_DispatchedSimulationEvents.swap(m_SimulationEvents);
+    }
+    for (const SimulationEvent& e : m_DispatchedSimulationEvents)
+    {
+        DispatchSimulationEvent(e);
+    }
+    m_DispatchedSimulationEvents.clear();
+
     m_pSimulationFilterCallback->NotifyStayingPairs(); // OnCollisionStay
     m_pSimulationCallbacks->NotifyStayingPairs(); // OnTriggerStay
 }
 
 void leap::physics::PhysXEngine::CreateScene()
 {
+    // The running step belongs to the previous scene
+    FetchResults();
+
     physx::PxSceneDesc sceneDesc{ m_pPhysics->getTolerancesScale() };
     sceneDesc.gravity = physx::PxVec3{ 0.0f, -9.81f, 0.0f };
     sceneDesc.filterShader = PhysXSimulationFilterShader;
-    sceneDesc.cpuDispatcher = m_pDispatcher;
+    sceneDesc.cpuDispatcher = m_pDispatcher.get();
     sceneDesc.simulationEventCallback = m_pSimulationCallbacks.get();
     sceneDesc.filterCallback = m_pSimulationFilterCallback.get();
 
+    // Report the actors that moved during a step so only those are written back
+    sceneDesc.flags |= physx::PxSceneFlag::eENABLE_ACTIVE_ACTORS;
+
     physx::PxScene* pPhysXScene{ m_pPhysics->createScene(sceneDesc) };
 
     m_pScene = std::make_unique<PhysXScene>(pPhysXScene);
@@ -121,12 +181,11 @@ void leap::physics::PhysXEngine::CreateScene()
 
 leap::physics::IPhysicsObject* leap::physics::PhysXEngine::Get(void* pOwner)
 {
-    if (!m_pObjects.contains(pOwner))
-    {
-        m_pObjects[pOwner] = std::make_unique<PhysXObject>(pOwner);
-    }
+    const auto it{ m_ObjectIndices.find(pOwner) };
+    if (it != m_ObjectIndices.end()) return m_pObjects[it->second].get();
 
-    return m_pObjects[pOwner].get();
+    m_ObjectIndices.emplace(pOwner, m_pObjects.size());
+    return m_pObjects.emplace_back(std::make_unique<PhysXObject>(this, pOwner)).get();
 }
 
 std::unique_ptr<leap::physics::IShape> leap::physics::PhysXEngine::CreateShape(void* pOwner, physics::EShape shape, IPhysicsMaterial* pMaterial)
@@ -160,7 +219,7 @@ void leap::physics::PhysXEngine::SetEnabledDebugDrawing(bool isEnabled)
     m_IsDebugDrawingEnabled = isEnabled;
 }
 
-std::vector<std::pair<glm::vec3, glm::vec3>> leap::physics::PhysXEngine::GetDebugDrawings()
+const std::vector<std::pair<glm::vec3, glm::vec3>>& leap::physics::PhysXEngine::GetDebugDrawings()
 {
     return m_pScene->GetDebugDrawings();
 }
@@ -170,7 +229,83 @@ bool leap::physics::PhysXEngine::Raycast(const glm::vec3& start, const glm::vec3
     return m_pScene->Raycast(start, direction, distance, hitInfo);
 }
 
+void leap::physics::PhysXEngine::ExecuteQueries(SceneQueryBatch& batch)
+{
+    const uint32_t nrOfRaycasts{ static_cast<uint32_t>(batch.raycasts.size()) };
+    const uint32_t nrOfSweeps{ static_cast<uint32_t>(batch.sweeps.size()) };
+    const uint32_t nrOfOverlaps{ static_cast<uint32_t>(batch.overlaps.size()) };
+    const uint32_t nrOfQueries{ nrOfRaycasts + nrOfSweeps + nrOfOverlaps };
+    const uint32_t maxHits{ batch.maxHitsPerQuery };
+
+    batch.raycastResults.assign(nrOfRaycasts, QueryResult{});
+    batch.sweepResults.assign(nrOfSweeps, QueryResult{});
+    batch.overlapResults.assign(nrOfOverlaps, QueryResult{});
+    batch.hits.clear();
+
+    // PhysX doesn't filter on an empty mask, so a mask without layers is handled here
+    if (!m_pScene || nrOfQueries == 0 || maxHits == 0 || batch.layerMask == 0) return;
+
+    // Every query writes to its own slots, so the queries don't share anything while they run
+    batch.hits.resize(static_cast<size_t>(nrOfQueries) * maxHits);
+
+    const PhysXScene* pScene{ static_cast<const PhysXScene*>(m_pScene.get()) };
+    const auto executeQueries{ [&batch, pScene, maxHits, nrOfRaycasts, nrOfSweeps](uint32_t begin, uint32_t end)
+    {
+        for (uint32_t queryIdx{ begin }; queryIdx < end; ++queryIdx)
+        {
+            RaycastHit* pHits{ batch.hits.data() + static_cast<size_t>(queryIdx) * maxHits };
+
+            if (queryIdx < nrOfRaycasts)
+            {
+                batch.raycastResults[queryIdx].nrOfHits = pScene->Raycast(batch.raycasts[queryIdx], batch.layerMask, maxHits, pHits);
+            }
+            else if (queryIdx < nrOfRaycasts + nrOfSweeps)
+            {
+                const uint32_t sweepIdx{ queryIdx - nrOfRaycasts };
+                batch.sweepResults[sweepIdx].nrOfHits = pScene->Sweep(batch.sweeps[sweepIdx], batch.layerMask, maxHits, pHits);
+            }
+            else
+            {
+                const uint32_t overlapIdx{ queryIdx - nrOfRaycasts - nrOfSweeps };
+                batch.overlapResults[overlapIdx].nrOfHits = pScene->Overlap(batch.overlaps[overlapIdx], batch.layerMask, maxHits, pHits);
+            }
+        }
+    } };
+
+    // Large enough that scheduling a range costs little compared to its queries, small enough to spread a few thousand queries over the workers
+    constexpr uint32_t queryBatchSize{ 64 };
+    m_pDispatcher->ParallelFor(nrOfQueries, queryBatchSize, executeQueries);
+
+    // Packs the hits of every query right after the hits of the previous query
+    // Hits only move to the front, so this is done in place
+    uint32_t nrOfHits{};
+    uint32_t queryIdx{};
+    const auto packHits{ [&batch, maxHits, &nrOfHits, &queryIdx](std::vector<QueryResult>& results)
+    {
+        for (QueryResult& result : results)
+        {
+            const size_t firstSlot{ static_cast<size_t>(queryIdx++) * maxHits };
+            if (firstSlot != nrOfHits) std::copy_n(batch.hits.begin() + firstSlot, result.nrOfHits, batch.hits.begin() + nrOfHits);
+
+            result.firstHit = nrOfHits;
+            nrOfHits += result.nrOfHits;
+        }
+    } };
+
+    packHits(batch.raycastResults);
+    packHits(batch.sweepResults);
+    packHits(batch.overlapResults);
+
+    batch.hits.resize(nrOfHits);
+}
+
 void leap::physics::PhysXEngine::Notify(const SimulationEvent& e)
+{
+    const std::scoped_lock lock{ m_SimulationEventsMutex };
+    m_SimulationEvents.emplace_back(e);
+}
+
+void leap::physics::PhysXEngine::DispatchSimulationEvent(const SimulationEvent& e)
 {
     switch (e.type)
     {
@@ -223,4 +358,19 @@ leap::physics::IPhysicsMaterial* leap::physics::PhysXEngine::GetDefaultMaterial(
     }
 
     return pMaterial.get();
+}
+
+void leap::physics::PhysXEngine::RemoveObject(PhysXObject* pObject)
+{
+    const auto it{ m_ObjectIndices.find(pObject->GetOwner()) };
+    const size_t index{ it->second };
+    m_ObjectIndices.erase(it);
+
+    // Move the last object into the freed place to keep the objects dense
+    if (index != m_pObjects.size() - 1)
+    {
+        m_pObjects[index] = std::move(m_pObjects.back());
+        m_ObjectIndices[m_pObjects[index]->GetOwner()] = index;
+    }
+    m_pObjects.pop_back();
 }
\ No newline at end of file
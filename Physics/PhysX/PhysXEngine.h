@@ -6,7 +6,9 @@
 #include "PhysXSimulationFilterCallback.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include <Observer.h>
 
@@ -22,7 +24,6 @@ namespace physx
 	class PxFoundation;
 	class PxPhysics;
 	class PxCooking;
-	class PxDefaultCpuDispatcher;
 }
 
 namespace leap::physics
@@ -31,6 +32,7 @@ namespace leap::physics
 	class IPhysicsMaterial;
 	class PhysXObject;
 	class PhysXSimulationCallbacks;
+	class PhysXCpuDispatcher;
 
 	class PhysXEngine final : public IPhysics, public TObserver<SimulationEvent>
 	{
@@ -43,16 +45,23 @@ namespace leap::physics
 		PhysXEngine& operator=(const PhysXEngine& other) = delete;
 		PhysXEngine& operator=(PhysXEngine&& other) = delete;
 
-		virtual void SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc, const std::function<std::pair<glm::vec3, glm::quat>(void*)> getFunc) override;
+		virtual void SetSyncFunc(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc) override;
 		virtual void Update(float fixedDeltaTime) override;
 
+		virtual void SetAsyncSimulation(bool isAsync) override;
+		virtual bool IsSimulationAsync() const override { return m_IsSimulationAsync; }
+		virtual void FetchResults() override;
+
+		virtual void SetTaskScheduler(std::unique_ptr<IPhysicsTaskScheduler> pScheduler) override;
+		virtual const std::vector<PhysicsTaskTiming>& GetTaskTimings() const override { return m_TaskTimings; }
+
 		virtual void CreateScene() override;
 		virtual IPhysicsObject* Get(void* pOwner) override;
 		virtual std::unique_ptr<IShape> CreateShape(void* pOwner, EShape shape, IPhysicsMaterial* pMaterial = nullptr) override;
 		virtual std::shared_ptr<IPhysicsMaterial> CreateMaterial() override;
 
 		virtual void SetEnabledDebugDrawing(bool isEnabled) override;
-		virtual std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugDrawings() override;
+		virtual const std::vector<std::pair<glm::vec3, glm::vec3>>& GetDebugDrawings() override;
 
 		virtual TSubject<CollisionData>& OnCollisionEnter() override { return m_OnCollisionEnter; }
 		virtual TSubject<CollisionData>& OnCollisionStay() override { return m_OnCollisionStay; }
@@ -62,13 +71,19 @@ namespace leap::physics
 		virtual TSubject<CollisionData>& OnTriggerExit() override { return m_OnTriggerExit; }
 
 		virtual bool Raycast(const glm::vec3& start, const glm::vec3& direction, float distance, RaycastHit& hitInfo) override;
+		virtual void ExecuteQueries(SceneQueryBatch& batch) override;
 
 		physx::PxPhysics* GetPhysics() const { return m_pPhysics; }
 
+		// Queues an object to push its changes to PhysX at the start of the next step
+		void QueueDirty(PhysXObject* pObject) { m_pDirtyObjects.emplace_back(pObject); }
+
 		virtual void Notify(const SimulationEvent& e) override;
 
 	private:
 		IPhysicsMaterial* GetDefaultMaterial();
+		void RemoveObject(PhysXObject* pObject);
+		void DispatchSimulationEvent(const SimulationEvent& e);
 
 		std::unique_ptr<physx::PxDefaultErrorCallback> m_pDefaultErrorCallback{};
 		std::unique_ptr<physx::PxDefaultAllocator> m_pDefaultAllocatorCallback{};
@@ -78,13 +93,19 @@ namespace leap::physics
 		physx::PxFoundation* m_pFoundation{};
 		physx::PxPhysics* m_pPhysics{};
 		physx::PxCooking* m_pCooking{};
-		physx::PxDefaultCpuDispatcher* m_pDispatcher{};
+		std::unique_ptr<PhysXCpuDispatcher> m_pDispatcher{};
+		std::vector<PhysicsTaskTiming> m_TaskTimings{};
 
 		std::unique_ptr<physics::IPhysicsScene> m_pScene{};
 
-		std::unordered_map<void*, std::unique_ptr<PhysXObject>> m_pObjects{};
+		// Objects are stored densely, the map is only used to find the object of an owner
+		std::vector<std::unique_ptr<PhysXObject>> m_pObjects{};
+		std::unordered_map<void*, size_t> m_ObjectIndices{};
+
+		// Objects that changed since the last step, and the ones that were updated during the current step
+		std::vector<PhysXObject*> m_pDirtyObjects{};
+		std::vector<PhysXObject*> m_pUpdatedObjects{};
 
-		std::function<std::pair<const glm::vec3&, const glm::quat&>(void*)> m_SyncGetFunc{};
 		std::function<void(void*, glm::vec3, glm::quat)> m_SyncSetFunc{};
 
 		TSubject<CollisionData> m_OnCollisionEnter{};
@@ -94,6 +115,13 @@ namespace leap::physics
 		TSubject<CollisionData> m_OnTriggerStay{};
 		TSubject<CollisionData> m_OnTriggerExit{};
 
+		// Events can be raised from the PhysX worker threads during a step, they are dispatched on the main thread once the results are fetched
+		std::vector<SimulationEvent> m_SimulationEvents{};
+		std::vector<SimulationEvent> m_DispatchedSimulationEvents{};
+		std::mutex m_SimulationEventsMutex{};
+
 		bool m_IsDebugDrawingEnabled{};
+		bool m_IsSimulationAsync{};
+		bool m_IsSimulating{};
 	};
 }
\ No newline at end of file
@@ -14,9 +14,12 @@
 
 #include <Quaternion.h>
 
-leap::physics::PhysXObject::PhysXObject(void* pOwner)
-	: m_pOwner{ pOwner }
+leap::physics::PhysXObject::PhysXObject(PhysXEngine* pEngine, void* pOwner)
+	: m_pEngine{ pEngine }
+	, m_pOwner{ pOwner }
 {
+	// The actor still needs to be created
+	MarkDirty();
 }
 
 leap::physics::PhysXObject::~PhysXObject()
@@ -24,31 +27,35 @@ leap::physics::PhysXObject::~PhysXObject()
 	m_pActor->release();
 }
 
-void leap::physics::PhysXObject::Update(PhysXEngine* pEngine, IPhysicsScene* pScene)
+void leap::physics::PhysXObject::Update(IPhysicsScene* pScene)
 {
 	m_NewFrame = true;
 
-	if (m_IsObjectDirty) UpdateObject(pEngine, pScene);
+	const bool isNewActor{ m_IsObjectDirty };
+
+	if (m_IsObjectDirty) UpdateObject(pScene);
 	if (m_pRigidbody && m_pRigidbody->IsDirty()) UpdateRigidbody();
-	if (m_IsTransformDirty) UpdateTransform();
+	if (m_IsTransformDirty) UpdateTransform(isNewActor);
 
 	if (!IsValid()) static_cast<PhysXScene*>(pScene)->RemoveActor(m_pActor);
+
+	// Changes made from here on queue this object again
+	m_IsQueued = false;
 }
 
-void leap::physics::PhysXObject::Apply(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc, const std::function<std::pair<const glm::vec3&, const glm::quat&>(void*)> getFunc) const
+void leap::physics::PhysXObject::WriteBack(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc)
 {
-	if (m_pRigidbody == nullptr)
-	{
-		const auto transformPair{ getFunc(m_pOwner) };
+	if (m_pRigidbody == nullptr) return;
 
-		const physx::PxVec3 position{ transformPair.first.x, transformPair.first.y, transformPair.first.z };
-		const physx::PxQuat rotation{ transformPair.second.x, transformPair.second.y, transformPair.second.z, transformPair.second.w };
-
-		m_pActor->setGlobalPose(physx::PxTransform{ position, rotation });
-
-		return;
+	if (m_pRigidbody->IsKinematic())
+	{
+		if (!m_IsKinematicPoseSet) return;
+		m_IsKinematicPoseSet = false;
 	}
 
+	// The velocity of the rigidbody changed during the step
+	m_NewFrame = true;
+
 	const physx::PxTransform transform{ m_pActor->getGlobalPose() };
 
 	const glm::vec3 position{ transform.p.x, transform.p.y, transform.p.z };
@@ -61,6 +68,7 @@ void leap::physics::PhysXObject::AddShape(IShape* pShape)
 {
 	IPhysXShape* pPhysXShape{ reinterpret_cast<IPhysXShape*>(pShape) };
 	m_pShapes.emplace_back(pPhysXShape);
+	MarkDirty();
 
 	if (m_pActor)
 	{
@@ -80,17 +88,22 @@ void leap::physics::PhysXObject::RemoveShape(IShape* pShape)
 	}
 
 	m_pShapes.erase(std::remove(begin(m_pShapes), end(m_pShapes), pPhysXShape));
+
+	// The object is removed once it has no shapes and no rigidbody left
+	MarkDirty();
 }
 
 leap::physics::Rigidbody* leap::physics::PhysXObject::SetRigidbody(bool hasRigidbody)
 {
+	MarkDirty();
+
 	if (!hasRigidbody)
 	{
 		m_pRigidbody = nullptr;
 		return nullptr;
 	}
 
-	if (m_pRigidbody == nullptr) m_pRigidbody = std::make_unique<Rigidbody>([this]() { OnRigidBodyUpdateRequest(); });
+	if (m_pRigidbody == nullptr) m_pRigidbody = std::make_unique<Rigidbody>([this]() { OnRigidBodyUpdateRequest(); }, [this]() { MarkDirty(); });
 
 	return m_pRigidbody.get();
 }
@@ -105,6 +118,7 @@ void leap::physics::PhysXObject::SetTransform(const glm::vec3& position, const g
 	m_Position = position;
 	m_Rotation = rotation;
 	m_IsTransformDirty = true;
+	MarkDirty();
 }
 
 glm::vec3 leap::physics::PhysXObject::GetPosition()
@@ -123,7 +137,7 @@ glm::quat leap::physics::PhysXObject::GetRotation()
 	return glm::quat{ rotation.w, rotation.x, rotation.y, rotation.z };
 }
 
-void leap::physics::PhysXObject::UpdateObject(PhysXEngine* pEngine, IPhysicsScene* pScene)
+void leap::physics::PhysXObject::UpdateObject(IPhysicsScene* pScene)
 {
 	m_IsObjectDirty = false;
 
@@ -137,13 +151,13 @@ void leap::physics::PhysXObject::UpdateObject(PhysXEngine* pEngine, IPhysicsScen
 
 	if (m_pRigidbody)
 	{
-		m_pActor = pEngine->GetPhysics()->createRigidDynamic(physx::PxTransform{ physx::PxIdentity });
+		m_pActor = m_pEngine->GetPhysics()->createRigidDynamic(physx::PxTransform{ physx::PxIdentity });
 		static_cast<physx::PxRigidDynamic*>(m_pActor)->setLinearDamping(0.0f);
 		static_cast<physx::PxRigidDynamic*>(m_pActor)->setAngularDamping(0.05f);
 	}
 	else
 	{
-		m_pActor = pEngine->GetPhysics()->createRigidStatic(physx::PxTransform{ physx::PxIdentity });
+		m_pActor = m_pEngine->GetPhysics()->createRigidStatic(physx::PxTransform{ physx::PxIdentity });
 	}
 
 	for (IPhysXShape* pShape : m_pShapes)
@@ -153,10 +167,13 @@ void leap::physics::PhysXObject::UpdateObject(PhysXEngine* pEngine, IPhysicsScen
 
 	if(m_pRigidbody) CalculateCenterOfMass();
 
+	// Lets the engine find this object from the active actors of a step
+	m_pActor->userData = this;
+
 	pPhysXScene->AddActor(m_pActor);
 }
 
-void leap::physics::PhysXObject::UpdateTransform()
+void leap::physics::PhysXObject::UpdateTransform(bool isNewActor)
 {
 	if (m_pActor == nullptr) return;
 
@@ -166,6 +183,13 @@ void leap::physics::PhysXObject::UpdateTransform()
 	const physx::PxQuat rotation{ m_Rotation.x, m_Rotation.y, m_Rotation.z, m_Rotation.w };
 	const physx::PxTransform transform{ position, rotation };
 
+	// A kinematic body moves to its target during the step so it pushes the bodies it touches, a new one is placed directly
+	if (m_pRigidbody && m_pRigidbody->IsKinematic() && !isNewActor)
+	{
+		static_cast<physx::PxRigidDynamic*>(m_pActor)->setKinematicTarget(transform);
+		return;
+	}
+
 	m_pActor->setGlobalPose(transform);
 }
 
@@ -173,19 +197,23 @@ void leap::physics::PhysXObject::UpdateRigidbody()
 {
 	unsigned int dirtyFlag{ static_cast<unsigned int>(m_pRigidbody->GetDirtyFlag()) };
 
+	const bool isKinematic{ m_pRigidbody->IsKinematic() };
+
 	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Kinematic))
 	{
-		m_pActor->setActorFlag(physx::PxActorFlag::eDISABLE_GRAVITY, m_pRigidbody->IsKinematic());
+		// Kinematic bodies are not affected by gravity, forces or collisions
+		static_cast<physx::PxRigidDynamic*>(m_pActor)->setRigidBodyFlag(physx::PxRigidBodyFlag::eKINEMATIC, isKinematic);
 	}
 
-	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Velocity))
+	// Velocities can't be set on a kinematic body
+	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Velocity) && !isKinematic)
 	{
 		const glm::vec3& velocity{ m_pRigidbody->GetVelocity() };
 		const physx::PxVec3 pxVelocity{ velocity.x, velocity.y, velocity.z };
 		static_cast<physx::PxRigidDynamic*>(m_pActor)->setLinearVelocity(pxVelocity);
 	}
 
-	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::AngularVelocity))
+	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::AngularVelocity) && !isKinematic)
 	{
 		const glm::vec3& velocity{ m_pRigidbody->GetAngularVelocity() };
 		const physx::PxVec3 pxVelocity{ velocity.x, velocity.y, velocity.z };
@@ -204,6 +232,7 @@ void leap::physics::PhysXObject::UpdateRigidbody()
 		const glm::quat& rotation{ dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Rotation) ? m_pRigidbody->GetRotation() : GetRotation() };
 
 		SetTransform(position, rotation);
+		m_IsKinematicPoseSet = isKinematic;
 	}
 
 	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Translate) || dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Rotate))
@@ -212,6 +241,7 @@ void leap::physics::PhysXObject::UpdateRigidbody()
 		const glm::quat& rotation{ GetRotation() };
 
 		SetTransform(position + m_pRigidbody->GetTranslation(), m_pRigidbody->GetRotationDelta() * rotation);
+		m_IsKinematicPoseSet = isKinematic;
 	}
 
 	if (dirtyFlag & static_cast<unsigned int>(Rigidbody::RigidbodyFlag::Constraints))
@@ -224,6 +254,7 @@ void leap::physics::PhysXObject::UpdateRigidbody()
 	}
 
 	auto& forces{ m_pRigidbody->GetForces() };
+	if (isKinematic) forces.clear();
 	if(!forces.empty())
 	{
 		physx::PxRigidDynamic* pDynamic{static_cast<physx::PxRigidDynamic*>(m_pActor) };
@@ -264,3 +295,12 @@ void leap::physics::PhysXObject::OnRigidBodyUpdateRequest()
 	const auto& physXAngularVelocity{ pRigidbody->getAngularVelocity() };
 	m_pRigidbody->SetAngularVelocityFromEngine({ physXAngularVelocity.x, physXAngularVelocity.y, physXAngularVelocity.z });
 }
+
+
+void leap::physics::PhysXObject::MarkDirty()
+{
+	if (m_IsQueued) return;
+	m_IsQueued = true;
+
+	m_pEngine->QueueDirty(this);
+}
\ No newline at end of file
@@ -25,11 +25,21 @@ namespace leap::physics
 	class PhysXObject final : public IPhysicsObject
 	{
 	public:
-		PhysXObject(void* pOwner);
+		PhysXObject(PhysXEngine* pEngine, void* pOwner);
 		virtual ~PhysXObject();
 
-		void Update(PhysXEngine* pEngine, IPhysicsScene* pScene);
-		void Apply(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc, const std::function<std::pair<const glm::vec3&, const glm::quat&>(void*)> getFunc) const;
+		PhysXObject(const PhysXObject& other) = delete;
+		PhysXObject(PhysXObject&& other) = delete;
+		PhysXObject& operator=(const PhysXObject& other) = delete;
+		PhysXObject& operator=(PhysXObject&& other) = delete;
+
+		// Pushes the changes that were made since this object was queued as dirty to PhysX
+		void Update(IPhysicsScene* pScene);
+		// Writes the simulated pose of a rigidbody back to its owner
+		// A kinematic body follows its owner, it only writes back the poses that were set through its rigidbody
+		void WriteBack(const std::function<void(void*, const glm::vec3&, const glm::quat&)>& setFunc);
+
+		void* GetOwner() const { return m_pOwner; }
 
 		virtual void AddShape(IShape* pShape) override;
 		virtual void RemoveShape(IShape* pShape) override;
@@ -41,15 +51,17 @@ namespace leap::physics
 		virtual glm::quat GetRotation() override;
 
 	private:
-		void UpdateObject(PhysXEngine* pEngine, IPhysicsScene* pScene);
-		void UpdateTransform();
+		void UpdateObject(IPhysicsScene* pScene);
+		void UpdateTransform(bool isNewActor);
 		void UpdateRigidbody();
 		void CalculateCenterOfMass() const;
 
 		void OnRigidBodyUpdateRequest();
+		void MarkDirty();
 
 		std::vector<IPhysXShape*> m_pShapes{};
 		physx::PxRigidActor* m_pActor{};
+		PhysXEngine* m_pEngine{};
 		void* m_pOwner{};
 		std::unique_ptr<Rigidbody> m_pRigidbody{};
 
@@ -59,5 +71,7 @@ namespace leap::physics
 		bool m_IsObjectDirty{ true };
 		bool m_IsTransformDirty{ true };
 		bool m_NewFrame{ false };
+		bool m_IsQueued{ false };
+		bool m_IsKinematicPoseSet{ false };
 	};
 }
\ No newline at end of file
@@ -5,6 +5,110 @@
 #include "PhysXEngine.h"
 
 #include "../Data/RaycastHit.h"
+#include "../Data/SceneQuery.h"
+
+#include <type_traits>
+
+namespace leap::physics
+{
+	static physx::PxVec3 ToPhysX(const glm::vec3& vector)
+	{
+		return physx::PxVec3{ vector.x, vector.y, vector.z };
+	}
+
+	static glm::vec3 ToGlm(const physx::PxVec3& vector)
+	{
+		return glm::vec3{ vector.x, vector.y, vector.z };
+	}
+
+	template <class HitType>
+	static RaycastHit ToHit(const HitType& hit)
+	{
+		if constexpr (std::is_same_v<HitType, physx::PxOverlapHit>) return RaycastHit{ hit.shape->userData };
+		else return RaycastHit{ hit.shape->userData, hit.distance, ToGlm(hit.position), ToGlm(hit.normal) };
+	}
+
+	static physx::PxGeometryHolder ToGeometry(const QueryShape& shape)
+	{
+		switch (shape.shape)
+		{
+		case EShape::Box:
+			return physx::PxBoxGeometry{ shape.size.x / 2.0f, shape.size.y / 2.0f, shape.size.z / 2.0f };
+		case EShape::Sphere:
+			return physx::PxSphereGeometry{ shape.radius };
+		case EShape::Capsule:
+		default:
+			return physx::PxCapsuleGeometry{ shape.radius, shape.height / 2.0f };
+		}
+	}
+
+	static physx::PxTransform ToPose(const QueryShape& shape, const glm::vec3& position, const glm::quat& rotation)
+	{
+		const physx::PxQuat pxRotation{ rotation.x, rotation.y, rotation.z, rotation.w };
+
+		// A PhysX capsule lies along its x axis, it is turned upright like the capsule shapes
+		if (shape.shape == EShape::Capsule) return physx::PxTransform{ ToPhysX(position), pxRotation * physx::PxQuat{ physx::PxHalfPi, physx::PxVec3{ 0.0f, 0.0f, 1.0f } } };
+		return physx::PxTransform{ ToPhysX(position), pxRotation };
+	}
+
+	static physx::PxQueryFilterData ToFilterData(uint32_t layerMask, physx::PxQueryFlags flags)
+	{
+		return physx::PxQueryFilterData{ physx::PxFilterData{ layerMask, 0, 0, 0 }, flags | physx::PxQueryFlag::eSTATIC | physx::PxQueryFlag::eDYNAMIC };
+	}
+
+	// Receives every hit of a query as a touch and keeps the closest ones sorted by distance
+	template <class HitType>
+	class ClosestHitsCallback final : public physx::PxHitCallback<HitType>
+	{
+	public:
+		ClosestHitsCallback(RaycastHit* pHits, uint32_t maxHits)
+			: physx::PxHitCallback<HitType>{ m_Touches, m_TouchCapacity }
+			, m_pHits{ pHits }
+			, m_MaxHits{ maxHits }
+		{
+		}
+
+		virtual physx::PxAgain processTouches(const HitType* pTouches, physx::PxU32 nrOfTouches) override
+		{
+			for (physx::PxU32 i{}; i < nrOfTouches; ++i) Add(ToHit(pTouches[i]));
+			return true;
+		}
+
+		uint32_t GetNrOfHits()
+		{
+			// The last touches can still be in the buffer when the query is done
+			if (this->nbTouches > 0)
+			{
+				processTouches(this->touches, this->nbTouches);
+				this->nbTouches = 0;
+			}
+
+			return m_NrOfHits;
+		}
+
+	private:
+		void Add(const RaycastHit& hit)
+		{
+			// Once the hits are full, a closer hit pushes out the farthest one
+			if (m_NrOfHits == m_MaxHits)
+			{
+				if (hit.distance >= m_pHits[m_NrOfHits - 1].distance) return;
+				--m_NrOfHits;
+			}
+
+			uint32_t hitIdx{ m_NrOfHits++ };
+			for (; hitIdx > 0 && m_pHits[hitIdx - 1].distance > hit.distance; --hitIdx) m_pHits[hitIdx] = m_pHits[hitIdx - 1];
+			m_pHits[hitIdx] = hit;
+		}
+
+		static constexpr physx::PxU32 m_TouchCapacity{ 32 };
+
+		HitType m_Touches[m_TouchCapacity]{};
+		RaycastHit* m_pHits{};
+		uint32_t m_MaxHits{};
+		uint32_t m_NrOfHits{};
+	};
+}
 
 leap::physics::PhysXScene::PhysXScene(physx::PxScene* pScene)
 	: m_pScene{ pScene }
@@ -18,30 +122,45 @@ leap::physics::PhysXScene::~PhysXScene()
 
 void leap::physics::PhysXScene::Simulate(float fixedDeltaTime)
 {
-	m_pScene->simulate(fixedDeltaTime);
-	m_pScene->fetchResults(true);
+	StartSimulate(fixedDeltaTime);
+	FetchResults();
 }
 
-void leap::physics::PhysXScene::SetEnabledDebugDrawing(bool isEnabled)
+void leap::physics::PhysXScene::StartSimulate(float fixedDeltaTime)
 {
-	m_pScene->setVisualizationParameter(physx::PxVisualizationParameter::eSCALE, isEnabled ? 1.0f : 0.0f);
-	m_pScene->setVisualizationParameter(physx::PxVisualizationParameter::eCOLLISION_SHAPES, isEnabled ? 1.0f : 0.0f);
+	m_pScene->simulate(fixedDeltaTime);
 }
 
-std::vector<std::pair<glm::vec3, glm::vec3>> leap::physics::PhysXScene::GetDebugDrawings()
+void leap::physics::PhysXScene::FetchResults()
 {
-	std::vector<std::pair<glm::vec3, glm::vec3>> debugDrawings{};
+	m_pScene->fetchResults(true);
+
+	m_DebugDrawings.clear();
+	if (!m_IsDebugDrawingEnabled) return;
 
 	const physx::PxRenderBuffer& rb = m_pScene->getRenderBuffer();
 	const auto pLines{ rb.getLines() };
+	m_DebugDrawings.reserve(rb.getNbLines());
 	for (physx::PxU32 i = 0; i < rb.getNbLines(); i++)
 	{
 		const physx::PxDebugLine& line = pLines[i];
-		debugDrawings.emplace_back(glm::vec3{ line.pos0.x, line.pos0.y, line.pos0.z },
+		m_DebugDrawings.emplace_back(glm::vec3{ line.pos0.x, line.pos0.y, line.pos0.z },
 								   glm::vec3{ line.pos1.x, line.pos1.y, line.pos1.z });
 	}
+}
+
+void leap::physics::PhysXScene::SetEnabledDebugDrawing(bool isEnabled)
+{
+	m_IsDebugDrawingEnabled = isEnabled;
+	if (!isEnabled) m_DebugDrawings.clear();
 
-	return debugDrawings;
+	m_pScene->setVisualizationParameter(physx::PxVisualizationParameter::eSCALE, isEnabled ? 1.0f : 0.0f);
+	m_pScene->setVisualizationParameter(physx::PxVisualizationParameter::eCOLLISION_SHAPES, isEnabled ? 1.0f : 0.0f);
+}
+
+const std::vector<std::pair<glm::vec3, glm::vec3>>& leap::physics::PhysXScene::GetDebugDrawings()
+{
+	return m_DebugDrawings;
 }
 
 bool leap::physics::PhysXScene::Raycast(const glm::vec3& start, const glm::vec3& direction, float distance, RaycastHit& hitInfo)
@@ -62,6 +181,61 @@ bool leap::physics::PhysXScene::Raycast(const glm::vec3& start, const glm::vec3&
 	return true;
 }
 
+uint32_t leap::physics::PhysXScene::Raycast(const RaycastQuery& query, uint32_t layerMask, uint32_t maxHits, RaycastHit* pHits) const
+{
+	if (maxHits == 1)
+	{
+		physx::PxRaycastBuffer hit{};
+		if (!m_pScene->raycast(ToPhysX(query.start), ToPhysX(query.direction), query.distance, hit, physx::PxHitFlag::eDEFAULT, ToFilterData(layerMask, {}))) return 0;
+
+		pHits[0] = ToHit(hit.block);
+		return 1;
+	}
+
+	ClosestHitsCallback<physx::PxRaycastHit> hits{ pHits, maxHits };
+	m_pScene->raycast(ToPhysX(query.start), ToPhysX(query.direction), query.distance, hits, physx::PxHitFlag::eDEFAULT, ToFilterData(layerMask, physx::PxQueryFlag::eNO_BLOCK));
+	return hits.GetNrOfHits();
+}
+
+uint32_t leap::physics::PhysXScene::Sweep(const SweepQuery& query, uint32_t layerMask, uint32_t maxHits, RaycastHit* pHits) const
+{
+	const physx::PxGeometryHolder geometry{ ToGeometry(query.shape) };
+	const physx::PxTransform pose{ ToPose(query.shape, query.position, query.rotation) };
+
+	if (maxHits == 1)
+	{
+		physx::PxSweepBuffer hit{};
+		if (!m_pScene->sweep(geometry.any(), pose, ToPhysX(query.direction), query.distance, hit, physx::PxHitFlag::eDEFAULT, ToFilterData(layerMask, {}))) return 0;
+
+		pHits[0] = ToHit(hit.block);
+		return 1;
+	}
+
+	ClosestHitsCallback<physx::PxSweepHit> hits{ pHits, maxHits };
+	m_pScene->sweep(geometry.any(), pose, ToPhysX(query.direction), query.distance, hits, physx::PxHitFlag::eDEFAULT, ToFilterData(layerMask, physx::PxQueryFlag::eNO_BLOCK));
+	return hits.GetNrOfHits();
+}
+
+uint32_t leap::physics::PhysXScene::Overlap(const OverlapQuery& query, uint32_t layerMask, uint32_t maxHits, RaycastHit* pHits) const
+{
+	const physx::PxGeometryHolder geometry{ ToGeometry(query.shape) };
+	const physx::PxTransform pose{ ToPose(query.shape, query.position, query.rotation) };
+
+	// An overlap has no closest hit, with one hit it stops at the first shape it finds
+	if (maxHits == 1)
+	{
+		physx::PxOverlapBuffer hit{};
+		if (!m_pScene->overlap(geometry.any(), pose, hit, ToFilterData(layerMask, physx::PxQueryFlag::eANY_HIT))) return 0;
+
+		pHits[0] = ToHit(hit.block);
+		return 1;
+	}
+
+	ClosestHitsCallback<physx::PxOverlapHit> hits{ pHits, maxHits };
+	m_pScene->overlap(geometry.any(), pose, hits, ToFilterData(layerMask, physx::PxQueryFlag::eNO_BLOCK));
+	return hits.GetNrOfHits();
+}
+
 void leap::physics::PhysXScene::AddActor(physx::PxRigidActor* pActor) const
 {
 	m_pScene->addActor(*pActor);
@@ -71,3 +245,13 @@ void leap::physics::PhysXScene::RemoveActor(physx::PxRigidActor* pActor) const
 {
 	m_pScene->removeActor(*pActor);
 }
+
+
+physx::PxActor** leap::physics::PhysXScene::GetActiveActors(unsigned int& nrOfActors) const
+{
+	physx::PxU32 nrOfActiveActors{};
+	physx::PxActor** ppActors{ m_pScene->getActiveActors(nrOfActiveActors) };
+
+	nrOfActors = nrOfActiveActors;
+	return ppActors;
+}
\ No newline at end of file
@@ -2,14 +2,21 @@
 
 #include "../Interfaces/IPhysicsScene.h"
 
+#include <cstdint>
+
 namespace physx
 {
 	class PxScene;
 	class PxRigidActor;
+	class PxActor;
 }
 
 namespace leap::physics
 {
+	struct RaycastQuery;
+	struct SweepQuery;
+	struct OverlapQuery;
+
 	class PhysXScene final : public IPhysicsScene
 	{
 	public:
@@ -22,14 +29,30 @@ namespace leap::physics
 		PhysXScene& operator=(PhysXScene&& other) = delete;
 
 		virtual void Simulate(float fixedDeltaTime) override;
+		virtual void StartSimulate(float fixedDeltaTime) override;
+		virtual void FetchResults() override;
 		virtual void SetEnabledDebugDrawing(bool isEnabled) override;
-		virtual std::vector<std::pair<glm::vec3, glm::vec3>> GetDebugDrawings() override;
+		virtual const std::vector<std::pair<glm::vec3, glm::vec3>>& GetDebugDrawings() override;
 		virtual bool Raycast(const glm::vec3& start, const glm::vec3& direction, float distance, RaycastHit& hitInfo) override;
 
+		// The queries of a SceneQueryBatch, they write up to maxHits hits to pHits and return the amount of hits
+		// They only read the scene, so several threads can run them at once
+		uint32_t Raycast(const RaycastQuery& query, uint32_t layerMask, uint32_t maxHits, RaycastHit* pHits) const;
+		uint32_t Sweep(const SweepQuery& query, uint32_t layerMask, uint32_t maxHits, RaycastHit* pHits) const;
+		uint32_t Overlap(const OverlapQuery& query, uint32_t layerMask, uint32_t maxHits, RaycastHit* pHits) const;
+
 		void AddActor(physx::PxRigidActor* pActor) const;
 		void RemoveActor(physx::PxRigidActor* pActor) const;
 
+		// Returns the actors that moved during the last step, valid until the next step is simulated
+		physx::PxActor** GetActiveActors(unsigned int& nrOfActors) const;
+
 	private:
 		physx::PxScene* m_pScene{};
+
+		// Collected when the results of a step are fetched, the render buffer can't be read while a step is running
+		// Reused every step so collecting the debug lines doesn't allocate once its capacity is reached
+		std::vector<std::pair<glm::vec3, glm::vec3>> m_DebugDrawings{};
+		bool m_IsDebugDrawingEnabled{};
 	};
 }
\ No newline at end of file
@@ -13,6 +13,7 @@ leap::physics::PhysXBoxShape::PhysXBoxShape(PhysXEngine* pEngine, void* pOwner,
 
 	m_pShape = pEngine->GetPhysics()->createShape(geo, pMaterial->GetInternalMaterial(), true);
 	m_pShape->userData = pOwner;
+	SetLayer(0);
 }
 
 void leap::physics::PhysXBoxShape::SetSize(const glm::vec3& size)
@@ -49,6 +50,7 @@ leap::physics::PhysXSphereShape::PhysXSphereShape(PhysXEngine* pEngine, void* pO
 
 	m_pShape = pEngine->GetPhysics()->createShape(geo, pMaterial->GetInternalMaterial(), true);
 	m_pShape->userData = pOwner;
+	SetLayer(0);
 }
 
 void leap::physics::PhysXSphereShape::SetRadius(float radius)
@@ -84,6 +86,7 @@ leap::physics::PhysXCapsuleShape::PhysXCapsuleShape(PhysXEngine* pEngine, void*
 	m_pShape = pEngine->GetPhysics()->createShape(geo, pMaterial->GetInternalMaterial(), true);
 	m_pShape->setLocalPose(physx::PxTransform{ {}, physx::PxQuat{ physx::PxHalfPi, physx::PxVec3{ 0.0f, 0.0f, 1.0f } } });
 	m_pShape->userData = pOwner;
+	SetLayer(0);
 }
 
 void leap::physics::PhysXCapsuleShape::SetSize(const glm::vec3& size)
@@ -129,3 +132,16 @@ void leap::physics::IPhysXShape::SetTrigger(bool isTrigger)
 	m_pShape->setFlag(physx::PxShapeFlag::eSIMULATION_SHAPE, !isTrigger);
 	m_pShape->setFlag(physx::PxShapeFlag::eTRIGGER_SHAPE, isTrigger);
 }
+
+
+void leap::physics::IPhysXShape::SetLayer(unsigned int layer)
+{
+	if (layer >= 32)
+	{
+		Debug::LogWarning("PhysXEngine Warning: A shape can only be on layer 0 to 31");
+		return;
+	}
+
+	// Scene queries with a layer mask only hit shapes that share a bit with the mask, so every shape needs a layer bit
+	m_pShape->setQueryFilterData(physx::PxFilterData{ 1u << layer, 0, 0, 0 });
+}
\ No newline at end of file
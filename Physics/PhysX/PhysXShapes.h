@@ -25,6 +25,7 @@ namespace leap::physics
 
 		physx::PxShape& GetShape();
 		virtual void SetTrigger(bool isTrigger) override;
+		virtual void SetLayer(unsigned int layer) override;
 
 	protected:
 		physx::PxShape* m_pShape{};
@@ -7,6 +7,9 @@ namespace unag
 	class Transformator final : public leap::Component
 	{
 	public:
+		// Only rotates its own transform, so it can be updated on the worker threads
+		static constexpr leap::UpdateAccess m_UpdateAccess{ leap::UpdateAccess::OwnGameObject };
+
 		Transformator() = default;
 		~Transformator() = default;
 
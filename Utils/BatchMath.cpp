@@ -0,0 +1,363 @@
+#include "BatchMath.h"
+#include "BatchMathKernels.h"
+
+#include <atomic>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEAP_BATCHMATH_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace leap::batchmath
+{
+	namespace scalar
+	{
+		static void TransformPoints(const glm::mat4x4& matrix, Vec3SoA<const float> points, Vec3SoA<float> out, size_t count)
+		{
+			for (size_t i{}; i < count; ++i)
+			{
+				const float x{ points.pX[i] };
+				const float y{ points.pY[i] };
+				const float z{ points.pZ[i] };
+
+				out.pX[i] = matrix[0][0] * x + matrix[1][0] * y + matrix[2][0] * z + matrix[3][0];
+				out.pY[i] = matrix[0][1] * x + matrix[1][1] * y + matrix[2][1] * z + matrix[3][1];
+				out.pZ[i] = matrix[0][2] * x + matrix[1][2] * y + matrix[2][2] * z + matrix[3][2];
+			}
+		}
+
+		static void MultiplyQuaternions(QuatSoA<const float> lhs, QuatSoA<const float> rhs, QuatSoA<float> out, size_t count)
+		{
+			for (size_t i{}; i < count; ++i)
+			{
+				const float ax{ lhs.pX[i] }, ay{ lhs.pY[i] }, az{ lhs.pZ[i] }, aw{ lhs.pW[i] };
+				const float bx{ rhs.pX[i] }, by{ rhs.pY[i] }, bz{ rhs.pZ[i] }, bw{ rhs.pW[i] };
+
+				out.pX[i] = aw * bx + ax * bw + ay * bz - az * by;
+				out.pY[i] = aw * by + ay * bw + az * bx - ax * bz;
+				out.pZ[i] = aw * bz + az * bw + ax * by - ay * bx;
+				out.pW[i] = aw * bw - ax * bx - ay * by - az * bz;
+			}
+		}
+
+		static void QuaternionsToMatrices(QuatSoA<const float> quaternions, glm::mat4x4* pOut, size_t count)
+		{
+			for (size_t i{}; i < count; ++i)
+			{
+				const float x{ quaternions.pX[i] }, y{ quaternions.pY[i] }, z{ quaternions.pZ[i] }, w{ quaternions.pW[i] };
+
+				const float xx{ x * x }, yy{ y * y }, zz{ z * z };
+				const float xy{ x * y }, xz{ x * z }, yz{ y * z };
+				const float wx{ w * x }, wy{ w * y }, wz{ w * z };
+
+				glm::mat4x4& matrix{ pOut[i] };
+				matrix[0] = glm::vec4{ 1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f };
+				matrix[1] = glm::vec4{ 2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f };
+				matrix[2] = glm::vec4{ 2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f };
+				matrix[3] = glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f };
+			}
+		}
+
+		static void TransformAABBs(const glm::mat4x4& matrix, Vec3SoA<const float> centers, Vec3SoA<const float> extents, Vec3SoA<float> outCenters, Vec3SoA<float> outExtents, size_t count)
+		{
+			// The extents are transformed by the absolute rotation and scale, so every corner of the box stays inside
+			for (size_t i{}; i < count; ++i)
+			{
+				const float ex{ extents.pX[i] };
+				const float ey{ extents.pY[i] };
+				const float ez{ extents.pZ[i] };
+
+				outExtents.pX[i] = std::abs(matrix[0][0]) * ex + std::abs(matrix[1][0]) * ey + std::abs(matrix[2][0]) * ez;
+				outExtents.pY[i] = std::abs(matrix[0][1]) * ex + std::abs(matrix[1][1]) * ey + std::abs(matrix[2][1]) * ez;
+				outExtents.pZ[i] = std::abs(matrix[0][2]) * ex + std::abs(matrix[1][2]) * ey + std::abs(matrix[2][2]) * ez;
+			}
+
+			TransformPoints(matrix, centers, outCenters, count);
+		}
+
+		static void NormalizeVectors(Vec3SoA<float> vectors, size_t count)
+		{
+			for (size_t i{}; i < count; ++i)
+			{
+				const float x{ vectors.pX[i] };
+				const float y{ vectors.pY[i] };
+				const float z{ vectors.pZ[i] };
+
+				const float inverseLength{ 1.0f / std::sqrt(x * x + y * y + z * z) };
+
+				vectors.pX[i] = x * inverseLength;
+				vectors.pY[i] = y * inverseLength;
+				vectors.pZ[i] = z * inverseLength;
+			}
+		}
+	}
+
+#ifdef LEAP_BATCHMATH_SSE2
+	namespace sse2
+	{
+		static void TransformPoints(const glm::mat4x4& matrix, Vec3SoA<const float> points, Vec3SoA<float> out, size_t count)
+		{
+			const __m128 m00{ _mm_set1_ps(matrix[0][0]) }, m01{ _mm_set1_ps(matrix[0][1]) }, m02{ _mm_set1_ps(matrix[0][2]) };
+			const __m128 m10{ _mm_set1_ps(matrix[1][0]) }, m11{ _mm_set1_ps(matrix[1][1]) }, m12{ _mm_set1_ps(matrix[1][2]) };
+			const __m128 m20{ _mm_set1_ps(matrix[2][0]) }, m21{ _mm_set1_ps(matrix[2][1]) }, m22{ _mm_set1_ps(matrix[2][2]) };
+			const __m128 m30{ _mm_set1_ps(matrix[3][0]) }, m31{ _mm_set1_ps(matrix[3][1]) }, m32{ _mm_set1_ps(matrix[3][2]) };
+
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 x{ _mm_loadu_ps(points.pX + i) };
+				const __m128 y{ _mm_loadu_ps(points.pY + i) };
+				const __m128 z{ _mm_loadu_ps(points.pZ + i) };
+
+				_mm_storeu_ps(out.pX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), _mm_add_ps(_mm_mul_ps(m20, z), m30)));
+				_mm_storeu_ps(out.pY + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), _mm_add_ps(_mm_mul_ps(m21, z), m31)));
+				_mm_storeu_ps(out.pZ + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, x), _mm_mul_ps(m12, y)), _mm_add_ps(_mm_mul_ps(m22, z), m32)));
+			}
+
+			scalar::TransformPoints(matrix, Offset(points, i), Offset(out, i), count - i);
+		}
+
+		static void MultiplyQuaternions(QuatSoA<const float> lhs, QuatSoA<const float> rhs, QuatSoA<float> out, size_t count)
+		{
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 ax{ _mm_loadu_ps(lhs.pX + i) }, ay{ _mm_loadu_ps(lhs.pY + i) }, az{ _mm_loadu_ps(lhs.pZ + i) }, aw{ _mm_loadu_ps(lhs.pW + i) };
+				const __m128 bx{ _mm_loadu_ps(rhs.pX + i) }, by{ _mm_loadu_ps(rhs.pY + i) }, bz{ _mm_loadu_ps(rhs.pZ + i) }, bw{ _mm_loadu_ps(rhs.pW + i) };
+
+				_mm_storeu_ps(out.pX + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bx), _mm_mul_ps(ax, bw)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by)));
+				_mm_storeu_ps(out.pY + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, by), _mm_mul_ps(ay, bw)), _mm_mul_ps(az, bx)), _mm_mul_ps(ax, bz)));
+				_mm_storeu_ps(out.pZ + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bz), _mm_mul_ps(az, bw)), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)));
+				_mm_storeu_ps(out.pW + i, _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)));
+			}
+
+			scalar::MultiplyQuaternions(Offset(lhs, i), Offset(rhs, i), Offset(out, i), count - i);
+		}
+
+		static void QuaternionsToMatrices(QuatSoA<const float> quaternions, glm::mat4x4* pOut, size_t count)
+		{
+			const __m128 one{ _mm_set1_ps(1.0f) };
+			const __m128 two{ _mm_set1_ps(2.0f) };
+			const __m128 lastColumn{ _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f) };
+
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 x{ _mm_loadu_ps(quaternions.pX + i) };
+				const __m128 y{ _mm_loadu_ps(quaternions.pY + i) };
+				const __m128 z{ _mm_loadu_ps(quaternions.pZ + i) };
+				const __m128 w{ _mm_loadu_ps(quaternions.pW + i) };
+
+				const __m128 xx{ _mm_mul_ps(x, x) }, yy{ _mm_mul_ps(y, y) }, zz{ _mm_mul_ps(z, z) };
+				const __m128 xy{ _mm_mul_ps(x, y) }, xz{ _mm_mul_ps(x, z) }, yz{ _mm_mul_ps(y, z) };
+				const __m128 wx{ _mm_mul_ps(w, x) }, wy{ _mm_mul_ps(w, y) }, wz{ _mm_mul_ps(w, z) };
+
+				// Every register holds one element of a column for 4 matrices, the transpose turns them into 4 columns
+				__m128 columns[3][4]
+				{
+					{ _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), _mm_mul_ps(two, _mm_add_ps(xy, wz)), _mm_mul_ps(two, _mm_sub_ps(xz, wy)), _mm_setzero_ps() },
+					{ _mm_mul_ps(two, _mm_sub_ps(xy, wz)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), _mm_mul_ps(two, _mm_add_ps(yz, wx)), _mm_setzero_ps() },
+					{ _mm_mul_ps(two, _mm_add_ps(xz, wy)), _mm_mul_ps(two, _mm_sub_ps(yz, wx)), _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), _mm_setzero_ps() }
+				};
+
+				for (int columnIdx{}; columnIdx < 3; ++columnIdx)
+				{
+					__m128* pColumn{ columns[columnIdx] };
+					_MM_TRANSPOSE4_PS(pColumn[0], pColumn[1], pColumn[2], pColumn[3]);
+
+					for (int matrixIdx{}; matrixIdx < 4; ++matrixIdx) _mm_storeu_ps(&pOut[i + matrixIdx][columnIdx][0], pColumn[matrixIdx]);
+				}
+				for (int matrixIdx{}; matrixIdx < 4; ++matrixIdx) _mm_storeu_ps(&pOut[i + matrixIdx][3][0], lastColumn);
+			}
+
+			scalar::QuaternionsToMatrices(Offset(quaternions, i), pOut + i, count - i);
+		}
+
+		static void TransformAABBs(const glm::mat4x4& matrix, Vec3SoA<const float> centers, Vec3SoA<const float> extents, Vec3SoA<float> outCenters, Vec3SoA<float> outExtents, size_t count)
+		{
+			const __m128 a00{ _mm_set1_ps(std::abs(matrix[0][0])) }, a01{ _mm_set1_ps(std::abs(matrix[0][1])) }, a02{ _mm_set1_ps(std::abs(matrix[0][2])) };
+			const __m128 a10{ _mm_set1_ps(std::abs(matrix[1][0])) }, a11{ _mm_set1_ps(std::abs(matrix[1][1])) }, a12{ _mm_set1_ps(std::abs(matrix[1][2])) };
+			const __m128 a20{ _mm_set1_ps(std::abs(matrix[2][0])) }, a21{ _mm_set1_ps(std::abs(matrix[2][1])) }, a22{ _mm_set1_ps(std::abs(matrix[2][2])) };
+
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 x{ _mm_loadu_ps(extents.pX + i) };
+				const __m128 y{ _mm_loadu_ps(extents.pY + i) };
+				const __m128 z{ _mm_loadu_ps(extents.pZ + i) };
+
+				_mm_storeu_ps(outExtents.pX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a00, x), _mm_mul_ps(a10, y)), _mm_mul_ps(a20, z)));
+				_mm_storeu_ps(outExtents.pY + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a01, x), _mm_mul_ps(a11, y)), _mm_mul_ps(a21, z)));
+				_mm_storeu_ps(outExtents.pZ + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(a02, x), _mm_mul_ps(a12, y)), _mm_mul_ps(a22, z)));
+			}
+
+			scalar::TransformAABBs(matrix, Offset(centers, i), Offset(extents, i), Offset(outCenters, i), Offset(outExtents, i), count - i);
+			TransformPoints(matrix, centers, outCenters, i);
+		}
+
+		static void NormalizeVectors(Vec3SoA<float> vectors, size_t count)
+		{
+			const __m128 one{ _mm_set1_ps(1.0f) };
+
+			size_t i{};
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128 x{ _mm_loadu_ps(vectors.pX + i) };
+				const __m128 y{ _mm_loadu_ps(vectors.pY + i) };
+				const __m128 z{ _mm_loadu_ps(vectors.pZ + i) };
+
+				// A full precision square root instead of _mm_rsqrt_ps, so the result matches glm::normalize
+				const __m128 lengthSquared{ _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)) };
+				const __m128 inverseLength{ _mm_div_ps(one, _mm_sqrt_ps(lengthSquared)) };
+
+				_mm_storeu_ps(vectors.pX + i, _mm_mul_ps(x, inverseLength));
+				_mm_storeu_ps(vectors.pY + i, _mm_mul_ps(y, inverseLength));
+				_mm_storeu_ps(vectors.pZ + i, _mm_mul_ps(z, inverseLength));
+			}
+
+			scalar::NormalizeVectors(Offset(vectors, i), count - i);
+		}
+	}
+#endif
+
+	const KernelTable& GetScalarKernels()
+	{
+		static constexpr KernelTable kernels
+		{
+			scalar::TransformPoints,
+			scalar::MultiplyQuaternions,
+			scalar::QuaternionsToMatrices,
+			scalar::TransformAABBs,
+			scalar::NormalizeVectors
+		};
+		return kernels;
+	}
+
+	const KernelTable* GetSSE2Kernels()
+	{
+#ifdef LEAP_BATCHMATH_SSE2
+		static constexpr KernelTable kernels
+		{
+			sse2::TransformPoints,
+			sse2::MultiplyQuaternions,
+			sse2::QuaternionsToMatrices,
+			sse2::TransformAABBs,
+			sse2::NormalizeVectors
+		};
+		return &kernels;
+#else
+		return nullptr;
+#endif
+	}
+}
+
+namespace
+{
+	using leap::batchmath::KernelTable;
+	using InstructionSet = leap::BatchMath::InstructionSet;
+
+	bool IsAVX2Supported()
+	{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		int cpuInfo[4]{};
+		__cpuid(cpuInfo, 0);
+		if (cpuInfo[0] < 7) return false;
+
+		// The OS needs to save the AVX registers too
+		__cpuid(cpuInfo, 1);
+		constexpr int osxsaveBit{ 1 << 27 };
+		constexpr int avxBit{ 1 << 28 };
+		if ((cpuInfo[2] & osxsaveBit) == 0 || (cpuInfo[2] & avxBit) == 0) return false;
+		if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+		__cpuidex(cpuInfo, 7, 0);
+		constexpr int avx2Bit{ 1 << 5 };
+		return (cpuInfo[1] & avx2Bit) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2");
+#else
+		return false;
+#endif
+	}
+
+	const KernelTable& GetKernels(InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case InstructionSet::AVX2:
+			if (const KernelTable* pKernels{ leap::batchmath::GetAVX2Kernels() }; pKernels) return *pKernels;
+			[[fallthrough]];
+		case InstructionSet::SSE2:
+			if (const KernelTable* pKernels{ leap::batchmath::GetSSE2Kernels() }; pKernels) return *pKernels;
+			[[fallthrough]];
+		default:
+			return leap::batchmath::GetScalarKernels();
+		}
+	}
+
+	// Selected on first use, so the batch functions can be used during static initialization
+	std::atomic<InstructionSet> g_InstructionSet{ InstructionSet::Scalar };
+	std::atomic<const KernelTable*> g_pKernels{};
+
+	const KernelTable& GetActiveKernels()
+	{
+		const KernelTable* pKernels{ g_pKernels.load(std::memory_order_relaxed) };
+		if (pKernels) return *pKernels;
+
+		leap::BatchMath::SetInstructionSet(leap::BatchMath::GetSupportedInstructionSet());
+		return *g_pKernels.load(std::memory_order_relaxed);
+	}
+}
+
+leap::BatchMath::InstructionSet leap::BatchMath::GetInstructionSet()
+{
+	GetActiveKernels();
+	return g_InstructionSet.load(std::memory_order_relaxed);
+}
+
+leap::BatchMath::InstructionSet leap::BatchMath::GetSupportedInstructionSet()
+{
+	if (batchmath::GetAVX2Kernels() && IsAVX2Supported()) return InstructionSet::AVX2;
+	if (batchmath::GetSSE2Kernels()) return InstructionSet::SSE2;
+	return InstructionSet::Scalar;
+}
+
+void leap::BatchMath::SetInstructionSet(InstructionSet instructionSet)
+{
+	const InstructionSet supportedInstructionSet{ GetSupportedInstructionSet() };
+	if (instructionSet > supportedInstructionSet) instructionSet = supportedInstructionSet;
+
+	g_InstructionSet.store(instructionSet, std::memory_order_relaxed);
+	g_pKernels.store(&GetKernels(instructionSet), std::memory_order_relaxed);
+}
+
+void leap::BatchMath::TransformPoints(const glm::mat4x4& matrix, Vec3SoA<const float> points, Vec3SoA<float> out, size_t count)
+{
+	GetActiveKernels().pTransformPoints(matrix, points, out, count);
+}
+
+void leap::BatchMath::MultiplyQuaternions(QuatSoA<const float> lhs, QuatSoA<const float> rhs, QuatSoA<float> out, size_t count)
+{
+	GetActiveKernels().pMultiplyQuaternions(lhs, rhs, out, count);
+}
+
+void leap::BatchMath::QuaternionsToMatrices(QuatSoA<const float> quaternions, glm::mat4x4* pOut, size_t count)
+{
+	GetActiveKernels().pQuaternionsToMatrices(quaternions, pOut, count);
+}
+
+void leap::BatchMath::TransformAABBs(const glm::mat4x4& matrix, Vec3SoA<const float> centers, Vec3SoA<const float> extents, Vec3SoA<float> outCenters, Vec3SoA<float> outExtents, size_t count)
+{
+	GetActiveKernels().pTransformAABBs(matrix, centers, extents, outCenters, outExtents, count);
+}
+
+void leap::BatchMath::NormalizeVectors(Vec3SoA<float> vectors, size_t count)
+{
+	GetActiveKernels().pNormalizeVectors(vectors, count);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <mat4x4.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace leap
+{
+	/// <summary>
+	/// A list of 3D vectors stored as a structure of arrays, every pointer points to count floats
+	/// </summary>
+	template <class T>
+	struct Vec3SoA final
+	{
+		T* pX{};
+		T* pY{};
+		T* pZ{};
+
+		template <class U = T> requires (!std::is_const_v<U>)
+		operator Vec3SoA<const U>() const { return { pX, pY, pZ }; }
+	};
+
+	/// <summary>
+	/// A list of quaternions stored as a structure of arrays, every pointer points to count floats
+	/// </summary>
+	template <class T>
+	struct QuatSoA final
+	{
+		T* pX{};
+		T* pY{};
+		T* pZ{};
+		T* pW{};
+
+		template <class U = T> requires (!std::is_const_v<U>)
+		operator QuatSoA<const U>() const { return { pX, pY, pZ, pW }; }
+	};
+
+	class BatchMath final
+	{
+	public:
+		// BatchMath is not constructable, it only groups the batch functions
+		// Every function handles count elements at once and gives the same result as the equivalent glm loop,
+		//		the instruction set that is used is selected at runtime
+		BatchMath() = delete;
+
+		enum class InstructionSet
+		{
+			Scalar,
+			SSE2,
+			AVX2
+		};
+
+		// Returns the instruction set that is used by the batch functions
+		static InstructionSet GetInstructionSet();
+
+		// Returns the best instruction set that is supported by this cpu and this build
+		static InstructionSet GetSupportedInstructionSet();
+
+		// Forces an instruction set (e.g. to compare the paths), an unsupported instruction set falls back to the best supported one
+		static void SetInstructionSet(InstructionSet instructionSet);
+
+		// out = matrix * vec4(point, 1), without perspective division
+		static void TransformPoints(const glm::mat4x4& matrix, Vec3SoA<const float> points, Vec3SoA<float> out, size_t count);
+
+		// out = lhs * rhs
+		static void MultiplyQuaternions(QuatSoA<const float> lhs, QuatSoA<const float> rhs, QuatSoA<float> out, size_t count);
+
+		// out = glm::mat4_cast(quaternion), the quaternions need to be normalized
+		static void QuaternionsToMatrices(QuatSoA<const float> quaternions, glm::mat4x4* pOut, size_t count);
+
+		// Transforms axis aligned bounding boxes (center and half extents) by the matrix and returns the axis aligned boxes that contain them
+		static void TransformAABBs(const glm::mat4x4& matrix, Vec3SoA<const float> centers, Vec3SoA<const float> extents, Vec3SoA<float> outCenters, Vec3SoA<float> outExtents, size_t count);
+
+		// Normalizes the vectors in place, a vector with length 0 results in NaN like glm::normalize
+		static void NormalizeVectors(Vec3SoA<float> vectors, size_t count);
+	};
+}
\ No newline at end of file
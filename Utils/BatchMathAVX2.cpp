@@ -0,0 +1,169 @@
+#include "BatchMathKernels.h"
+
+// This file is compiled with AVX2 enabled, its kernels are only called when the cpu supports AVX2
+#ifdef __AVX2__
+#include <immintrin.h>
+
+#include <cmath>
+
+namespace leap::batchmath
+{
+	namespace avx2
+	{
+		static void TransformPoints(const glm::mat4x4& matrix, Vec3SoA<const float> points, Vec3SoA<float> out, size_t count)
+		{
+			const __m256 m00{ _mm256_set1_ps(matrix[0][0]) }, m01{ _mm256_set1_ps(matrix[0][1]) }, m02{ _mm256_set1_ps(matrix[0][2]) };
+			const __m256 m10{ _mm256_set1_ps(matrix[1][0]) }, m11{ _mm256_set1_ps(matrix[1][1]) }, m12{ _mm256_set1_ps(matrix[1][2]) };
+			const __m256 m20{ _mm256_set1_ps(matrix[2][0]) }, m21{ _mm256_set1_ps(matrix[2][1]) }, m22{ _mm256_set1_ps(matrix[2][2]) };
+			const __m256 m30{ _mm256_set1_ps(matrix[3][0]) }, m31{ _mm256_set1_ps(matrix[3][1]) }, m32{ _mm256_set1_ps(matrix[3][2]) };
+
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 x{ _mm256_loadu_ps(points.pX + i) };
+				const __m256 y{ _mm256_loadu_ps(points.pY + i) };
+				const __m256 z{ _mm256_loadu_ps(points.pZ + i) };
+
+				_mm256_storeu_ps(out.pX + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m10, y)), _mm256_add_ps(_mm256_mul_ps(m20, z), m30)));
+				_mm256_storeu_ps(out.pY + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m01, x), _mm256_mul_ps(m11, y)), _mm256_add_ps(_mm256_mul_ps(m21, z), m31)));
+				_mm256_storeu_ps(out.pZ + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m02, x), _mm256_mul_ps(m12, y)), _mm256_add_ps(_mm256_mul_ps(m22, z), m32)));
+			}
+
+			GetScalarKernels().pTransformPoints(matrix, Offset(points, i), Offset(out, i), count - i);
+		}
+
+		static void MultiplyQuaternions(QuatSoA<const float> lhs, QuatSoA<const float> rhs, QuatSoA<float> out, size_t count)
+		{
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 ax{ _mm256_loadu_ps(lhs.pX + i) }, ay{ _mm256_loadu_ps(lhs.pY + i) }, az{ _mm256_loadu_ps(lhs.pZ + i) }, aw{ _mm256_loadu_ps(lhs.pW + i) };
+				const __m256 bx{ _mm256_loadu_ps(rhs.pX + i) }, by{ _mm256_loadu_ps(rhs.pY + i) }, bz{ _mm256_loadu_ps(rhs.pZ + i) }, bw{ _mm256_loadu_ps(rhs.pW + i) };
+
+				_mm256_storeu_ps(out.pX + i, _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aw, bx), _mm256_mul_ps(ax, bw)), _mm256_mul_ps(ay, bz)), _mm256_mul_ps(az, by)));
+				_mm256_storeu_ps(out.pY + i, _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aw, by), _mm256_mul_ps(ay, bw)), _mm256_mul_ps(az, bx)), _mm256_mul_ps(ax, bz)));
+				_mm256_storeu_ps(out.pZ + i, _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aw, bz), _mm256_mul_ps(az, bw)), _mm256_mul_ps(ax, by)), _mm256_mul_ps(ay, bx)));
+				_mm256_storeu_ps(out.pW + i, _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(aw, bw), _mm256_mul_ps(ax, bx)), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz)));
+			}
+
+			GetScalarKernels().pMultiplyQuaternions(Offset(lhs, i), Offset(rhs, i), Offset(out, i), count - i);
+		}
+
+		static void QuaternionsToMatrices(QuatSoA<const float> quaternions, glm::mat4x4* pOut, size_t count)
+		{
+			const __m256 one{ _mm256_set1_ps(1.0f) };
+			const __m256 two{ _mm256_set1_ps(2.0f) };
+			const __m128 lastColumn{ _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f) };
+
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 x{ _mm256_loadu_ps(quaternions.pX + i) };
+				const __m256 y{ _mm256_loadu_ps(quaternions.pY + i) };
+				const __m256 z{ _mm256_loadu_ps(quaternions.pZ + i) };
+				const __m256 w{ _mm256_loadu_ps(quaternions.pW + i) };
+
+				const __m256 xx{ _mm256_mul_ps(x, x) }, yy{ _mm256_mul_ps(y, y) }, zz{ _mm256_mul_ps(z, z) };
+				const __m256 xy{ _mm256_mul_ps(x, y) }, xz{ _mm256_mul_ps(x, z) }, yz{ _mm256_mul_ps(y, z) };
+				const __m256 wx{ _mm256_mul_ps(w, x) }, wy{ _mm256_mul_ps(w, y) }, wz{ _mm256_mul_ps(w, z) };
+
+				// Every register holds one element of a column for 8 matrices
+				const __m256 columns[3][3]
+				{
+					{ _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), _mm256_mul_ps(two, _mm256_add_ps(xy, wz)), _mm256_mul_ps(two, _mm256_sub_ps(xz, wy)) },
+					{ _mm256_mul_ps(two, _mm256_sub_ps(xy, wz)), _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), _mm256_mul_ps(two, _mm256_add_ps(yz, wx)) },
+					{ _mm256_mul_ps(two, _mm256_add_ps(xz, wy)), _mm256_mul_ps(two, _mm256_sub_ps(yz, wx)), _mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))) }
+				};
+
+				// Transpose every half of 4 matrices into their columns
+				for (int half{}; half < 2; ++half)
+				{
+					glm::mat4x4* pMatrices{ pOut + i + half * 4 };
+
+					for (int columnIdx{}; columnIdx < 3; ++columnIdx)
+					{
+						const __m256* pColumn{ columns[columnIdx] };
+
+						__m128 column0{ half == 0 ? _mm256_castps256_ps128(pColumn[0]) : _mm256_extractf128_ps(pColumn[0], 1) };
+						__m128 column1{ half == 0 ? _mm256_castps256_ps128(pColumn[1]) : _mm256_extractf128_ps(pColumn[1], 1) };
+						__m128 column2{ half == 0 ? _mm256_castps256_ps128(pColumn[2]) : _mm256_extractf128_ps(pColumn[2], 1) };
+						__m128 column3{ _mm_setzero_ps() };
+						_MM_TRANSPOSE4_PS(column0, column1, column2, column3);
+
+						_mm_storeu_ps(&pMatrices[0][columnIdx][0], column0);
+						_mm_storeu_ps(&pMatrices[1][columnIdx][0], column1);
+						_mm_storeu_ps(&pMatrices[2][columnIdx][0], column2);
+						_mm_storeu_ps(&pMatrices[3][columnIdx][0], column3);
+					}
+
+					for (int matrixIdx{}; matrixIdx < 4; ++matrixIdx) _mm_storeu_ps(&pMatrices[matrixIdx][3][0], lastColumn);
+				}
+			}
+
+			GetScalarKernels().pQuaternionsToMatrices(Offset(quaternions, i), pOut + i, count - i);
+		}
+
+		static void TransformAABBs(const glm::mat4x4& matrix, Vec3SoA<const float> centers, Vec3SoA<const float> extents, Vec3SoA<float> outCenters, Vec3SoA<float> outExtents, size_t count)
+		{
+			const __m256 a00{ _mm256_set1_ps(std::abs(matrix[0][0])) }, a01{ _mm256_set1_ps(std::abs(matrix[0][1])) }, a02{ _mm256_set1_ps(std::abs(matrix[0][2])) };
+			const __m256 a10{ _mm256_set1_ps(std::abs(matrix[1][0])) }, a11{ _mm256_set1_ps(std::abs(matrix[1][1])) }, a12{ _mm256_set1_ps(std::abs(matrix[1][2])) };
+			const __m256 a20{ _mm256_set1_ps(std::abs(matrix[2][0])) }, a21{ _mm256_set1_ps(std::abs(matrix[2][1])) }, a22{ _mm256_set1_ps(std::abs(matrix[2][2])) };
+
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 x{ _mm256_loadu_ps(extents.pX + i) };
+				const __m256 y{ _mm256_loadu_ps(extents.pY + i) };
+				const __m256 z{ _mm256_loadu_ps(extents.pZ + i) };
+
+				_mm256_storeu_ps(outExtents.pX + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a00, x), _mm256_mul_ps(a10, y)), _mm256_mul_ps(a20, z)));
+				_mm256_storeu_ps(outExtents.pY + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a01, x), _mm256_mul_ps(a11, y)), _mm256_mul_ps(a21, z)));
+				_mm256_storeu_ps(outExtents.pZ + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a02, x), _mm256_mul_ps(a12, y)), _mm256_mul_ps(a22, z)));
+			}
+
+			GetScalarKernels().pTransformAABBs(matrix, Offset(centers, i), Offset(extents, i), Offset(outCenters, i), Offset(outExtents, i), count - i);
+			TransformPoints(matrix, centers, outCenters, i);
+		}
+
+		static void NormalizeVectors(Vec3SoA<float> vectors, size_t count)
+		{
+			const __m256 one{ _mm256_set1_ps(1.0f) };
+
+			size_t i{};
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256 x{ _mm256_loadu_ps(vectors.pX + i) };
+				const __m256 y{ _mm256_loadu_ps(vectors.pY + i) };
+				const __m256 z{ _mm256_loadu_ps(vectors.pZ + i) };
+
+				const __m256 lengthSquared{ _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)) };
+				const __m256 inverseLength{ _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared)) };
+
+				_mm256_storeu_ps(vectors.pX + i, _mm256_mul_ps(x, inverseLength));
+				_mm256_storeu_ps(vectors.pY + i, _mm256_mul_ps(y, inverseLength));
+				_mm256_storeu_ps(vectors.pZ + i, _mm256_mul_ps(z, inverseLength));
+			}
+
+			GetScalarKernels().pNormalizeVectors(Offset(vectors, i), count - i);
+		}
+	}
+
+	const KernelTable* GetAVX2Kernels()
+	{
+		static constexpr KernelTable kernels
+		{
+			avx2::TransformPoints,
+			avx2::MultiplyQuaternions,
+			avx2::QuaternionsToMatrices,
+			avx2::TransformAABBs,
+			avx2::NormalizeVectors
+		};
+		return &kernels;
+	}
+}
+#else
+const leap::batchmath::KernelTable* leap::batchmath::GetAVX2Kernels()
+{
+	return nullptr;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "BatchMath.h"
+
+namespace leap::batchmath
+{
+	/// <summary>
+	/// The implementation of every batch function for one instruction set
+	/// </summary>
+	struct KernelTable final
+	{
+		void (*pTransformPoints)(const glm::mat4x4& matrix, Vec3SoA<const float> points, Vec3SoA<float> out, size_t count);
+		void (*pMultiplyQuaternions)(QuatSoA<const float> lhs, QuatSoA<const float> rhs, QuatSoA<float> out, size_t count);
+		void (*pQuaternionsToMatrices)(QuatSoA<const float> quaternions, glm::mat4x4* pOut, size_t count);
+		void (*pTransformAABBs)(const glm::mat4x4& matrix, Vec3SoA<const float> centers, Vec3SoA<const float> extents, Vec3SoA<float> outCenters, Vec3SoA<float> outExtents, size_t count);
+		void (*pNormalizeVectors)(Vec3SoA<float> vectors, size_t count);
+	};
+
+	// The scalar kernels also handle the elements that don't fill a full register
+	const KernelTable& GetScalarKernels();
+
+	// Return nullptr when the instruction set is not compiled in
+	const KernelTable* GetSSE2Kernels();
+	const KernelTable* GetAVX2Kernels();
+
+	template <class T>
+	Vec3SoA<T> Offset(Vec3SoA<T> values, size_t offset) { return { values.pX + offset, values.pY + offset, values.pZ + offset }; }
+	template <class T>
+	QuatSoA<T> Offset(QuatSoA<T> values, size_t offset) { return { values.pX + offset, values.pY + offset, values.pZ + offset, values.pW + offset }; }
+}
\ No newline at end of file
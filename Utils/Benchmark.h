@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace leap
+{
+	class Benchmark final
+	{
+	public:
+		// Benchmark is not constructable, it only groups the helpers that the benchmark executables share
+		Benchmark() = delete;
+
+		// Runs the function nrOfRuns times and prints and returns the fastest run in milliseconds
+		// Taking the fastest run keeps the first run (cold caches, page faults) and scheduling noise out of the result
+		template <class Function>
+		static double Measure(const char* pName, int nrOfRuns, const Function& function);
+
+		// Prints how many times faster the measurement is than the baseline
+		static void PrintSpeedup(const char* pName, double baselineMs, double measurementMs)
+		{
+			std::printf("    %-48s %8.2fx\n", pName, measurementMs > 0.0 ? baselineMs / measurementMs : 0.0);
+		}
+
+		static void PrintHeader(const char* pName)
+		{
+			std::printf("\n%s\n", pName);
+		}
+	};
+
+	template <class Function>
+	inline double Benchmark::Measure(const char* pName, int nrOfRuns, const Function& function)
+	{
+		double fastestMs{};
+
+		for (int runIdx{}; runIdx < nrOfRuns; ++runIdx)
+		{
+			const auto start{ std::chrono::steady_clock::now() };
+			function();
+			const auto end{ std::chrono::steady_clock::now() };
+
+			const double durationMs{ std::chrono::duration<double, std::milli>(end - start).count() };
+			if (runIdx == 0 || durationMs < fastestMs) fastestMs = durationMs;
+		}
+
+		std::printf("    %-48s %10.3f ms\n", pName, fastestMs);
+		return fastestMs;
+	}
+}
\ No newline at end of file
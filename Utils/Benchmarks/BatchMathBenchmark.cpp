@@ -0,0 +1,214 @@
+#include <BatchMath.h>
+#include <Benchmark.h>
+
+#pragma warning(disable: 4201)
+#include <gtc/matrix_transform.hpp>
+#include <gtc/quaternion.hpp>
+#pragma warning(default: 4201)
+#include <mat4x4.hpp>
+#include <vec3.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Times every BatchMath kernel with every supported instruction set against the equivalent glm loop over an array of glm types
+// Every kernel also prints the largest difference with the glm result, so a fast but wrong kernel doesn't go unnoticed
+
+namespace
+{
+	constexpr size_t g_NrOfElements{ 100'000 };
+	constexpr int g_NrOfRuns{ 20 };
+
+	// The same values stored as glm types and as structures of arrays
+	struct Vec3Data final
+	{
+		std::vector<glm::vec3> aos{};
+		std::vector<float> x{}, y{}, z{};
+
+		explicit Vec3Data(size_t count) : aos(count), x(count), y(count), z(count) {}
+
+		leap::Vec3SoA<float> GetSoA() { return { x.data(), y.data(), z.data() }; }
+
+		void Fill(std::mt19937& random, float min, float max)
+		{
+			std::uniform_real_distribution<float> distribution{ min, max };
+			for (size_t i{}; i < aos.size(); ++i)
+			{
+				aos[i] = glm::vec3{ distribution(random), distribution(random), distribution(random) };
+				x[i] = aos[i].x;
+				y[i] = aos[i].y;
+				z[i] = aos[i].z;
+			}
+		}
+
+		float GetMaxDifference(const std::vector<glm::vec3>& expected) const
+		{
+			float maxDifference{};
+			for (size_t i{}; i < expected.size(); ++i)
+			{
+				maxDifference = std::max({ maxDifference, std::abs(x[i] - expected[i].x), std::abs(y[i] - expected[i].y), std::abs(z[i] - expected[i].z) });
+			}
+			return maxDifference;
+		}
+	};
+
+	struct QuatData final
+	{
+		std::vector<glm::quat> aos{};
+		std::vector<float> x{}, y{}, z{}, w{};
+
+		explicit QuatData(size_t count) : aos(count), x(count), y(count), z(count), w(count) {}
+
+		leap::QuatSoA<float> GetSoA() { return { x.data(), y.data(), z.data(), w.data() }; }
+
+		void Fill(std::mt19937& random)
+		{
+			std::uniform_real_distribution<float> distribution{ -1.0f, 1.0f };
+			for (size_t i{}; i < aos.size(); ++i)
+			{
+				aos[i] = glm::normalize(glm::quat{ distribution(random), distribution(random), distribution(random), distribution(random) });
+				x[i] = aos[i].x;
+				y[i] = aos[i].y;
+				z[i] = aos[i].z;
+				w[i] = aos[i].w;
+			}
+		}
+
+		float GetMaxDifference(const std::vector<glm::quat>& expected) const
+		{
+			float maxDifference{};
+			for (size_t i{}; i < expected.size(); ++i)
+			{
+				maxDifference = std::max({ maxDifference, std::abs(x[i] - expected[i].x), std::abs(y[i] - expected[i].y), std::abs(z[i] - expected[i].z), std::abs(w[i] - expected[i].w) });
+			}
+			return maxDifference;
+		}
+	};
+
+	float GetMaxDifference(const std::vector<glm::mat4x4>& matrices, const std::vector<glm::mat4x4>& expected)
+	{
+		float maxDifference{};
+		for (size_t i{}; i < expected.size(); ++i)
+		{
+			for (int column{}; column < 4; ++column)
+			{
+				for (int row{}; row < 4; ++row) maxDifference = std::max(maxDifference, std::abs(matrices[i][column][row] - expected[i][column][row]));
+			}
+		}
+		return maxDifference;
+	}
+
+	const char* GetName(leap::BatchMath::InstructionSet instructionSet)
+	{
+		switch (instructionSet)
+		{
+		case leap::BatchMath::InstructionSet::SSE2:
+			return "BatchMath SSE2";
+		case leap::BatchMath::InstructionSet::AVX2:
+			return "BatchMath AVX2";
+		default:
+			return "BatchMath scalar";
+		}
+	}
+
+	// Measures the glm loop, then the kernel with every supported instruction set
+	template <class GlmFunction, class BatchFunction, class CheckFunction>
+	void MeasureKernel(const char* pName, const GlmFunction& glmFunction, const BatchFunction& batchFunction, const CheckFunction& getMaxDifference)
+	{
+		leap::Benchmark::PrintHeader(pName);
+
+		const double glmMs{ leap::Benchmark::Measure("glm loop", g_NrOfRuns, glmFunction) };
+
+		const leap::BatchMath::InstructionSet supportedSet{ leap::BatchMath::GetSupportedInstructionSet() };
+		for (const leap::BatchMath::InstructionSet instructionSet : { leap::BatchMath::InstructionSet::Scalar, leap::BatchMath::InstructionSet::SSE2, leap::BatchMath::InstructionSet::AVX2 })
+		{
+			if (instructionSet > supportedSet) break;
+			leap::BatchMath::SetInstructionSet(instructionSet);
+
+			const double batchMs{ leap::Benchmark::Measure(GetName(instructionSet), g_NrOfRuns, batchFunction) };
+			leap::Benchmark::PrintSpeedup("    speedup over glm", glmMs, batchMs);
+			std::printf("        %-44s %10.2e\n", "max difference with glm", static_cast<double>(getMaxDifference()));
+		}
+
+		leap::BatchMath::SetInstructionSet(supportedSet);
+	}
+}
+
+int main()
+{
+	std::mt19937 random{ 1337 };
+
+	Vec3Data points{ g_NrOfElements };
+	Vec3Data extents{ g_NrOfElements };
+	Vec3Data vectors{ g_NrOfElements };
+	Vec3Data outPoints{ g_NrOfElements };
+	Vec3Data outExtents{ g_NrOfElements };
+	points.Fill(random, -100.0f, 100.0f);
+	extents.Fill(random, 0.1f, 10.0f);
+	vectors.Fill(random, -10.0f, 10.0f);
+
+	QuatData lhs{ g_NrOfElements };
+	QuatData rhs{ g_NrOfElements };
+	QuatData outQuaternions{ g_NrOfElements };
+	lhs.Fill(random);
+	rhs.Fill(random);
+
+	std::vector<glm::mat4x4> matrices(g_NrOfElements);
+	std::vector<glm::mat4x4> expectedMatrices(g_NrOfElements);
+	std::vector<glm::vec3> expectedPoints(g_NrOfElements);
+	std::vector<glm::vec3> expectedExtents(g_NrOfElements);
+	std::vector<glm::quat> expectedQuaternions(g_NrOfElements);
+
+	const glm::mat4x4 matrix{ glm::translate(glm::mat4x4{ 1.0f }, glm::vec3{ 1.0f, -2.0f, 3.0f }) * glm::mat4_cast(lhs.aos.front()) * glm::scale(glm::mat4x4{ 1.0f }, glm::vec3{ 2.0f, 0.5f, 1.5f }) };
+
+	std::printf("%zu elements, fastest of %d runs\n", g_NrOfElements, g_NrOfRuns);
+	std::printf("Supported instruction set: %s\n", GetName(leap::BatchMath::GetSupportedInstructionSet()));
+
+	MeasureKernel("TransformPoints",
+		[&]() { for (size_t i{}; i < g_NrOfElements; ++i) expectedPoints[i] = glm::vec3{ matrix * glm::vec4{ points.aos[i], 1.0f } }; },
+		[&]() { leap::BatchMath::TransformPoints(matrix, points.GetSoA(), outPoints.GetSoA(), g_NrOfElements); },
+		[&]() { return outPoints.GetMaxDifference(expectedPoints); });
+
+	MeasureKernel("MultiplyQuaternions",
+		[&]() { for (size_t i{}; i < g_NrOfElements; ++i) expectedQuaternions[i] = lhs.aos[i] * rhs.aos[i]; },
+		[&]() { leap::BatchMath::MultiplyQuaternions(lhs.GetSoA(), rhs.GetSoA(), outQuaternions.GetSoA(), g_NrOfElements); },
+		[&]() { return outQuaternions.GetMaxDifference(expectedQuaternions); });
+
+	MeasureKernel("QuaternionsToMatrices",
+		[&]() { for (size_t i{}; i < g_NrOfElements; ++i) expectedMatrices[i] = glm::mat4_cast(lhs.aos[i]); },
+		[&]() { leap::BatchMath::QuaternionsToMatrices(lhs.GetSoA(), matrices.data(), g_NrOfElements); },
+		[&]() { return GetMaxDifference(matrices, expectedMatrices); });
+
+	// The glm version of an aabb transform: the center is transformed, the extents are projected on the absolute axes of the matrix
+	const glm::mat3x3 absoluteAxes{ glm::abs(glm::vec3{ matrix[0] }), glm::abs(glm::vec3{ matrix[1] }), glm::abs(glm::vec3{ matrix[2] }) };
+	MeasureKernel("TransformAABBs",
+		[&]()
+		{
+			for (size_t i{}; i < g_NrOfElements; ++i)
+			{
+				expectedPoints[i] = glm::vec3{ matrix * glm::vec4{ points.aos[i], 1.0f } };
+				expectedExtents[i] = absoluteAxes * extents.aos[i];
+			}
+		},
+		[&]() { leap::BatchMath::TransformAABBs(matrix, points.GetSoA(), extents.GetSoA(), outPoints.GetSoA(), outExtents.GetSoA(), g_NrOfElements); },
+		[&]() { return std::max(outPoints.GetMaxDifference(expectedPoints), outExtents.GetMaxDifference(expectedExtents)); });
+
+	// Normalizing is done in place, the input is restored before every run so every run normalizes the same vectors
+	Vec3Data normalized{ g_NrOfElements };
+	MeasureKernel("NormalizeVectors",
+		[&]() { for (size_t i{}; i < g_NrOfElements; ++i) normalized.aos[i] = glm::normalize(vectors.aos[i]); },
+		[&]()
+		{
+			std::copy(vectors.x.begin(), vectors.x.end(), normalized.x.begin());
+			std::copy(vectors.y.begin(), vectors.y.end(), normalized.y.begin());
+			std::copy(vectors.z.begin(), vectors.z.end(), normalized.z.begin());
+			leap::BatchMath::NormalizeVectors(normalized.GetSoA(), g_NrOfElements);
+		},
+		[&]() { return normalized.GetMaxDifference(normalized.aos); });
+
+	return 0;
+}
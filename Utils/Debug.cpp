@@ -4,20 +4,20 @@
 
 void leap::Debug::Log(const char* message, const std::source_location& location)
 {
-	const auto time = GetTime();
-    OnEvent.Notify(LogInfo{ message, GetTime().c_str(), Type::Message, location });
+    const auto time{ GetTime() };
+    OnEvent.Notify(LogInfo{ message, time.data(), Type::Message, location });
 }
 
 void leap::Debug::LogWarning(const char* message, const std::source_location& location)
 {
-    const auto time = GetTime();
-    OnEvent.Notify(LogInfo{ message, GetTime().c_str(), Type::Warning, location });
+    const auto time{ GetTime() };
+    OnEvent.Notify(LogInfo{ message, time.data(), Type::Warning, location });
 }
 
 void leap::Debug::LogError(const char* message, const std::source_location& location)
 {
-    const auto time = GetTime();
-    OnEvent.Notify(LogInfo{ message, GetTime().c_str(), Type::Error, location });
+    const auto time{ GetTime() };
+    OnEvent.Notify(LogInfo{ message, time.data(), Type::Error, location });
 
     if (!m_IsThrowingOnError) return;
 
@@ -29,14 +29,14 @@ void leap::Debug::SetThrowingOnError(bool enabled)
     m_IsThrowingOnError = enabled;
 }
 
-std::string leap::Debug::GetTime()
+std::array<char, 11> leap::Debug::GetTime()
 {
     time_t currentTime;
     tm timeinfo{};
     time(&currentTime);
     localtime_s(&timeinfo, &currentTime);
-    char timeString[11]; // [hh:mm:ss] plus the null terminator
-    strftime(timeString, sizeof(timeString), "[%H:%M:%S]", &timeinfo);
+    std::array<char, 11> timeString{};
+    strftime(timeString.data(), timeString.size(), "[%H:%M:%S]", &timeinfo);
 
-    return std::string{timeString};
+    return timeString;
 }
\ No newline at end of file
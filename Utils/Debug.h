@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <array>
 #include <source_location>
 #include "Subject.h"
 
@@ -37,7 +38,8 @@ namespace leap
 		inline static TSubject<LogInfo> OnEvent{};
 
 	private:
-		static std::string GetTime();
+		// [hh:mm:ss] plus the null terminator, returned by value so logging doesn't allocate
+		static std::array<char, 11> GetTime();
 		static inline bool m_IsThrowingOnError{true};
 	};
 }
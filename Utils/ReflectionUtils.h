@@ -28,9 +28,14 @@ namespace leap::ReflectionUtils
 	{
 		constexpr std::string_view wrappedName{ Detail::WrappedTypename<T>() };
 
+		#if _MSC_VER
 		constexpr size_t endOfType{ wrappedName.find_last_of('>') };
 		// I would use std::max, but it doesn't work for some inexplicable reason
 		constexpr size_t beginOfType{ std::max(wrappedName.find_last_of(' '), wrappedName.find_last_of('<')) };
+		#else // GCC and Clang print the type as "[with T = Type; ...]" or "[T = Type]"
+		constexpr size_t beginOfType{ wrappedName.find("T = ") + 3 };
+		constexpr size_t endOfType{ wrappedName.find_first_of(";]", beginOfType) };
+		#endif
 
 		return wrappedName.substr(beginOfType + 1, endOfType - beginOfType - 1);
 	}
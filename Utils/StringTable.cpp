@@ -0,0 +1,63 @@
+#include "StringTable.h"
+
+#include <mutex>
+
+leap::StringID leap::StringTable::Intern(const char* string)
+{
+	if (string == nullptr) return m_InvalidID;
+
+	return Intern(std::string_view{ string });
+}
+
+leap::StringID leap::StringTable::Intern(std::string_view string)
+{
+	if (const StringID id{ Find(string) }; id != m_InvalidID) return id;
+
+	const std::unique_lock lock{ m_Mutex };
+
+	// Take the first free ID after the hash, the string can have been added after Find released its lock
+	StringID id{ Hash(string) };
+	for (;; ++id)
+	{
+		if (id == m_InvalidID) continue;
+
+		const auto it{ m_Strings.find(id) };
+		if (it == m_Strings.end()) break;
+		if (it->second == string) return id;
+	}
+
+	m_Strings.emplace(id, std::string{ string });
+	return id;
+}
+
+leap::StringID leap::StringTable::Find(const char* string) const
+{
+	if (string == nullptr) return m_InvalidID;
+
+	return Find(std::string_view{ string });
+}
+
+leap::StringID leap::StringTable::Find(std::string_view string) const
+{
+	const std::shared_lock lock{ m_Mutex };
+
+	// Strings with the same hash are stored at the next free IDs
+	for (StringID id{ Hash(string) };; ++id)
+	{
+		if (id == m_InvalidID) continue;
+
+		const auto it{ m_Strings.find(id) };
+		if (it == m_Strings.end()) return m_InvalidID;
+		if (it->second == string) return id;
+	}
+}
+
+const char* leap::StringTable::GetString(StringID id) const
+{
+	if (id == m_InvalidID) return nullptr;
+
+	const std::shared_lock lock{ m_Mutex };
+
+	const auto it{ m_Strings.find(id) };
+	return it != m_Strings.end() ? it->second.c_str() : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Singleton.h"
+#include "ReflectionUtils.h"
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace leap
+{
+	/// <summary>
+	/// The ID of an interned string, two strings are equal if their IDs are equal
+	/// </summary>
+	using StringID = uint32_t;
+
+	/// <summary>
+	/// StringTable interns strings for the whole engine, every unique string is stored once and gets a unique ID
+	/// The ID of a string is its ConstexprStringHash, unless that hash is already used by another string
+	/// The strings are never removed, so the pointers returned by GetString stay valid
+	/// </summary>
+	class StringTable final : public Singleton<StringTable>
+	{
+	public:
+		virtual ~StringTable() = default;
+		StringTable(const StringTable& other) = delete;
+		StringTable(StringTable&& other) = delete;
+		StringTable& operator=(const StringTable& other) = delete;
+		StringTable& operator=(StringTable&& other) = delete;
+
+		static constexpr StringID m_InvalidID{ 0 };
+
+		/// <summary>
+		/// Returns the ID of the string and adds the string if it is not interned yet, nullptr returns m_InvalidID
+		/// </summary>
+		StringID Intern(const char* string);
+		StringID Intern(std::string_view string);
+
+		/// <summary>
+		/// Returns the ID of the string or m_InvalidID if the string is not interned, this never adds the string
+		/// </summary>
+		StringID Find(const char* string) const;
+		StringID Find(std::string_view string) const;
+
+		/// <summary>
+		/// Returns the interned string of an ID, or nullptr for m_InvalidID
+		/// </summary>
+		const char* GetString(StringID id) const;
+
+		static constexpr StringID Hash(std::string_view string)
+		{
+			return ReflectionUtils::ConstexprStringHash(string.data(), static_cast<unsigned int>(string.size()));
+		}
+
+	private:
+		friend Singleton;
+		StringTable() = default;
+
+		mutable std::shared_mutex m_Mutex{};
+		std::unordered_map<StringID, std::string> m_Strings{};
+	};
+}
\ No newline at end of file